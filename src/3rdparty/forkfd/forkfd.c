@@ -710,8 +710,12 @@ err_close2:
         EINTR_LOOP(ret, close(sync_pipe[1]));
     }
 err_close:
-    EINTR_LOOP(ret, close(death_pipe[0]));
-    EINTR_LOOP(ret, close(death_pipe[1]));
+    {
+        int saved_errno = errno;
+        EINTR_LOOP(ret, close(death_pipe[0]));
+        EINTR_LOOP(ret, close(death_pipe[1]));
+        errno = saved_errno;
+    }
 err_free:
     /* free the info pointer */
     freeInfo(header, info);
@@ -852,14 +856,17 @@ int spawnfd(int flags, pid_t *ppid, const char *path, const posix_spawn_file_act
     if (create_pipe(death_pipe, flags) == -1)
         goto err_free; /* failed to create the pipes, pass errno */
 
-    /* start the process */
+    /* start the process; posix_spawn returns the error instead of setting errno */
     if (flags & FFD_SPAWN_SEARCH_PATH) {
         /* use posix_spawnp */
-        if (posix_spawnp(&pid, path, file_actions, attrp, argv, envp) != 0)
-            goto err_close;
+        ret = posix_spawnp(&pid, path, file_actions, attrp, argv, envp);
     } else {
-        if (posix_spawn(&pid, path, file_actions, attrp, argv, envp) != 0)
-            goto err_close;
+        ret = posix_spawn(&pid, path, file_actions, attrp, argv, envp);
+    }
+    if (ret != 0) {
+        errno = ret;
+        ret = -1;
+        goto err_close;
     }
 
     if (ppid)
@@ -878,8 +885,12 @@ int spawnfd(int flags, pid_t *ppid, const char *path, const posix_spawn_file_act
     return ret;
 
 err_close:
-    EINTR_LOOP(ret, close(death_pipe[0]));
-    EINTR_LOOP(ret, close(death_pipe[1]));
+    {
+        int saved_errno = errno;
+        EINTR_LOOP(ret, close(death_pipe[0]));
+        EINTR_LOOP(ret, close(death_pipe[1]));
+        errno = saved_errno;
+    }
 
 err_free:
     /* free the info pointer */
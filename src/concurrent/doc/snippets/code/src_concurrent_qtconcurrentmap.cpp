@@ -185,3 +185,25 @@ QList<QImage> collage = QtConcurrent::mappedReduced(images,
         }
    ).results();
 //! [17]
+
+//! [18]
+QList<int> values = ...;
+QFuture<qint64> sumOfSquares = QtConcurrent::chunkedMappedReduced(values,
+        [](QList<int>::const_iterator begin, QList<int>::const_iterator end) {
+            qint64 sum = 0;
+            for (auto it = begin; it != end; ++it)
+                sum += qint64(*it) * *it;
+            return sum;
+        },
+        [](qint64 &result, qint64 intermediate) {
+            result += intermediate;
+        });
+//! [18]
+
+//! [19]
+U function(Sequence::const_iterator begin, Sequence::const_iterator end);
+//! [19]
+
+//! [20]
+void function(U &result, const U &intermediate)
+//! [20]
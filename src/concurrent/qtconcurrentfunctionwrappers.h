@@ -65,6 +65,12 @@ struct MapResult
 template <class T, class MapFunctor>
 using MapResultType = typename MapResult<T, MapFunctor>::Type;
 
+// -- ChunkMapResultType
+
+template <class Iterator, class MapFunctor>
+using ChunkMapResultType =
+        std::decay_t<std::invoke_result_t<std::decay_t<MapFunctor> &, Iterator, Iterator>>;
+
 // -- ReduceResultType
 
 template <class T>
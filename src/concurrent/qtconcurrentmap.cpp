@@ -57,6 +57,24 @@
   \internal
 */
 
+/*!
+  \class QtConcurrent::TreeReduceKernel
+  \inmodule QtConcurrent
+  \internal
+*/
+
+/*!
+  \class QtConcurrent::ChunkedMappedReducedKernel
+  \inmodule QtConcurrent
+  \internal
+*/
+
+/*!
+  \class QtConcurrent::ChunkedSequenceHolder
+  \inmodule QtConcurrent
+  \internal
+*/
+
 /*!
   \fn [qtconcurrentmapkernel-1] ThreadEngineStarter<void> QtConcurrent::startMap(Iterator begin, Iterator end, Functor &&functor)
   \internal
@@ -92,6 +110,16 @@
   \internal
 */
 
+/*!
+  \fn [qtconcurrentmapkernel-8] auto QtConcurrent::startChunkedMappedReduced(QThreadPool *pool, Sequence &&sequence, MapFunctor &&mapFunctor, ReduceFunctor &&reduceFunctor, qsizetype chunkSize)
+  \internal
+*/
+
+/*!
+  \fn [qtconcurrentmapkernel-9] auto QtConcurrent::startChunkedMappedReduced(QThreadPool *pool, Iterator begin, Iterator end, MapFunctor &&mapFunctor, ReduceFunctor &&reduceFunctor, qsizetype chunkSize)
+  \internal
+*/
+
 /*!
     \enum QtConcurrent::ReduceOption
     This enum specifies the order of which results from the map or filter
@@ -196,6 +224,47 @@
     undefined, while QtConcurrent::OrderedReduce ensures that the reduction
     is done in the order of the original sequence.
 
+    \section1 Concurrent Chunked Map-Reduce
+
+    QtConcurrent::mappedReduced() calls the map function once for each item,
+    and passes every result to the reduce function, which only one thread
+    enters at a time. When the work done for each item is very cheap, like
+    adding up numbers, this overhead outweighs the work itself, and more
+    threads don't make the computation any faster.
+
+    QtConcurrent::chunkedMappedReduced() instead splits the sequence into
+    chunks of consecutive items, and calls the map function once for each
+    chunk. The map function must be of the form:
+
+    \snippet code/src_concurrent_qtconcurrentmap.cpp 19
+
+    The function gets the iterators to the first item of the chunk and past
+    its last item, and returns the result for the whole chunk. As the loop
+    over the items of a chunk doesn't call into Qt Concurrent, the compiler
+    can optimize it like any other loop, and vectorize it when the items are
+    stored contiguously, as in QList or std::vector.
+
+    The results of the chunks are then combined with a reduce function of
+    the form:
+
+    \snippet code/src_concurrent_qtconcurrentmap.cpp 20
+
+    The reduce function is always called with the results of two neighbouring
+    parts of the sequence, \e result being the one that comes first, and
+    must merge \e intermediate into \e result. Several threads can call it at
+    the same time, but never with the same values, so no locking is needed.
+    The reduce function must be associative, but the order of the items is
+    preserved, so it doesn't need to be commutative. U must be
+    default-constructible, and an empty sequence gives a default-constructed
+    result.
+
+    This example computes the sum of the squares of a list of numbers:
+
+    \snippet code/src_concurrent_qtconcurrentmap.cpp 18
+
+    By default, the sequence is split into a few chunks for each thread of the
+    thread pool. A chunk size can be passed as the last argument instead.
+
     \section1 Additional API Features
 
     \section2 Using Iterators instead of Sequence
@@ -495,6 +564,86 @@
     \sa {Concurrent Map and Map-Reduce}
 */
 
+/*!
+    \fn template <typename Sequence, typename MapFunctor, typename ReduceFunctor, typename ResultType> QFuture<ResultType> QtConcurrent::chunkedMappedReduced(QThreadPool *pool, Sequence &&sequence, MapFunctor &&mapFunction, ReduceFunctor &&reduceFunction, qsizetype chunkSize)
+    \since 6.6
+
+    Calls \a mapFunction once for each chunk of \a chunkSize consecutive
+    items in \a sequence, with the iterators to the first item of the chunk
+    and past its last item.
+    All calls to \a mapFunction are invoked from the threads taken from the
+    QThreadPool \a pool.
+    The results of neighbouring chunks are combined with \a reduceFunction,
+    in the order of the items, until a single result is left.
+
+    If \a chunkSize is 0, the items are split into a few chunks for each
+    thread of \a pool.
+
+    Note that several threads can call \a reduceFunction at the same time,
+    but never with the same values.
+
+    \sa blockingChunkedMappedReduced(), {Concurrent Map and Map-Reduce}
+*/
+
+/*!
+    \fn template <typename Sequence, typename MapFunctor, typename ReduceFunctor, typename ResultType> QFuture<ResultType> QtConcurrent::chunkedMappedReduced(Sequence &&sequence, MapFunctor &&mapFunction, ReduceFunctor &&reduceFunction, qsizetype chunkSize)
+    \since 6.6
+
+    Calls \a mapFunction once for each chunk of \a chunkSize consecutive
+    items in \a sequence, with the iterators to the first item of the chunk
+    and past its last item.
+    The results of neighbouring chunks are combined with \a reduceFunction,
+    in the order of the items, until a single result is left.
+
+    If \a chunkSize is 0, the items are split into a few chunks for each
+    thread of the global thread pool.
+
+    Note that several threads can call \a reduceFunction at the same time,
+    but never with the same values.
+
+    \sa blockingChunkedMappedReduced(), {Concurrent Map and Map-Reduce}
+*/
+
+/*!
+    \fn template <typename Iterator, typename MapFunctor, typename ReduceFunctor, typename ResultType> QFuture<ResultType> QtConcurrent::chunkedMappedReduced(QThreadPool *pool, Iterator begin, Iterator end, MapFunctor &&mapFunction, ReduceFunctor &&reduceFunction, qsizetype chunkSize)
+    \since 6.6
+
+    Calls \a mapFunction once for each chunk of \a chunkSize consecutive
+    items from \a begin to \a end, with the iterators to the first item of the chunk
+    and past its last item.
+    All calls to \a mapFunction are invoked from the threads taken from the
+    QThreadPool \a pool.
+    The results of neighbouring chunks are combined with \a reduceFunction,
+    in the order of the items, until a single result is left.
+
+    If \a chunkSize is 0, the items are split into a few chunks for each
+    thread of \a pool.
+
+    Note that several threads can call \a reduceFunction at the same time,
+    but never with the same values.
+
+    \sa blockingChunkedMappedReduced(), {Concurrent Map and Map-Reduce}
+*/
+
+/*!
+    \fn template <typename Iterator, typename MapFunctor, typename ReduceFunctor, typename ResultType> QFuture<ResultType> QtConcurrent::chunkedMappedReduced(Iterator begin, Iterator end, MapFunctor &&mapFunction, ReduceFunctor &&reduceFunction, qsizetype chunkSize)
+    \since 6.6
+
+    Calls \a mapFunction once for each chunk of \a chunkSize consecutive
+    items from \a begin to \a end, with the iterators to the first item of the chunk
+    and past its last item.
+    The results of neighbouring chunks are combined with \a reduceFunction,
+    in the order of the items, until a single result is left.
+
+    If \a chunkSize is 0, the items are split into a few chunks for each
+    thread of the global thread pool.
+
+    Note that several threads can call \a reduceFunction at the same time,
+    but never with the same values.
+
+    \sa blockingChunkedMappedReduced(), {Concurrent Map and Map-Reduce}
+*/
+
 /*!
     \fn template <typename Sequence, typename MapFunctor> void QtConcurrent::blockingMap(QThreadPool *pool, Sequence &&sequence, MapFunctor function)
 
@@ -744,3 +893,91 @@
 
   \sa blockingMappedReduced(), {Concurrent Map and Map-Reduce}
 */
+
+/*!
+    \fn template <typename Sequence, typename MapFunctor, typename ReduceFunctor, typename ResultType> ResultType QtConcurrent::blockingChunkedMappedReduced(QThreadPool *pool, Sequence &&sequence, MapFunctor &&mapFunction, ReduceFunctor &&reduceFunction, qsizetype chunkSize)
+    \since 6.6
+
+    Calls \a mapFunction once for each chunk of \a chunkSize consecutive
+    items in \a sequence, with the iterators to the first item of the chunk
+    and past its last item.
+    All calls to \a mapFunction are invoked from the threads taken from the
+    QThreadPool \a pool.
+    The results of neighbouring chunks are combined with \a reduceFunction,
+    in the order of the items, until a single result is left.
+
+    If \a chunkSize is 0, the items are split into a few chunks for each
+    thread of \a pool.
+
+    Note that several threads can call \a reduceFunction at the same time,
+    but never with the same values.
+
+    \note This function will block until all items have been processed.
+
+    \sa chunkedMappedReduced(), {Concurrent Map and Map-Reduce}
+*/
+
+/*!
+    \fn template <typename Sequence, typename MapFunctor, typename ReduceFunctor, typename ResultType> ResultType QtConcurrent::blockingChunkedMappedReduced(Sequence &&sequence, MapFunctor &&mapFunction, ReduceFunctor &&reduceFunction, qsizetype chunkSize)
+    \since 6.6
+
+    Calls \a mapFunction once for each chunk of \a chunkSize consecutive
+    items in \a sequence, with the iterators to the first item of the chunk
+    and past its last item.
+    The results of neighbouring chunks are combined with \a reduceFunction,
+    in the order of the items, until a single result is left.
+
+    If \a chunkSize is 0, the items are split into a few chunks for each
+    thread of the global thread pool.
+
+    Note that several threads can call \a reduceFunction at the same time,
+    but never with the same values.
+
+    \note This function will block until all items have been processed.
+
+    \sa chunkedMappedReduced(), {Concurrent Map and Map-Reduce}
+*/
+
+/*!
+    \fn template <typename Iterator, typename MapFunctor, typename ReduceFunctor, typename ResultType> ResultType QtConcurrent::blockingChunkedMappedReduced(QThreadPool *pool, Iterator begin, Iterator end, MapFunctor &&mapFunction, ReduceFunctor &&reduceFunction, qsizetype chunkSize)
+    \since 6.6
+
+    Calls \a mapFunction once for each chunk of \a chunkSize consecutive
+    items from \a begin to \a end, with the iterators to the first item of the chunk
+    and past its last item.
+    All calls to \a mapFunction are invoked from the threads taken from the
+    QThreadPool \a pool.
+    The results of neighbouring chunks are combined with \a reduceFunction,
+    in the order of the items, until a single result is left.
+
+    If \a chunkSize is 0, the items are split into a few chunks for each
+    thread of \a pool.
+
+    Note that several threads can call \a reduceFunction at the same time,
+    but never with the same values.
+
+    \note This function will block until all items have been processed.
+
+    \sa chunkedMappedReduced(), {Concurrent Map and Map-Reduce}
+*/
+
+/*!
+    \fn template <typename Iterator, typename MapFunctor, typename ReduceFunctor, typename ResultType> ResultType QtConcurrent::blockingChunkedMappedReduced(Iterator begin, Iterator end, MapFunctor &&mapFunction, ReduceFunctor &&reduceFunction, qsizetype chunkSize)
+    \since 6.6
+
+    Calls \a mapFunction once for each chunk of \a chunkSize consecutive
+    items from \a begin to \a end, with the iterators to the first item of the chunk
+    and past its last item.
+    The results of neighbouring chunks are combined with \a reduceFunction,
+    in the order of the items, until a single result is left.
+
+    If \a chunkSize is 0, the items are split into a few chunks for each
+    thread of the global thread pool.
+
+    Note that several threads can call \a reduceFunction at the same time,
+    but never with the same values.
+
+    \note This function will block until all items have been processed.
+
+    \sa chunkedMappedReduced(), {Concurrent Map and Map-Reduce}
+*/
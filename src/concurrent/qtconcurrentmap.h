@@ -347,6 +347,62 @@ QFuture<ResultType> mappedReduced(Iterator begin,
          ResultType(std::forward<InitialValueType>(initialValue)), options);
 }
 
+// chunkedMappedReduced() for sequences
+template <typename Sequence, typename MapFunctor, typename ReduceFunctor,
+          typename ResultType = QtPrivate::ChunkMapResultType<
+                  typename std::decay_t<Sequence>::const_iterator, MapFunctor>>
+QFuture<ResultType> chunkedMappedReduced(QThreadPool *pool,
+                                         Sequence &&sequence,
+                                         MapFunctor &&map,
+                                         ReduceFunctor &&reduce,
+                                         qsizetype chunkSize = 0)
+{
+    return startChunkedMappedReduced(pool, std::forward<Sequence>(sequence),
+                                     std::forward<MapFunctor>(map),
+                                     std::forward<ReduceFunctor>(reduce), chunkSize);
+}
+
+template <typename Sequence, typename MapFunctor, typename ReduceFunctor,
+          typename ResultType = QtPrivate::ChunkMapResultType<
+                  typename std::decay_t<Sequence>::const_iterator, MapFunctor>>
+QFuture<ResultType> chunkedMappedReduced(Sequence &&sequence,
+                                         MapFunctor &&map,
+                                         ReduceFunctor &&reduce,
+                                         qsizetype chunkSize = 0)
+{
+    return startChunkedMappedReduced(QThreadPool::globalInstance(),
+                                     std::forward<Sequence>(sequence),
+                                     std::forward<MapFunctor>(map),
+                                     std::forward<ReduceFunctor>(reduce), chunkSize);
+}
+
+// chunkedMappedReduced() for iterators
+template <typename Iterator, typename MapFunctor, typename ReduceFunctor,
+          typename ResultType = QtPrivate::ChunkMapResultType<Iterator, MapFunctor>>
+QFuture<ResultType> chunkedMappedReduced(QThreadPool *pool,
+                                         Iterator begin,
+                                         Iterator end,
+                                         MapFunctor &&map,
+                                         ReduceFunctor &&reduce,
+                                         qsizetype chunkSize = 0)
+{
+    return startChunkedMappedReduced(pool, begin, end, std::forward<MapFunctor>(map),
+                                     std::forward<ReduceFunctor>(reduce), chunkSize);
+}
+
+template <typename Iterator, typename MapFunctor, typename ReduceFunctor,
+          typename ResultType = QtPrivate::ChunkMapResultType<Iterator, MapFunctor>>
+QFuture<ResultType> chunkedMappedReduced(Iterator begin,
+                                         Iterator end,
+                                         MapFunctor &&map,
+                                         ReduceFunctor &&reduce,
+                                         qsizetype chunkSize = 0)
+{
+    return startChunkedMappedReduced(QThreadPool::globalInstance(), begin, end,
+                                     std::forward<MapFunctor>(map),
+                                     std::forward<ReduceFunctor>(reduce), chunkSize);
+}
+
 // mapped() for sequences
 template <typename Sequence, typename MapFunctor>
 QFuture<QtPrivate::MapResultType<Sequence, MapFunctor>> mapped(
@@ -742,6 +798,68 @@ ResultType blockingMappedReduced(Iterator begin,
     return future.takeResult();
 }
 
+// blockingChunkedMappedReduced() for sequences
+template <typename Sequence, typename MapFunctor, typename ReduceFunctor,
+          typename ResultType = QtPrivate::ChunkMapResultType<
+                  typename std::decay_t<Sequence>::const_iterator, MapFunctor>>
+ResultType blockingChunkedMappedReduced(QThreadPool *pool,
+                                        Sequence &&sequence,
+                                        MapFunctor &&map,
+                                        ReduceFunctor &&reduce,
+                                        qsizetype chunkSize = 0)
+{
+    QFuture<ResultType> future =
+            chunkedMappedReduced(pool, std::forward<Sequence>(sequence),
+                                 std::forward<MapFunctor>(map),
+                                 std::forward<ReduceFunctor>(reduce), chunkSize);
+    return future.takeResult();
+}
+
+template <typename Sequence, typename MapFunctor, typename ReduceFunctor,
+          typename ResultType = QtPrivate::ChunkMapResultType<
+                  typename std::decay_t<Sequence>::const_iterator, MapFunctor>>
+ResultType blockingChunkedMappedReduced(Sequence &&sequence,
+                                        MapFunctor &&map,
+                                        ReduceFunctor &&reduce,
+                                        qsizetype chunkSize = 0)
+{
+    QFuture<ResultType> future =
+            chunkedMappedReduced(std::forward<Sequence>(sequence),
+                                 std::forward<MapFunctor>(map),
+                                 std::forward<ReduceFunctor>(reduce), chunkSize);
+    return future.takeResult();
+}
+
+// blockingChunkedMappedReduced() for iterator ranges
+template <typename Iterator, typename MapFunctor, typename ReduceFunctor,
+          typename ResultType = QtPrivate::ChunkMapResultType<Iterator, MapFunctor>>
+ResultType blockingChunkedMappedReduced(QThreadPool *pool,
+                                        Iterator begin,
+                                        Iterator end,
+                                        MapFunctor &&map,
+                                        ReduceFunctor &&reduce,
+                                        qsizetype chunkSize = 0)
+{
+    QFuture<ResultType> future =
+            chunkedMappedReduced(pool, begin, end, std::forward<MapFunctor>(map),
+                                 std::forward<ReduceFunctor>(reduce), chunkSize);
+    return future.takeResult();
+}
+
+template <typename Iterator, typename MapFunctor, typename ReduceFunctor,
+          typename ResultType = QtPrivate::ChunkMapResultType<Iterator, MapFunctor>>
+ResultType blockingChunkedMappedReduced(Iterator begin,
+                                        Iterator end,
+                                        MapFunctor &&map,
+                                        ReduceFunctor &&reduce,
+                                        qsizetype chunkSize = 0)
+{
+    QFuture<ResultType> future =
+            chunkedMappedReduced(begin, end, std::forward<MapFunctor>(map),
+                                 std::forward<ReduceFunctor>(reduce), chunkSize);
+    return future.takeResult();
+}
+
 // mapped() for sequences with a different putput sequence type.
 template <typename OutputSequence, typename InputSequence, typename MapFunctor>
 OutputSequence blockingMapped(QThreadPool *pool, InputSequence &&sequence, MapFunctor &&map)
@@ -139,6 +139,97 @@ public:
     }
 };
 
+// chunked map-reduce kernel: calls the map functor once for each chunk of
+// consecutive items, and combines the results of the chunks in their order
+// with the TreeReduceKernel
+template <typename Iterator, typename MapFunctor, typename ReduceFunctor>
+class ChunkedMappedReducedKernel
+        : public ThreadEngine<QtPrivate::ChunkMapResultType<Iterator, MapFunctor>>
+{
+    using T = QtPrivate::ChunkMapResultType<Iterator, MapFunctor>;
+
+    // a few chunks for each thread, so that the threads finishing early
+    // can take over some of the work of the others
+    static constexpr qsizetype ChunksPerThread = 4;
+
+    const Iterator begin;
+    const qsizetype itemCount;
+    const qsizetype chunkSize;
+    const qsizetype chunkCount;
+    MapFunctor map;
+    ReduceFunctor reduce;
+    TreeReduceKernel<ReduceFunctor, T> reducer;
+    QAtomicInteger<qsizetype> currentChunk;
+    QAtomicInteger<qsizetype> completed;
+    bool progressReportingEnabled = false;
+
+    static qsizetype defaultChunkSize(QThreadPool *pool, qsizetype count)
+    {
+        const qsizetype chunks = qMax(pool->maxThreadCount(), 1) * ChunksPerThread;
+        return qMax((count + chunks - 1) / chunks, qsizetype(1));
+    }
+
+public:
+    template <typename F1 = MapFunctor, typename F2 = ReduceFunctor>
+    ChunkedMappedReducedKernel(QThreadPool *pool, Iterator _begin, Iterator _end, F1 &&_map,
+                               F2 &&_reduce, qsizetype _chunkSize)
+        : ThreadEngine<T>(pool),
+          begin(_begin),
+          itemCount(std::distance(_begin, _end)),
+          chunkSize(_chunkSize > 0 ? _chunkSize : defaultChunkSize(pool, itemCount)),
+          chunkCount((itemCount + chunkSize - 1) / chunkSize),
+          map(std::forward<F1>(_map)),
+          reduce(std::forward<F2>(_reduce)),
+          reducer(chunkCount)
+    { }
+
+    void start() override
+    {
+        progressReportingEnabled = this->isProgressReportingEnabled();
+        if (progressReportingEnabled && itemCount > 0)
+            this->setProgressRange(0, int(itemCount));
+    }
+
+    bool shouldStartThread() override
+    {
+        return currentChunk.loadRelaxed() < chunkCount && !this->shouldThrottleThread();
+    }
+
+    ThreadFunctionResult threadFunction() override
+    {
+        for (;;) {
+            if (this->isCanceled())
+                break;
+
+            const qsizetype chunk = currentChunk.fetchAndAddRelaxed(1);
+            if (chunk >= chunkCount)
+                break;
+
+            this->waitForResume(); // (only waits if the qfuture is paused.)
+
+            const qsizetype beginIndex = chunk * chunkSize;
+            const qsizetype count = qMin(chunkSize, itemCount - beginIndex);
+            Iterator chunkBegin = begin;
+            std::advance(chunkBegin, beginIndex);
+            Iterator chunkEnd = chunkBegin;
+            std::advance(chunkEnd, count);
+            reducer.runReduce(reduce, chunk, std::invoke(map, chunkBegin, chunkEnd));
+
+            if (progressReportingEnabled)
+                this->setProgressValue(int(completed.fetchAndAddRelaxed(count) + count));
+
+            if (this->shouldThrottleThread())
+                return ThrottleThread;
+        }
+        return ThreadFinished;
+    }
+
+    T *result() override
+    {
+        return reducer.result();
+    }
+};
+
 template <typename Iterator, typename MapFunctor>
 class MappedEachKernel : public IterateKernel<Iterator, QtPrivate::MapResultType<Iterator, MapFunctor>>
 {
@@ -317,6 +408,57 @@ inline ThreadEngineStarter<ResultType> startMappedReduced(QThreadPool *pool,
                                                   std::forward<ResultType>(initialValue), options));
 }
 
+template <typename Sequence, typename Base, typename Functor1, typename Functor2>
+struct ChunkedSequenceHolder : private QtPrivate::SequenceHolder<Sequence>, public Base
+{
+    template<typename S = Sequence, typename F1 = Functor1, typename F2 = Functor2>
+    ChunkedSequenceHolder(QThreadPool *pool, S &&_sequence, F1 &&functor1, F2 &&functor2,
+                          qsizetype chunkSize)
+        : QtPrivate::SequenceHolder<Sequence>(std::forward<S>(_sequence)),
+          Base(pool, this->sequence.cbegin(), this->sequence.cend(),
+               std::forward<F1>(functor1), std::forward<F2>(functor2), chunkSize)
+    { }
+
+    void finish() override
+    {
+        Base::finish();
+        // Clear the sequence to make sure all temporaries are destroyed
+        // before finished is signaled.
+        this->sequence = Sequence();
+    }
+};
+
+//! [qtconcurrentmapkernel-8]
+template <typename Sequence, typename MapFunctor, typename ReduceFunctor>
+inline auto startChunkedMappedReduced(QThreadPool *pool, Sequence &&sequence,
+                                      MapFunctor &&mapFunctor, ReduceFunctor &&reduceFunctor,
+                                      qsizetype chunkSize)
+{
+    using DecayedSequence = std::decay_t<Sequence>;
+    using DecayedMapFunctor = std::decay_t<MapFunctor>;
+    using DecayedReduceFunctor = std::decay_t<ReduceFunctor>;
+    using Iterator = typename DecayedSequence::const_iterator;
+    using Kernel = ChunkedMappedReducedKernel<Iterator, DecayedMapFunctor, DecayedReduceFunctor>;
+    using SequenceHolderType = ChunkedSequenceHolder<DecayedSequence, Kernel, DecayedMapFunctor,
+                                                     DecayedReduceFunctor>;
+    return startThreadEngine(new SequenceHolderType(pool, std::forward<Sequence>(sequence),
+                                                    std::forward<MapFunctor>(mapFunctor),
+                                                    std::forward<ReduceFunctor>(reduceFunctor),
+                                                    chunkSize));
+}
+
+//! [qtconcurrentmapkernel-9]
+template <typename Iterator, typename MapFunctor, typename ReduceFunctor>
+inline auto startChunkedMappedReduced(QThreadPool *pool, Iterator begin, Iterator end,
+                                      MapFunctor &&mapFunctor, ReduceFunctor &&reduceFunctor,
+                                      qsizetype chunkSize)
+{
+    using Kernel = ChunkedMappedReducedKernel<Iterator, std::decay_t<MapFunctor>,
+                                              std::decay_t<ReduceFunctor>>;
+    return startThreadEngine(new Kernel(pool, begin, end, std::forward<MapFunctor>(mapFunctor),
+                                        std::forward<ReduceFunctor>(reduceFunctor), chunkSize));
+}
+
 } // namespace QtConcurrent
 
 
@@ -15,6 +15,7 @@
 #include <QtCore/qthread.h>
 #include <QtCore/qthreadpool.h>
 
+#include <memory>
 #include <mutex>
 
 QT_BEGIN_NAMESPACE
@@ -198,6 +199,75 @@ public:
     }
 };
 
+// TreeReduceKernel reduces the results of a fixed number of chunks in the
+// order of the chunks, along a binary tree over them. Of two neighbouring
+// subtrees, the thread that delivers the second result combines both and
+// carries on towards the root, while the other thread returns at once. No
+// thread ever waits for another, and no lock is taken.
+template <typename ReduceFunctor, typename T>
+class TreeReduceKernel
+{
+    struct Node
+    {
+        QAtomicInt arrivals;    // of the two children
+        T value;                // waiting for the neighbour
+    };
+
+    const qsizetype chunkCount;
+    QList<qsizetype> levelOffsets;
+    std::unique_ptr<Node[]> nodes;
+    T reducedResult{};
+
+    Node &node(qsizetype level, qsizetype index)
+    {
+        return nodes[levelOffsets.at(level) + index];
+    }
+
+public:
+    explicit TreeReduceKernel(qsizetype count)
+        : chunkCount(count)
+    {
+        qsizetype nodeCount = 0;
+        for (qsizetype levelSize = count; ; levelSize = (levelSize + 1) / 2) {
+            levelOffsets.append(nodeCount);
+            nodeCount += levelSize;
+            if (levelSize <= 1)
+                break;
+        }
+        nodes.reset(new Node[nodeCount]);
+    }
+
+    // Must be called exactly once for each chunk
+    void runReduce(ReduceFunctor &reduce, qsizetype chunk, T &&result)
+    {
+        qsizetype index = chunk;
+        qsizetype levelSize = chunkCount;
+        for (qsizetype level = 0; levelSize > 1; ++level) {
+            // the last node of a level with an odd size has no neighbour
+            if ((index | 1) < levelSize) {
+                node(level, index).value = std::move(result);
+                // publishes the value above, and acquires the neighbour's
+                if (node(level + 1, index / 2).arrivals.fetchAndAddOrdered(1) == 0)
+                    return;
+
+                Node &left = node(level, index & ~qsizetype(1));
+                Node &right = node(level, index | 1);
+                std::invoke(reduce, left.value, right.value);
+                result = std::move(left.value);
+                right.value = T();
+            }
+            index /= 2;
+            levelSize = (levelSize + 1) / 2;
+        }
+        reducedResult = std::move(result);
+    }
+
+    T *result()
+    {
+        return &reducedResult;
+    }
+};
+
 template <typename Sequence, typename Base, typename Functor1, typename Functor2>
 struct SequenceHolder2 : private QtPrivate::SequenceHolder<Sequence>, public Base
 {
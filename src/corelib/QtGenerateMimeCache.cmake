@@ -0,0 +1,64 @@
+# Copyright (C) 2023 The Qt Company Ltd.
+# SPDX-License-Identifier: BSD-3-Clause
+cmake_minimum_required(VERSION 3.16)
+
+# Runs update-mime-database on INPUT_FILE and writes the resulting mime.cache and list of types
+# to OUTPUT_FILE, so that QMimeDatabase can use them instead of parsing the XML at run time.
+# Without UPDATE_MIME_DATABASE, OUTPUT_FILE is written without them.
+
+get_filename_component(output_directory "${OUTPUT_FILE}" DIRECTORY)
+set(mime_directory "${output_directory}/mimecache/mime")
+file(REMOVE_RECURSE "${output_directory}/mimecache")
+file(MAKE_DIRECTORY "${mime_directory}/packages")
+
+if(UPDATE_MIME_DATABASE)
+    file(COPY "${INPUT_FILE}" DESTINATION "${mime_directory}/packages")
+    execute_process(COMMAND "${UPDATE_MIME_DATABASE}" "${mime_directory}"
+        RESULT_VARIABLE failed_to_update
+        OUTPUT_QUIET
+        ERROR_VARIABLE error_string
+    )
+    if(failed_to_update OR NOT EXISTS "${mime_directory}/mime.cache"
+            OR NOT EXISTS "${mime_directory}/types")
+        message(WARNING "Unable to generate the mime type database cache: ${error_string}")
+        set(UPDATE_MIME_DATABASE "")
+    endif()
+endif()
+
+if(NOT UPDATE_MIME_DATABASE)
+    file(WRITE "${OUTPUT_FILE}" "// The mime type database has no cache\n")
+    file(REMOVE_RECURSE "${output_directory}/mimecache")
+    return()
+endif()
+
+file(READ "${mime_directory}/mime.cache" qmime_cache_data HEX)
+file(SIZE "${mime_directory}/mime.cache" qmime_cache_data_size)
+
+string(REGEX MATCHALL "([a-f0-9][a-f0-9])" qmime_cache_hex "${qmime_cache_data}")
+
+list(TRANSFORM qmime_cache_hex PREPEND "0x")
+math(EXPR qmime_cache_data_size "${qmime_cache_data_size} - 1")
+foreach(index RANGE 0 ${qmime_cache_data_size} 12)
+    list(APPEND index_list ${index})
+endforeach()
+list(TRANSFORM qmime_cache_hex PREPEND "\n " AT ${index_list})
+list(JOIN qmime_cache_hex ", " qmime_cache_hex_joined)
+
+file(STRINGS "${mime_directory}/types" qmime_types)
+list(SORT qmime_types)
+list(TRANSFORM qmime_types REPLACE "(.+)" "\n    \"\\1\\\\n\"")
+list(JOIN qmime_types "" qmime_types_joined)
+
+# The cache is accessed in place, it needs the alignment of its 32-bit values
+string(APPEND qmime_cache_content
+    "#define MIME_DATABASE_HAS_CACHE\n"
+    "alignas(4096) static const unsigned char mimetype_cache[] = {"
+    "${qmime_cache_hex_joined}"
+    "\n};\n"
+    "static const char mimetype_cache_types[] ="
+    "${qmime_types_joined}"
+    ";\n"
+)
+
+file(WRITE "${OUTPUT_FILE}" "${qmime_cache_content}")
+file(REMOVE_RECURSE "${output_directory}/mimecache")
@@ -129,3 +129,19 @@ QVariant MyModel::data(const QModelIndex &index, int role) const
     return roleData.data();
 }
 //! [16]
+
+//! [17]
+// The display and decoration roles of the visible rows of a list
+const int rows = lastRow - firstRow + 1;
+std::vector<QModelRoleData> roleData;
+roleData.insert(roleData.end(), rows, QModelRoleData(Qt::DisplayRole));
+roleData.insert(roleData.end(), rows, QModelRoleData(Qt::DecorationRole));
+
+model->blockData(model->index(firstRow, 0), model->index(lastRow, 0), roleData);
+
+for (int i = 0; i < rows; ++i) {
+    const QVariant &display = roleData[i].data();
+    const QVariant &decoration = roleData[rows + i].data();
+    // ...
+}
+//! [17]
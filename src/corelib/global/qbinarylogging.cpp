@@ -0,0 +1,928 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qbinarylogging_p.h"
+
+#include "qdatetime.h"
+#include "qendian.h"
+#include "qfile.h"
+#include "qhash.h"
+#include "qiodevice.h"
+#include "qvarlengtharray.h"
+#include <private/qlocking_p.h>
+#include <private/qtools_p.h>
+
+#include <algorithm>
+#include <chrono>
+
+QT_BEGIN_NAMESPACE
+
+using namespace QtMiscUtils;
+
+namespace QBinaryLogging {
+
+/*!
+    \internal
+
+    Parses the printf-style \a format the way QString::vasprintf() does and
+    stores the conversions that take arguments in \a conversions. Returns
+    false if the format has a conversion that can't be recorded: \c %n, or one
+    that QString::vasprintf() would print as text after taking arguments for
+    it.
+*/
+bool parseFormat(const char *format, QList<Conversion> *conversions)
+{
+    conversions->clear();
+    if (!format)
+        return true;
+
+    const char *c = format;
+    for (;;) {
+        while (*c != '\0' && *c != '%')
+            ++c;
+        if (*c == '\0')
+            return true;
+
+        const char *escapeStart = c;
+        ++c;
+        if (*c == '\0')
+            return true;
+        if (*c == '%') {
+            ++c;
+            continue;
+        }
+
+        Conversion conversion = {};
+        conversion.begin = escapeStart - format;
+
+        while (*c == '#' || *c == '0' || *c == '-' || *c == ' ' || *c == '+' || *c == '\'')
+            ++c;
+        if (*c == '\0')
+            return true;
+
+        if (*c == '*') {
+            ++conversion.stars;
+            ++c;
+        } else {
+            while (isAsciiDigit(*c))
+                ++c;
+        }
+        if (*c == '\0')
+            return conversion.stars == 0;
+
+        if (*c == '.') {
+            ++c;
+            if (*c == '*') {
+                ++conversion.stars;
+                ++c;
+            } else {
+                while (isAsciiDigit(*c))
+                    ++c;
+            }
+        }
+        if (*c == '\0')
+            return conversion.stars == 0;
+
+        conversion.size = ArgumentSize::Int;
+        switch (*c) {
+        case 'h':
+            ++c;
+            conversion.size = ArgumentSize::Short;
+            if (*c == 'h') {
+                ++c;
+                conversion.size = ArgumentSize::Char;
+            }
+            break;
+        case 'l':
+            ++c;
+            conversion.size = ArgumentSize::Long;
+            if (*c == 'l') {
+                ++c;
+                conversion.size = ArgumentSize::LongLong;
+            }
+            break;
+        case 'L': ++c; conversion.size = ArgumentSize::LongDouble; break;
+        case 'j': ++c; conversion.size = ArgumentSize::IntMax; break;
+        case 'z':
+        case 'Z': ++c; conversion.size = ArgumentSize::SizeT; break;
+        case 't': ++c; conversion.size = ArgumentSize::PtrDiff; break;
+        }
+        if (*c == '\0')
+            return conversion.stars == 0;
+
+        switch (*c) {
+        case 'd':
+        case 'i':
+            conversion.type = ArgumentType::Signed;
+            break;
+        case 'o':
+        case 'u':
+        case 'x':
+        case 'X':
+            conversion.type = ArgumentType::Unsigned;
+            break;
+        case 'E':
+        case 'e':
+        case 'F':
+        case 'f':
+        case 'G':
+        case 'g':
+        case 'A':
+        case 'a':
+            conversion.type = ArgumentType::Double;
+            break;
+        case 'c':
+            conversion.type = ArgumentType::Signed;
+            conversion.size = conversion.size == ArgumentSize::Long ? ArgumentSize::Long
+                                                                    : ArgumentSize::Int;
+            break;
+        case 's':
+            conversion.type = conversion.size == ArgumentSize::Long ? ArgumentType::Utf16String
+                                                                    : ArgumentType::String;
+            break;
+        case 'p':
+            conversion.type = ArgumentType::Pointer;
+            break;
+        default:
+            // %n writes to its argument; anything else is printed as text,
+            // but only after taking the arguments for '*'
+            return false;
+        }
+        ++c;
+        conversion.end = c - format;
+        conversions->append(conversion);
+    }
+}
+
+static bool readVarint(const uchar *&p, const uchar *end, quint64 *value)
+{
+    quint64 result = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (p == end)
+            return false;
+        const uchar byte = *p++;
+        result |= quint64(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool readSignedVarint(const uchar *&p, const uchar *end, qint64 *value)
+{
+    quint64 u;
+    if (!readVarint(p, end, &u))
+        return false;
+    *value = qint64(u >> 1) ^ -qint64(u & 1);
+    return true;
+}
+
+static bool readBytes(const uchar *&p, const uchar *end, qsizetype size, QByteArrayView *bytes)
+{
+    if (size < 0 || end - p < size)
+        return false;
+    *bytes = QByteArrayView(p, size);
+    p += size;
+    return true;
+}
+
+namespace {
+struct Format
+{
+    QByteArray text;
+    QList<Conversion> conversions;
+};
+
+// Renders the arguments of a record the way QString::vasprintf() would
+class Renderer
+{
+public:
+    Renderer(const uchar *&p, const uchar *end) : p(p), end(end) {}
+
+    bool render(const Format &format, QString *text);
+
+private:
+    bool takeInt(qint64 *value) { return readSignedVarint(p, end, value); }
+    static QString literal(const Format &format, qsizetype begin, qsizetype end)
+    {
+        return QString::fromUtf8(format.text.mid(begin, end - begin).replace("%%", "%"));
+    }
+    QByteArray specification(const Format &format, const Conversion &conversion,
+                             qint64 width, qint64 precision) const;
+
+    const uchar *&p;
+    const uchar *end;
+};
+} // unnamed namespace
+
+// Returns the specification of the conversion with the values of '*'
+// filled in and the length modifier replaced by what we pass
+QByteArray Renderer::specification(const Format &format, const Conversion &conversion,
+                                   qint64 width, qint64 precision) const
+{
+    QByteArray spec;
+    const char *c = format.text.constData() + conversion.begin;
+    const char *specEnd = format.text.constData() + conversion.end;
+    spec.append(*c++);   // '%'
+    while (*c == '#' || *c == '0' || *c == '-' || *c == ' ' || *c == '+' || *c == '\'')
+        spec.append(*c++);
+    if (*c == '*') {
+        ++c;
+        if (width >= 0)
+            spec.append(QByteArray::number(width));
+    } else {
+        while (isAsciiDigit(*c))
+            spec.append(*c++);
+    }
+    if (*c == '.') {
+        ++c;
+        if (*c == '*') {
+            ++c;
+            if (precision >= 0)
+                spec.append('.').append(QByteArray::number(precision));
+        } else {
+            spec.append('.');
+            while (isAsciiDigit(*c))
+                spec.append(*c++);
+        }
+    }
+
+    const char conversionChar = specEnd[-1];
+    switch (conversion.type) {
+    case ArgumentType::Signed:
+        if (conversionChar == 'c')
+            spec.append(conversion.size == ArgumentSize::Long ? "l" : "");
+        else
+            spec.append("ll");
+        break;
+    case ArgumentType::Unsigned:
+        spec.append("ll");
+        break;
+    case ArgumentType::Utf16String:
+        spec.append('l');
+        break;
+    case ArgumentType::Double:
+    case ArgumentType::String:
+    case ArgumentType::Pointer:
+        break;
+    }
+    spec.append(conversionChar);
+    return spec;
+}
+
+bool Renderer::render(const Format &format, QString *text)
+{
+    text->clear();
+    qsizetype literalBegin = 0;
+    for (const Conversion &conversion : format.conversions) {
+        // the literal text up to the conversion, with %% in it
+        *text += literal(format, literalBegin, conversion.begin);
+        literalBegin = conversion.end;
+
+        qint64 stars[2] = { -1, -1 };
+        for (int i = 0; i < conversion.stars; ++i) {
+            if (!takeInt(&stars[i]))
+                return false;
+        }
+        qint64 width = -1;
+        qint64 precision = -1;
+        if (conversion.stars == 2) {
+            width = stars[0];
+            precision = stars[1];
+        } else if (conversion.stars == 1) {
+            // the '*' is either the width or the precision
+            const char *c = format.text.constData() + conversion.begin + 1;
+            while (*c != '*' && *c != '.')
+                ++c;
+            if (*c == '*')
+                width = stars[0];
+            else
+                precision = stars[0];
+        }
+        const QByteArray spec = specification(format, conversion, width, precision);
+
+        switch (conversion.type) {
+        case ArgumentType::Signed: {
+            qint64 value;
+            if (!takeInt(&value))
+                return false;
+            if (spec.endsWith('c'))
+                *text += QString::asprintf(spec.constData(), int(value));
+            else
+                *text += QString::asprintf(spec.constData(), qlonglong(value));
+            break;
+        }
+        case ArgumentType::Unsigned:
+        case ArgumentType::Pointer: {
+            quint64 value;
+            if (!readVarint(p, end, &value))
+                return false;
+            if (conversion.type == ArgumentType::Pointer)
+                *text += QString::asprintf(spec.constData(), reinterpret_cast<void *>(quintptr(value)));
+            else
+                *text += QString::asprintf(spec.constData(), qulonglong(value));
+            break;
+        }
+        case ArgumentType::Double: {
+            QByteArrayView bytes;
+            if (!readBytes(p, end, sizeof(double), &bytes))
+                return false;
+            const double value = qFromLittleEndian<double>(bytes.data());
+            *text += QString::asprintf(spec.constData(), value);
+            break;
+        }
+        case ArgumentType::String: {
+            quint64 size;
+            QByteArrayView bytes;
+            if (!readVarint(p, end, &size))
+                return false;
+            if (size == 0) {
+                *text += QString::asprintf(spec.constData(), static_cast<const char *>(nullptr));
+                break;
+            }
+            if (!readBytes(p, end, qsizetype(size - 1), &bytes))
+                return false;
+            *text += QString::asprintf(spec.constData(), bytes.toByteArray().constData());
+            break;
+        }
+        case ArgumentType::Utf16String: {
+            quint64 size;
+            QByteArrayView bytes;
+            if (!readVarint(p, end, &size) || size == 0
+                    || !readBytes(p, end, 2 * (qsizetype(size) - 1), &bytes)) {
+                return false;
+            }
+            QVarLengthArray<char16_t> buffer(size);
+            qFromLittleEndian<char16_t>(bytes.data(), size - 1, buffer.data());
+            buffer[size - 1] = 0;
+            *text += QString::asprintf(spec.constData(), buffer.constData());
+            break;
+        }
+        }
+    }
+    *text += literal(format, literalBegin, format.text.size());
+    return true;
+}
+
+// The monotonic clock that QElapsedTimer uses too
+static qint64 steadyNSecs()
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+static void appendVarint(QByteArray &data, quint64 value)
+{
+    char buffer[10];
+    int size = 0;
+    while (value >= 0x80) {
+        buffer[size++] = char(value | 0x80);
+        value >>= 7;
+    }
+    buffer[size++] = char(value);
+    data.append(buffer, size);
+}
+
+static void appendSignedVarint(QByteArray &data, qint64 value)
+{
+    appendVarint(data, (quint64(value) << 1) ^ quint64(value >> 63));
+}
+
+static void appendBlock(QByteArray &data, BlockType type, quint64 id, QByteArrayView bytes)
+{
+    data.append(char(type));
+    appendVarint(data, id);
+    appendVarint(data, bytes.size());
+    data.append(bytes);
+}
+
+// Records are collected per thread and written to the file in chunks
+static constexpr qsizetype ChunkSize = 64 * 1024;
+
+struct Writer::FormatEntry
+{
+    quint64 id;
+    quint32 generation;
+    QByteArray text;
+    QList<Conversion> conversions;
+    bool supported;
+};
+
+struct Writer::ThreadBuffer
+{
+    // Locked by the thread for each record, and by others to flush
+    QBasicMutex mutex;
+    Writer *writer;             // nullptr once the writer is gone
+    bool attached = true;       // false once the thread has exited
+    qint64 threadId = 0;
+    quint32 generation = 0;     // of the IDs in the data and caches
+    QByteArray definitions;     // blocks for the strings and formats first used here
+    QByteArray records;
+    // by address; entries are checked against the text, which may change
+    QHash<const char *, const FormatEntry *> formatCache;
+    QHash<const char *, std::pair<quint64, const char *>> stringCache;
+};
+
+struct ThreadBufferHandle
+{
+    Writer::ThreadBuffer *buffer = nullptr;
+    ~ThreadBufferHandle()
+    {
+        if (!buffer)
+            return;
+        buffer->mutex.lock();
+        Writer *writer = buffer->writer;
+        buffer->attached = false;
+        buffer->mutex.unlock();
+        if (writer)
+            writer->releaseBuffer(buffer);
+        else
+            delete buffer;
+    }
+};
+Q_CONSTINIT static thread_local ThreadBufferHandle currentBuffer;
+
+/*!
+    \internal
+    \class QBinaryLogging::Writer
+    \inmodule QtCore
+
+    Writes messages to a binary log file. Messages logged with a format are
+    recorded as the format and the arguments, so that the logging thread does
+    not need to format them. Each thread collects its records in its own
+    buffer, which is written to the file when it is full, for critical
+    messages, and by flush().
+*/
+
+Writer::~Writer()
+{
+    close();
+    const auto locker = qt_scoped_lock(fileMutex);
+    for (ThreadBuffer *buffer : std::as_const(buffers)) {
+        buffer->mutex.lock();
+        buffer->writer = nullptr;
+        const bool attached = buffer->attached;
+        buffer->mutex.unlock();
+        if (!attached)
+            delete buffer;
+    }
+    qDeleteAll(formats);
+}
+
+/*!
+    \internal
+
+    Starts writing to a new file \a fileName, after finishing the current one.
+    The log records \a pid as the process ID and uses \a currentThreadId to
+    get the IDs of the threads that log.
+*/
+bool Writer::open(const QString &fileName, qint64 pid, qint64 (*currentThreadId)())
+{
+    close();
+
+    FILE *f = fopen(QFile::encodeName(fileName).constData(), "wb");
+    if (!f)
+        return false;
+
+    const qint64 start = steadyNSecs();
+    QByteArray header("QTBINLOG");
+    header.append(char(Version));
+    appendVarint(header, quint64(pid));
+    char times[16];
+    qToLittleEndian<qint64>(QDateTime::currentMSecsSinceEpoch(), times);
+    qToLittleEndian<qint64>(start, times + 8);
+    header.append(times, sizeof times);
+    fwrite(header.constData(), 1, header.size(), f);
+
+    const auto locker = qt_scoped_lock(fileMutex);
+    threadId = currentThreadId;
+    startNSecs = start;
+    file = f;
+    return true;
+}
+
+/*!
+    \internal
+
+    Writes what all threads have logged so far and closes the file.
+*/
+void Writer::close()
+{
+    const auto locker = qt_scoped_lock(fileMutex);
+    if (!file)
+        return;
+
+    for (ThreadBuffer *buffer : std::as_const(buffers)) {
+        const auto bufferLocker = qt_scoped_lock(buffer->mutex);
+        flushLocked(buffer);
+    }
+    fclose(file);
+    file = nullptr;
+    // the strings and formats need to be defined again in the next file;
+    // records that threads are writing meanwhile are dropped
+    generation.fetchAndAddRelaxed(1);
+}
+
+/*!
+    \internal
+
+    Writes what all threads have logged so far to the file.
+*/
+void Writer::flush()
+{
+    const auto locker = qt_scoped_lock(fileMutex);
+    if (!file)
+        return;
+    for (ThreadBuffer *buffer : std::as_const(buffers)) {
+        const auto bufferLocker = qt_scoped_lock(buffer->mutex);
+        flushLocked(buffer);
+    }
+    fflush(file);
+}
+
+// Requires fileMutex and the mutex of the buffer
+void Writer::flushLocked(ThreadBuffer *buffer)
+{
+    if (buffer->generation != generation.loadRelaxed()) {
+        // the IDs in the data are not valid in this file
+        buffer->definitions.clear();
+        buffer->records.clear();
+        return;
+    }
+    if (!buffer->definitions.isEmpty()) {
+        fwrite(buffer->definitions.constData(), 1, buffer->definitions.size(), file);
+        buffer->definitions.truncate(0);
+    }
+    if (!buffer->records.isEmpty()) {
+        QByteArray header;
+        header.append(char(ChunkBlock));
+        appendVarint(header, quint64(buffer->threadId));
+        appendVarint(header, buffer->records.size());
+        fwrite(header.constData(), 1, header.size(), file);
+        fwrite(buffer->records.constData(), 1, buffer->records.size(), file);
+        buffer->records.truncate(0);
+    }
+}
+
+void Writer::releaseBuffer(ThreadBuffer *buffer)
+{
+    const auto locker = qt_scoped_lock(fileMutex);
+    {
+        const auto bufferLocker = qt_scoped_lock(buffer->mutex);
+        if (file)
+            flushLocked(buffer);
+    }
+    buffers.removeOne(buffer);
+    delete buffer;
+}
+
+Writer::ThreadBuffer *Writer::bufferForCurrentThread()
+{
+    if (ThreadBuffer *buffer = currentBuffer.buffer) {
+        if (buffer->writer == this)
+            return buffer;
+    }
+
+    auto buffer = new ThreadBuffer;
+    buffer->writer = this;
+    buffer->threadId = threadId ? threadId() : 0;
+    {
+        const auto locker = qt_scoped_lock(fileMutex);
+        buffer->generation = generation.loadRelaxed();
+        buffers.append(buffer);
+    }
+    currentBuffer.buffer = buffer;
+    return buffer;
+}
+
+// Requires the mutex of the buffer
+quint64 Writer::string(ThreadBuffer *buffer, const char *text)
+{
+    if (!text)
+        return 0;
+    const auto it = buffer->stringCache.constFind(text);
+    if (it != buffer->stringCache.cend() && qstrcmp(it->second, text) == 0)
+        return it->first;
+
+    const auto locker = qt_scoped_lock(tableMutex);
+    const QByteArray key(text);
+    auto entry = strings.find(key);
+    if (entry == strings.end())
+        entry = strings.insert(key, { nextId++, buffer->generation - 1 });
+    if (entry->generation != buffer->generation) {
+        entry->generation = buffer->generation;
+        appendBlock(buffer->definitions, StringBlock, entry->id, key);
+    }
+    // entries are never removed, so the key outlives the cache
+    buffer->stringCache.insert(text, { entry->id, entry.key().constData() });
+    return entry->id;
+}
+
+// Requires the mutex of the buffer
+const Writer::FormatEntry *Writer::format(ThreadBuffer *buffer, const char *text)
+{
+    const auto it = buffer->formatCache.constFind(text);
+    if (it != buffer->formatCache.cend() && qstrcmp((*it)->text.constData(), text) == 0)
+        return *it;
+
+    const auto locker = qt_scoped_lock(tableMutex);
+    const QByteArray key(text);
+    FormatEntry *&entry = formats[key];
+    if (!entry) {
+        entry = new FormatEntry;
+        entry->text = key;
+        entry->supported = parseFormat(text, &entry->conversions);
+        entry->id = entry->supported ? nextId++ : 0;
+        entry->generation = buffer->generation - 1;
+    }
+    if (entry->supported && entry->generation != buffer->generation) {
+        entry->generation = buffer->generation;
+        appendBlock(buffer->definitions, FormatBlock, entry->id, key);
+    }
+    buffer->formatCache.insert(text, entry);
+    return entry;
+}
+
+// Requires the mutex of the buffer
+void Writer::beginRecord(ThreadBuffer *buffer, RecordType recordType, QtMsgType type,
+                         const QMessageLogContext &context)
+{
+    QByteArray &data = buffer->records;
+    data.append(char(recordType));
+    data.append(char(type));
+    appendVarint(data, quint64(steadyNSecs() - startNSecs));
+    appendVarint(data, string(buffer, context.category));
+    appendVarint(data, string(buffer, context.file));
+    appendVarint(data, string(buffer, context.function));
+    appendSignedVarint(data, context.line);
+}
+
+void Writer::endRecord(ThreadBuffer *buffer, QtMsgType type)
+{
+    if (buffer->records.size() < ChunkSize && type != QtCriticalMsg && type != QtFatalMsg)
+        return;
+
+    // write the buffer without holding its mutex, see fileMutex
+    QByteArray definitions;
+    QByteArray records;
+    quint32 dataGeneration;
+    {
+        const auto locker = qt_scoped_lock(buffer->mutex);
+        definitions.swap(buffer->definitions);
+        records.swap(buffer->records);
+        dataGeneration = buffer->generation;
+        buffer->records.reserve(ChunkSize + ChunkSize / 4);
+    }
+
+    const auto locker = qt_scoped_lock(fileMutex);
+    if (!file || dataGeneration != generation.loadRelaxed())
+        return;
+    ThreadBuffer chunk;
+    chunk.threadId = buffer->threadId;
+    chunk.generation = dataGeneration;
+    chunk.definitions = std::move(definitions);
+    chunk.records = std::move(records);
+    flushLocked(&chunk);
+    if (type == QtCriticalMsg || type == QtFatalMsg)
+        fflush(file);
+}
+
+bool Writer::writeArguments(QtMsgType type, const QMessageLogContext &context,
+                            const char *format, va_list ap)
+{
+    ThreadBuffer *buffer = bufferForCurrentThread();
+    {
+        const auto locker = qt_scoped_lock(buffer->mutex);
+        if (buffer->generation != generation.loadRelaxed()) {
+            buffer->generation = generation.loadRelaxed();
+            buffer->formatCache.clear();
+            buffer->stringCache.clear();
+        }
+
+        const FormatEntry *entry = this->format(buffer, format);
+        if (!entry->supported)
+            return false;
+
+        beginRecord(buffer, ArgumentsRecord, type, context);
+        QByteArray &data = buffer->records;
+        appendVarint(data, entry->id);
+        for (const Conversion &conversion : entry->conversions) {
+            for (int i = 0; i < conversion.stars; ++i)
+                appendSignedVarint(data, va_arg(ap, int));
+
+            // take the arguments as QString::vasprintf() does
+            switch (conversion.type) {
+            case ArgumentType::Signed: {
+                qint64 value;
+                switch (conversion.size) {
+                case ArgumentSize::Long: value = va_arg(ap, long int); break;
+                case ArgumentSize::LongLong: value = va_arg(ap, qint64); break;
+                case ArgumentSize::IntMax: value = va_arg(ap, long int); break;
+                case ArgumentSize::SizeT:
+                case ArgumentSize::PtrDiff: value = va_arg(ap, qsizetype); break;
+                case ArgumentSize::LongDouble: value = 0; break;
+                default: value = va_arg(ap, int); break;
+                }
+                appendSignedVarint(data, value);
+                break;
+            }
+            case ArgumentType::Unsigned: {
+                quint64 value;
+                switch (conversion.size) {
+                case ArgumentSize::Long: value = va_arg(ap, ulong); break;
+                case ArgumentSize::LongLong: value = va_arg(ap, quint64); break;
+                case ArgumentSize::SizeT:
+                case ArgumentSize::PtrDiff: value = va_arg(ap, size_t); break;
+                case ArgumentSize::IntMax:
+                case ArgumentSize::LongDouble: value = 0; break;
+                default: value = va_arg(ap, uint); break;
+                }
+                appendVarint(data, value);
+                break;
+            }
+            case ArgumentType::Double: {
+                const double value = conversion.size == ArgumentSize::LongDouble
+                        ? double(va_arg(ap, long double)) : va_arg(ap, double);
+                char bytes[sizeof(double)];
+                qToLittleEndian(value, bytes);
+                data.append(bytes, sizeof bytes);
+                break;
+            }
+            case ArgumentType::String: {
+                const char *value = va_arg(ap, const char *);
+                const qsizetype size = value ? qstrlen(value) : 0;
+                appendVarint(data, value ? size + 1 : 0);
+                data.append(value, size);
+                break;
+            }
+            case ArgumentType::Utf16String: {
+                const char16_t *value = va_arg(ap, const char16_t *);
+                const qsizetype size = value ? QStringView(value).size() : 0;
+                appendVarint(data, size + 1);
+                const qsizetype offset = data.size();
+                data.resize(offset + 2 * size);
+                qToLittleEndian<char16_t>(value, size, data.data() + offset);
+                break;
+            }
+            case ArgumentType::Pointer:
+                appendVarint(data, quintptr(va_arg(ap, void *)));
+                break;
+            }
+        }
+    }
+    endRecord(buffer, type);
+    return true;
+}
+
+void Writer::writeText(QtMsgType type, const QMessageLogContext &context, const QString &text)
+{
+    ThreadBuffer *buffer = bufferForCurrentThread();
+    {
+        const auto locker = qt_scoped_lock(buffer->mutex);
+        if (buffer->generation != generation.loadRelaxed()) {
+            buffer->generation = generation.loadRelaxed();
+            buffer->formatCache.clear();
+            buffer->stringCache.clear();
+        }
+
+        beginRecord(buffer, TextRecord, type, context);
+        const QByteArray utf8 = text.toUtf8();
+        appendVarint(buffer->records, utf8.size());
+        buffer->records.append(utf8);
+    }
+    endRecord(buffer, type);
+}
+
+/*!
+    \internal
+    \class QBinaryLogging::Reader
+    \inmodule QtCore
+
+    Reads a log file written by the binary message output of the default
+    message handler and renders the messages in it as text.
+*/
+
+/*!
+    \internal
+
+    Reads all messages from \a device. Returns false and sets errorString()
+    if the data isn't a valid binary log; the messages read up to the error
+    are still available.
+*/
+bool Reader::read(QIODevice *device)
+{
+    m_messages.clear();
+    m_errorString.clear();
+
+    const QByteArray data = device->readAll();
+    const uchar *p = reinterpret_cast<const uchar *>(data.constData());
+    const uchar *end = p + data.size();
+    const auto sortMessages = [this] {
+        std::stable_sort(m_messages.begin(), m_messages.end(), [](const Message &m1, const Message &m2) {
+            return m1.nsecsSinceStart < m2.nsecsSinceStart;
+        });
+    };
+    const auto fail = [&](const char *error) {
+        m_errorString = QString::fromLatin1(error);
+        sortMessages();
+        return false;
+    };
+
+    QByteArrayView magic;
+    if (!readBytes(p, end, 8, &magic) || magic != "QTBINLOG")
+        return fail("Not a binary log file");
+    if (p == end || *p++ != Version)
+        return fail("Unsupported binary log version");
+    quint64 pid;
+    QByteArrayView times;
+    if (!readVarint(p, end, &pid) || !readBytes(p, end, 16, &times))
+        return fail("Truncated header");
+    m_pid = qint64(pid);
+    m_startMSecsSinceEpoch = qFromLittleEndian<qint64>(times.data());
+    m_startNSecsSinceReference = qFromLittleEndian<qint64>(times.data() + 8);
+
+    // the definitions can come after the chunks that use them
+    QHash<quint64, QByteArray> strings;
+    QHash<quint64, Format> formats;
+    QList<std::pair<qint64, QByteArrayView>> chunks;
+    while (p != end) {
+        const char type = char(*p++);
+        quint64 id, size;
+        QByteArrayView bytes;
+        if (!readVarint(p, end, &id) || !readVarint(p, end, &size)
+                || !readBytes(p, end, qsizetype(size), &bytes)) {
+            break;  // the end of a log that wasn't closed
+        }
+        switch (type) {
+        case StringBlock:
+            strings.insert(id, bytes.toByteArray());
+            break;
+        case FormatBlock: {
+            Format format;
+            format.text = bytes.toByteArray();
+            if (parseFormat(format.text.constData(), &format.conversions))
+                formats.insert(id, std::move(format));
+            break;
+        }
+        case ChunkBlock:
+            chunks.append({qint64(id), bytes});
+            break;
+        default:
+            return fail("Unknown block");
+        }
+    }
+
+    for (const auto &[threadId, chunk] : std::as_const(chunks)) {
+        const uchar *q = reinterpret_cast<const uchar *>(chunk.data());
+        const uchar *chunkEnd = q + chunk.size();
+        while (q != chunkEnd) {
+            if (chunkEnd - q < 2)
+                return fail("Truncated record");
+            const quint8 recordType = *q++;
+            Message message;
+            message.type = QtMsgType(*q++);
+            message.threadId = threadId;
+            quint64 nsecs, category, file, function;
+            qint64 line;
+            if (!readVarint(q, chunkEnd, &nsecs) || !readVarint(q, chunkEnd, &category)
+                    || !readVarint(q, chunkEnd, &file) || !readVarint(q, chunkEnd, &function)
+                    || !readSignedVarint(q, chunkEnd, &line)) {
+                return fail("Truncated record");
+            }
+            message.nsecsSinceStart = qint64(nsecs);
+            message.category = strings.value(category);
+            message.file = strings.value(file);
+            message.function = strings.value(function);
+            message.line = int(line);
+
+            if (recordType == TextRecord) {
+                quint64 size;
+                QByteArrayView text;
+                if (!readVarint(q, chunkEnd, &size) || !readBytes(q, chunkEnd, qsizetype(size), &text))
+                    return fail("Truncated record");
+                message.text = QString::fromUtf8(text);
+            } else if (recordType == ArgumentsRecord) {
+                quint64 formatId;
+                if (!readVarint(q, chunkEnd, &formatId))
+                    return fail("Truncated record");
+                const auto it = formats.constFind(formatId);
+                if (it == formats.cend())
+                    return fail("Unknown format");
+                if (!Renderer(q, chunkEnd).render(*it, &message.text))
+                    return fail("Truncated record");
+            } else {
+                return fail("Unknown record");
+            }
+            m_messages.append(std::move(message));
+        }
+    }
+
+    sortMessages();
+    return true;
+}
+
+} // namespace QBinaryLogging
+
+QT_END_NAMESPACE
@@ -0,0 +1,192 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QBINARYLOGGING_P_H
+#define QBINARYLOGGING_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of qlogging.cpp and the qtlogdecode tool.  This header file may change
+// from version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qbytearray.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qlogging.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qstring.h>
+
+#include <cstdarg>
+#include <stdio.h>
+
+QT_BEGIN_NAMESPACE
+
+class QIODevice;
+
+// A binary log file starts with the header:
+//   "QTBINLOG", quint8 version, varint pid,
+//   qint64 start time in ms since the epoch, qint64 start time in ns of the
+//   monotonic clock (both little endian)
+// followed by blocks, each starting with its BlockType:
+//   StringBlock, FormatBlock: varint id, varint size, UTF-8 data
+//   ChunkBlock: varint thread ID, varint size, records
+// Each record in a chunk starts with:
+//   quint8 RecordType, quint8 QtMsgType, varint ns since start,
+//   varint category, file and function string IDs, zigzag varint line
+// followed by, for ArgumentsRecord, the varint format ID and the arguments
+// as given by parseFormat(), or for TextRecord the varint size and the
+// UTF-8 text. String ID 0 stands for a null string.
+namespace QBinaryLogging {
+
+constexpr quint8 Version = 1;
+
+enum BlockType : char {
+    StringBlock = 'S',
+    FormatBlock = 'F',
+    ChunkBlock = 'C'
+};
+
+enum RecordType : quint8 {
+    ArgumentsRecord,
+    TextRecord
+};
+
+// How an argument is stored: Signed as zigzag varint, Unsigned and Pointer as
+// varint, Double as 8 bytes little endian, String as varint size + 1 (0 for
+// null) followed by the UTF-8 data, Utf16String as varint size in code units
+// + 1 followed by the little endian data. Each '*' in the width or precision
+// is stored as a Signed argument before the value.
+enum class ArgumentType : quint8 {
+    Signed,
+    Unsigned,
+    Double,
+    String,
+    Utf16String,
+    Pointer
+};
+
+// The C type of the argument, as given by the length modifier
+enum class ArgumentSize : quint8 {
+    Int,
+    Char,
+    Short,
+    Long,
+    LongLong,
+    SizeT,
+    IntMax,
+    PtrDiff,
+    LongDouble
+};
+
+struct Conversion
+{
+    qsizetype begin;    // of the specification in the format, at the '%'
+    qsizetype end;
+    ArgumentType type;
+    ArgumentSize size;
+    quint8 stars;       // '*' in width and precision
+};
+
+// Returns false for formats that can't be recorded, like %n
+Q_CORE_EXPORT bool parseFormat(const char *format, QList<Conversion> *conversions);
+
+class Writer
+{
+public:
+    Writer() = default;
+    ~Writer();
+    Q_DISABLE_COPY_MOVE(Writer)
+
+    bool open(const QString &fileName, qint64 pid, qint64 (*currentThreadId)());
+    void close();
+    bool isOpen() const { return file != nullptr; }
+
+    // Returns false, without taking any arguments, if the format can't be
+    // recorded
+    bool writeArguments(QtMsgType type, const QMessageLogContext &context,
+                        const char *format, va_list ap);
+    void writeText(QtMsgType type, const QMessageLogContext &context, const QString &text);
+    void flush();
+
+    struct ThreadBuffer;
+
+private:
+    friend struct ThreadBufferHandle;
+    struct StringEntry
+    {
+        quint64 id;
+        quint32 generation;     // of the last file that has a definition
+    };
+    struct FormatEntry;
+
+    ThreadBuffer *bufferForCurrentThread();
+    void beginRecord(ThreadBuffer *buffer, RecordType recordType, QtMsgType type,
+                     const QMessageLogContext &context);
+    const FormatEntry *format(ThreadBuffer *buffer, const char *text);
+    quint64 string(ThreadBuffer *buffer, const char *text);
+    void endRecord(ThreadBuffer *buffer, QtMsgType type);
+    void flushLocked(ThreadBuffer *buffer);
+    void releaseBuffer(ThreadBuffer *buffer);
+
+    // Protects the file and the list of buffers. Must not be locked while
+    // holding the mutex of a buffer.
+    QBasicMutex fileMutex;
+    FILE *file = nullptr;
+    qint64 (*threadId)() = nullptr;
+    qint64 startNSecs = 0;
+    QList<ThreadBuffer *> buffers;
+    // Incremented whenever a file is closed, as each file needs its own
+    // definitions of the strings and formats
+    QBasicAtomicInteger<quint32> generation = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+    // Protects the IDs of strings and formats
+    QBasicMutex tableMutex;
+    QHash<QByteArray, StringEntry> strings;
+    QHash<QByteArray, FormatEntry *> formats;
+    quint64 nextId = 1;
+};
+
+class Q_CORE_EXPORT Reader
+{
+public:
+    struct Message
+    {
+        QtMsgType type = QtDebugMsg;
+        qint64 nsecsSinceStart = 0;
+        qint64 threadId = 0;
+        QByteArray category;
+        QByteArray file;
+        QByteArray function;
+        int line = 0;
+        QString text;
+    };
+
+    bool read(QIODevice *device);
+
+    QString errorString() const { return m_errorString; }
+    qint64 pid() const { return m_pid; }
+    qint64 startMSecsSinceEpoch() const { return m_startMSecsSinceEpoch; }
+    qint64 startNSecsSinceReference() const { return m_startNSecsSinceReference; }
+    // sorted by time
+    const QList<Message> &messages() const { return m_messages; }
+
+private:
+    QString m_errorString;
+    qint64 m_pid = 0;
+    qint64 m_startMSecsSinceEpoch = 0;
+    qint64 m_startNSecsSinceReference = 0;
+    QList<Message> m_messages;
+};
+
+} // namespace QBinaryLogging
+
+QT_END_NAMESPACE
+
+#endif // QBINARYLOGGING_P_H
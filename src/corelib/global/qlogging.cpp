@@ -81,6 +81,17 @@ extern char *__progname;
 #  define QLOGGING_HAVE_BACKTRACE
 #endif
 
+#if QT_CONFIG(thread) && defined(Q_COMPILER_THREAD_LOCAL)
+#  include "qsemaphore.h"
+#  include <thread>
+#  define QLOGGING_HAVE_ASYNC_OUTPUT
+#endif
+
+#if !defined(QT_BOOTSTRAPPED) && defined(Q_COMPILER_THREAD_LOCAL)
+#  include "private/qbinarylogging_p.h"
+#  define QLOGGING_HAVE_BINARY_OUTPUT
+#endif
+
 #if defined(Q_OS_LINUX) && (defined(__GLIBC__) || __has_include(<sys/syscall.h>))
 #  include <sys/syscall.h>
 
@@ -169,6 +180,9 @@ Q_NORETURN
 static void qt_message_fatal(QtMsgType, const QMessageLogContext &context, const QString &message);
 static void qt_message_print(QtMsgType, const QMessageLogContext &context, const QString &message);
 static void qt_message_print(const QString &message);
+#ifdef QLOGGING_HAVE_BINARY_OUTPUT
+static bool qt_message_binary(QtMsgType, const QMessageLogContext &context, const char *msg, va_list ap);
+#endif
 
 static int checked_var_value(const char *varname)
 {
@@ -213,6 +227,18 @@ static bool isDefaultCategory(const char *category)
     return !category || strcmp(category, "default") == 0;
 }
 
+#ifndef QT_BOOTSTRAPPED
+static bool isDisabledInDefaultCategory(QtMsgType msgType, const char *category)
+{
+    // qDebug, qWarning, ... macros do not check whether category is enabledgc
+    if (msgType != QtFatalMsg && isDefaultCategory(category)) {
+        if (QLoggingCategory *defaultCategory = QLoggingCategory::defaultCategory())
+            return !defaultCategory->isEnabled(msgType);
+    }
+    return false;
+}
+#endif
+
 /*!
     Returns true if writing to \c stderr is supported.
 
@@ -365,6 +391,10 @@ static inline void convert_to_wchar_t_elided(wchar_t *d, size_t space, const cha
 Q_NEVER_INLINE
 static QString qt_message(QtMsgType msgType, const QMessageLogContext &context, const char *msg, va_list ap)
 {
+#ifdef QLOGGING_HAVE_BINARY_OUTPUT
+    if (msgType != QtFatalMsg && qt_message_binary(msgType, context, msg, ap))
+        return QString();
+#endif
     QString buf = QString::vasprintf(msg, ap);
     qt_message_print(msgType, context, buf);
     return buf;
@@ -1197,6 +1227,26 @@ Q_DECLARE_TYPEINFO(QMessagePattern::BacktraceParams, Q_RELOCATABLE_TYPE);
 
 Q_CONSTINIT QBasicMutex QMessagePattern::mutex;
 
+#ifdef QLOGGING_HAVE_ASYNC_OUTPUT
+// Placeholders of the current pattern that need to be expanded in the
+// thread that logged the message, readable without QMessagePattern::mutex.
+enum MessagePatternFlag {
+    PatternHasBacktrace = 0x1,
+    PatternHasQThreadPtr = 0x2
+};
+Q_CONSTINIT static QBasicAtomicInt messagePatternFlags = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+// Set in the asynchronous output thread to collect the stderr output of a
+// batch of messages, so that it can be written in one go.
+Q_CONSTINIT static thread_local QByteArray *stderrBatch = nullptr;
+#endif
+
+#ifndef QT_BOOTSTRAPPED
+// Set while the asynchronous output thread or QtPrivate::formatLogMessage()
+// formats a message that was logged earlier
+Q_CONSTINIT static thread_local const QMessageLogCapture *currentMessageCapture = nullptr;
+#endif
+
 QMessagePattern::QMessagePattern()
 {
 #ifndef QT_BOOTSTRAPPED
@@ -1358,6 +1408,17 @@ void QMessagePattern::setPattern(const QString &pattern)
 
     literals.reset(new std::unique_ptr<const char[]>[literalsVar.size() + 1]);
     std::move(literalsVar.begin(), literalsVar.end(), &literals[0]);
+
+#ifdef QLOGGING_HAVE_ASYNC_OUTPUT
+    int flags = 0;
+    for (int i = 0; tokens[i]; ++i) {
+        if (tokens[i] == backtraceTokenC)
+            flags |= PatternHasBacktrace;
+        else if (tokens[i] == qthreadptrTokenC)
+            flags |= PatternHasQThreadPtr;
+    }
+    messagePatternFlags.storeRelaxed(flags);
+#endif
 }
 
 #if defined(QLOGGING_HAVE_BACKTRACE) && !defined(QT_BOOTSTRAPPED)
@@ -1613,10 +1674,14 @@ QString qFormatLogMessage(QtMsgType type, const QMessageLogContext &context, con
             message.append(QCoreApplication::applicationName());
         } else if (token == threadidTokenC) {
             // print the TID as decimal
-            message.append(QString::number(qt_gettid()));
+            const qint64 tid = currentMessageCapture ? currentMessageCapture->threadId
+                                                     : qint64(qt_gettid());
+            message.append(QString::number(tid));
         } else if (token == qthreadptrTokenC) {
             message.append("0x"_L1);
-            message.append(QString::number(qlonglong(QThread::currentThread()->currentThread()), 16));
+            QThread *thread = currentMessageCapture ? currentMessageCapture->thread
+                                                    : QThread::currentThread();
+            message.append(QString::number(qlonglong(thread), 16));
 #ifdef QLOGGING_HAVE_BACKTRACE
         } else if (token == backtraceTokenC) {
             QMessagePattern::BacktraceParams backtraceParams = pattern->backtraceArgs.at(backtraceArgsIdx);
@@ -1626,19 +1691,25 @@ QString qFormatLogMessage(QtMsgType type, const QMessageLogContext &context, con
         } else if (token == timeTokenC) {
             QString timeFormat = pattern->timeArgs.at(timeArgsIdx);
             timeArgsIdx++;
+            const QMessageLogCapture *capture = currentMessageCapture;
             if (timeFormat == "process"_L1) {
-                    quint64 ms = pattern->timer.elapsed();
+                    quint64 ms = !capture ? pattern->timer.elapsed()
+                            : capture->msecsSinceStart >= 0 ? capture->msecsSinceStart
+                            : capture->msecsSinceReference - pattern->timer.msecsSinceReference();
                     message.append(QString::asprintf("%6d.%03d", uint(ms / 1000), uint(ms % 1000)));
             } else if (timeFormat == "boot"_L1) {
                 // just print the milliseconds since the elapsed timer reference
                 // like the Linux kernel does
-                qint64 ms = QDeadlineTimer::current().deadline();
+                qint64 ms = capture ? capture->msecsSinceReference : QDeadlineTimer::current().deadline();
                 message.append(QString::asprintf("%6d.%03d", uint(ms / 1000), uint(ms % 1000)));
 #if QT_CONFIG(datestring)
-            } else if (timeFormat.isEmpty()) {
-                    message.append(QDateTime::currentDateTime().toString(Qt::ISODate));
             } else {
-                message.append(QDateTime::currentDateTime().toString(timeFormat));
+                const QDateTime now = capture ? QDateTime::fromMSecsSinceEpoch(capture->msecsSinceEpoch)
+                                              : QDateTime::currentDateTime();
+                if (timeFormat.isEmpty())
+                    message.append(now.toString(Qt::ISODate));
+                else
+                    message.append(now.toString(timeFormat));
 #endif // QT_CONFIG(datestring)
             }
 #endif // !QT_BOOTSTRAPPED
@@ -1921,6 +1992,14 @@ static void stderr_message_handler(QtMsgType type, const QMessageLogContext &con
     if (formattedMessage.isNull())
         return;
 
+#ifdef QLOGGING_HAVE_ASYNC_OUTPUT
+    if (stderrBatch) {
+        stderrBatch->append(formattedMessage.toLocal8Bit());
+        stderrBatch->append('\n');
+        return;
+    }
+#endif
+
     fprintf(stderr, "%s\n", formattedMessage.toLocal8Bit().constData());
     fflush(stderr);
 }
@@ -1984,18 +2063,408 @@ static bool grabMessageHandler() { return true; }
 static void ungrabMessageHandler() { }
 #endif // (Q_COMPILER_THREAD_LOCAL)
 
+#ifdef QLOGGING_HAVE_ASYNC_OUTPUT
+namespace {
+using AsyncMessageOverflow = QtPrivate::AsyncMessageOverflow;
+
+// A message handed over to the asynchronous output thread. The strings of the
+// context are copied, since they need not outlive the call.
+struct AsyncMessage
+{
+    quint64 sequence = 0;
+    QtMsgType type = QtDebugMsg;
+    int line = 0;
+    int functionOffset = -1;    // in strings; -1 if null
+    int categoryOffset = -1;    // ditto
+    bool hasFile = false;
+    QByteArray strings;
+    QString message;
+    QThread *thread = nullptr;
+    qint64 msecsSinceEpoch = 0;
+    qint64 msecsSinceReference = 0;
+};
+
+// Single producer, single consumer queue of the messages logged by one thread.
+class AsyncMessageRing
+{
+public:
+    static constexpr quint32 Capacity = 1024;   // must be a power of 2
+
+    AsyncMessage *beginWrite()
+    {
+        const quint32 t = tail.loadRelaxed();
+        if (t - head.loadAcquire() == Capacity)
+            return nullptr;
+        return &messages[t % Capacity];
+    }
+    void endWrite() { tail.storeRelease(tail.loadRelaxed() + 1); }
+
+    AsyncMessage *front()
+    {
+        const quint32 h = head.loadRelaxed();
+        if (h == tail.loadAcquire())
+            return nullptr;
+        return &messages[h % Capacity];
+    }
+    void pop() { head.storeRelease(head.loadRelaxed() + 1); }
+
+    bool isEmpty() const { return head.loadAcquire() == tail.loadAcquire(); }
+
+    std::unique_ptr<AsyncMessage[]> messages{new AsyncMessage[Capacity]};
+    alignas(64) QBasicAtomicInteger<quint32> head = Q_BASIC_ATOMIC_INITIALIZER(0);
+    alignas(64) QBasicAtomicInteger<quint32> tail = Q_BASIC_ATOMIC_INITIALIZER(0);
+    qint64 threadId = 0;
+    QBasicAtomicInt detached = Q_BASIC_ATOMIC_INITIALIZER(0);   // the thread has exited
+};
+
+class QAsyncMessageSink
+{
+public:
+    QAsyncMessageSink();
+    ~QAsyncMessageSink();
+
+    bool post(QtMsgType type, const QMessageLogContext &context, const QString &message,
+              AsyncMessageOverflow overflow);
+    void flush();
+    quint64 droppedCount() const { return dropped.loadRelaxed(); }
+
+private:
+    AsyncMessageRing *ringForCurrentThread();
+    void run();
+    bool drain();
+    void write(const AsyncMessageRing &ring, const AsyncMessage &message);
+    void wake()
+    {
+        if (sleeping.loadRelaxed() && sleeping.fetchAndStoreOrdered(0))
+            wakeup.release();
+    }
+
+    QBasicMutex ringsMutex;
+    std::vector<std::unique_ptr<AsyncMessageRing>> rings;  // only ever grows
+    QBasicAtomicInteger<quint64> sequence = Q_BASIC_ATOMIC_INITIALIZER(0);
+    QBasicAtomicInteger<quint64> dropped = Q_BASIC_ATOMIC_INITIALIZER(0);
+    quint64 reportedDropped = 0;
+    QBasicAtomicInt sleeping = Q_BASIC_ATOMIC_INITIALIZER(0);
+    QBasicAtomicInt stopping = Q_BASIC_ATOMIC_INITIALIZER(0);
+    QSemaphore wakeup;
+    std::thread thread;
+};
+} // unnamed namespace
+
+Q_GLOBAL_STATIC(QAsyncMessageSink, asyncMessageSink)
+
+// -1 until read from QT_LOGGING_ASYNC, then 0 if disabled or 1 + the overflow policy
+Q_CONSTINIT static QBasicAtomicInt asyncOutputMode = Q_BASIC_ATOMIC_INITIALIZER(-1);
+
+static int asyncMessageOutputMode()
+{
+    int mode = asyncOutputMode.loadRelaxed();
+    if (mode < 0) {
+        const QByteArray value = qgetenv("QT_LOGGING_ASYNC").trimmed().toLower();
+        if (value.isEmpty() || value == "0")
+            mode = 0;
+        else if (value == "drop")
+            mode = 1 + int(AsyncMessageOverflow::Drop);
+        else if (value == "count")
+            mode = 1 + int(AsyncMessageOverflow::Count);
+        else
+            mode = 1 + int(AsyncMessageOverflow::Block);
+        if (!asyncOutputMode.testAndSetRelaxed(-1, mode))
+            mode = asyncOutputMode.loadRelaxed();
+    }
+    return mode;
+}
+
+struct AsyncMessageRingHandle
+{
+    AsyncMessageRing *ring = nullptr;
+    ~AsyncMessageRingHandle()
+    {
+        // the sink owns the ring and hands it to the next thread that logs
+        if (ring && !asyncMessageSink.isDestroyed())
+            ring->detached.storeRelease(1);
+    }
+};
+Q_CONSTINIT static thread_local AsyncMessageRingHandle currentRing;
+
+QAsyncMessageSink::QAsyncMessageSink()
+{
+    // make sure the pattern outlives us, as we format messages until the end
+    qMessagePattern();
+    thread = std::thread([this] { run(); });
+}
+
+QAsyncMessageSink::~QAsyncMessageSink()
+{
+    stopping.storeRelease(1);
+    wakeup.release();
+    thread.join();
+}
+
+AsyncMessageRing *QAsyncMessageSink::ringForCurrentThread()
+{
+    if (currentRing.ring)
+        return currentRing.ring;
+
+    const auto locker = qt_scoped_lock(ringsMutex);
+    AsyncMessageRing *ring = nullptr;
+    for (const auto &r : rings) {
+        if (r->detached.loadAcquire() && r->isEmpty()) {
+            r->detached.storeRelaxed(0);
+            ring = r.get();
+            break;
+        }
+    }
+    if (!ring)
+        ring = rings.emplace_back(std::make_unique<AsyncMessageRing>()).get();
+    ring->threadId = qt_gettid();
+    currentRing.ring = ring;
+    return ring;
+}
+
+bool QAsyncMessageSink::post(QtMsgType type, const QMessageLogContext &context,
+                             const QString &message, AsyncMessageOverflow overflow)
+{
+    AsyncMessageRing *ring = ringForCurrentThread();
+    AsyncMessage *m;
+    while (!(m = ring->beginWrite())) {
+        if (overflow != AsyncMessageOverflow::Block) {
+            dropped.fetchAndAddRelaxed(1);
+            return true;
+        }
+        wake();
+        std::this_thread::yield();
+    }
+
+    m->type = type;
+    m->line = context.line;
+    m->strings.truncate(0);     // keeps the capacity
+    m->hasFile = context.file != nullptr;
+    if (context.file)
+        m->strings.append(context.file, qstrlen(context.file) + 1);
+    m->functionOffset = context.function ? int(m->strings.size()) : -1;
+    if (context.function)
+        m->strings.append(context.function, qstrlen(context.function) + 1);
+    m->categoryOffset = context.category ? int(m->strings.size()) : -1;
+    if (context.category)
+        m->strings.append(context.category, qstrlen(context.category) + 1);
+    m->message = message;
+    m->thread = (messagePatternFlags.loadRelaxed() & PatternHasQThreadPtr)
+            ? QThread::currentThread() : nullptr;
+    m->msecsSinceEpoch = QDateTime::currentMSecsSinceEpoch();
+    m->msecsSinceReference = QDeadlineTimer::current().deadline();
+    m->sequence = sequence.fetchAndAddRelaxed(1);
+    ring->endWrite();
+
+    // pairs with the fence in run(), so that we either see the thread going
+    // to sleep or it sees our message
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    wake();
+    return true;
+}
+
+void QAsyncMessageSink::flush()
+{
+    // wait for everything posted so far, but not for what other threads
+    // post in the meantime
+    QVarLengthArray<std::pair<AsyncMessageRing *, quint32>, 32> targets;
+    {
+        const auto locker = qt_scoped_lock(ringsMutex);
+        for (const auto &ring : rings)
+            targets.append({ring.get(), ring->tail.loadAcquire()});
+    }
+    for (const auto &[ring, tail] : targets) {
+        while (qint32(tail - ring->head.loadAcquire()) > 0) {
+            wakeup.release();
+            std::this_thread::yield();
+        }
+    }
+}
+
+void QAsyncMessageSink::run()
+{
+    // anything logged while writing goes straight to stderr
+    grabMessageHandler();
+
+    for (;;) {
+        if (drain())
+            continue;
+        if (stopping.loadAcquire())
+            break;
+
+        sleeping.storeRelaxed(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!drain())
+            wakeup.tryAcquire(1, 100);
+        sleeping.storeRelaxed(0);
+    }
+}
+
+bool QAsyncMessageSink::drain()
+{
+    QVarLengthArray<AsyncMessageRing *, 32> active;
+    {
+        const auto locker = qt_scoped_lock(ringsMutex);
+        for (const auto &ring : rings) {
+            if (!ring->isEmpty())
+                active.append(ring.get());
+        }
+    }
+
+    const quint64 droppedNow = dropped.loadRelaxed();
+    const bool reportDropped = droppedNow != reportedDropped
+            && asyncOutputMode.loadRelaxed() == 1 + int(AsyncMessageOverflow::Count);
+    if (active.isEmpty() && !reportDropped)
+        return false;
+
+    QByteArray batch;
+    stderrBatch = &batch;
+    const auto writeBatch = [&batch] {
+        fwrite(batch.constData(), 1, batch.size(), stderr);
+        fflush(stderr);
+        batch.truncate(0);
+    };
+
+    // write the messages of all threads in the order they were logged
+    for (;;) {
+        AsyncMessageRing *ring = nullptr;
+        AsyncMessage *next = nullptr;
+        for (AsyncMessageRing *r : std::as_const(active)) {
+            AsyncMessage *m = r->front();
+            if (m && (!next || m->sequence < next->sequence)) {
+                ring = r;
+                next = m;
+            }
+        }
+        if (!next)
+            break;
+
+        write(*ring, *next);
+        next->message = QString();
+        ring->pop();
+        if (batch.size() >= 64 * 1024)
+            writeBatch();
+    }
+
+    if (reportDropped) {
+        const QMessageLogContext context(nullptr, 0, nullptr, "qt.core.logging");
+        qDefaultMessageHandler(QtWarningMsg, context,
+                               QString::asprintf("%llu messages were dropped",
+                                                 droppedNow - reportedDropped));
+        reportedDropped = droppedNow;
+    }
+
+    if (!batch.isEmpty())
+        writeBatch();
+    stderrBatch = nullptr;
+    return true;
+}
+
+void QAsyncMessageSink::write(const AsyncMessageRing &ring, const AsyncMessage &m)
+{
+    const char *strings = m.strings.constData();
+    const QMessageLogContext context(m.hasFile ? strings : nullptr, m.line,
+                                     m.functionOffset < 0 ? nullptr : strings + m.functionOffset,
+                                     m.categoryOffset < 0 ? nullptr : strings + m.categoryOffset);
+    const QMessageLogCapture capture = { ring.threadId, m.thread,
+                                         m.msecsSinceEpoch, m.msecsSinceReference, -1 };
+    currentMessageCapture = &capture;
+    qDefaultMessageHandler(m.type, context, m.message);
+    currentMessageCapture = nullptr;
+}
+
+// Returns true if the message was handed over to the asynchronous output thread.
+static bool postAsyncMessage(QtMsgType type, const QMessageLogContext &context,
+                             const QString &message)
+{
+    const int mode = asyncMessageOutputMode();
+    if (!mode)
+        return false;
+    QAsyncMessageSink *sink = asyncMessageSink();
+    if (!sink)
+        return false;
+
+    // a backtrace can only be taken in the thread that logs; and fatal
+    // messages must be out before we abort
+    if (type == QtFatalMsg || (messagePatternFlags.loadRelaxed() & PatternHasBacktrace)) {
+        sink->flush();
+        return false;
+    }
+    return sink->post(type, context, message, AsyncMessageOverflow(mode - 1));
+}
+#endif // QLOGGING_HAVE_ASYNC_OUTPUT
+
+#ifdef QLOGGING_HAVE_BINARY_OUTPUT
+Q_GLOBAL_STATIC(QBinaryLogging::Writer, binaryMessageWriter)
+
+// Serializes opening and closing the binary output
+Q_CONSTINIT static QBasicMutex binaryOutputMutex;
+// -1 until read from QT_LOGGING_BINARY, then 0 if disabled or 1
+Q_CONSTINIT static QBasicAtomicInt binaryOutputEnabled = Q_BASIC_ATOMIC_INITIALIZER(-1);
+
+static qint64 binaryMessageThreadId()
+{
+    return qint64(qt_gettid());
+}
+
+// Requires binaryOutputMutex
+static bool openBinaryMessageOutput(const QString &fileName)
+{
+    binaryOutputEnabled.storeRelaxed(0);
+    if (fileName.isEmpty()) {
+        if (binaryMessageWriter.exists()) {
+            if (QBinaryLogging::Writer *writer = binaryMessageWriter())
+                writer->close();
+        }
+        return true;
+    }
+    QBinaryLogging::Writer *writer = binaryMessageWriter();
+    if (!writer || !writer->open(fileName, QCoreApplication::applicationPid(), binaryMessageThreadId))
+        return false;
+    binaryOutputEnabled.storeRelaxed(1);
+    return true;
+}
+
+static QBinaryLogging::Writer *binaryMessageOutput()
+{
+    int enabled = binaryOutputEnabled.loadRelaxed();
+    if (Q_UNLIKELY(enabled < 0)) {
+        const auto locker = qt_scoped_lock(binaryOutputMutex);
+        if (binaryOutputEnabled.loadRelaxed() < 0)
+            openBinaryMessageOutput(qEnvironmentVariable("QT_LOGGING_BINARY"));
+        enabled = binaryOutputEnabled.loadRelaxed();
+    }
+    return enabled ? binaryMessageWriter() : nullptr;
+}
+
+// Records the format and the arguments of a message for the default message
+// handler instead of formatting it. Returns true if the message was handled.
+static bool qt_message_binary(QtMsgType msgType, const QMessageLogContext &context,
+                              const char *msg, va_list ap)
+{
+    if (messageHandler.loadAcquire())
+        return false;
+    QBinaryLogging::Writer *writer = binaryMessageOutput();
+    if (!writer)
+        return false;
+    if (isDisabledInDefaultCategory(msgType, context.category))
+        return true;
+
+    va_list copy;
+    va_copy(copy, ap);
+    const bool written = writer->writeArguments(msgType, context, msg, copy);
+    va_end(copy);
+    return written;
+}
+#endif // QLOGGING_HAVE_BINARY_OUTPUT
+
 static void qt_message_print(QtMsgType msgType, const QMessageLogContext &context, const QString &message)
 {
 #ifndef QT_BOOTSTRAPPED
     Q_TRACE(qt_message_print, msgType, context.category, context.function, context.file, context.line, message);
 
-    // qDebug, qWarning, ... macros do not check whether category is enabledgc
-    if (msgType != QtFatalMsg && isDefaultCategory(context.category)) {
-        if (QLoggingCategory *defaultCategory = QLoggingCategory::defaultCategory()) {
-            if (!defaultCategory->isEnabled(msgType))
-                return;
-        }
-    }
+    if (isDisabledInDefaultCategory(msgType, context.category))
+        return;
 #endif
 
     // prevent recursion in case the message handler generates messages
@@ -2003,6 +2472,21 @@ static void qt_message_print(QtMsgType msgType, const QMessageLogContext &contex
     if (grabMessageHandler()) {
         const auto ungrab = qScopeGuard([]{ ungrabMessageHandler(); });
         auto msgHandler = messageHandler.loadAcquire();
+#ifdef QLOGGING_HAVE_BINARY_OUTPUT
+        if (!msgHandler) {
+            if (QBinaryLogging::Writer *writer = binaryMessageOutput()) {
+                writer->writeText(msgType, context, message);
+                if (msgType != QtFatalMsg)
+                    return;
+                // keep it in the log, but also tell the user why we abort
+                writer->flush();
+            }
+        }
+#endif
+#ifdef QLOGGING_HAVE_ASYNC_OUTPUT
+        if (!msgHandler && postAsyncMessage(msgType, context, message))
+            return;
+#endif
         (msgHandler ? msgHandler : qDefaultMessageHandler)(msgType, context, message);
     } else {
         fprintf(stderr, "%s\n", message.toLocal8Bit().constData());
@@ -2049,6 +2533,124 @@ static void qt_message_fatal(QtMsgType, const QMessageLogContext &context, const
 }
 
 
+namespace QtPrivate {
+
+/*!
+    \internal
+
+    Enables or disables the asynchronous output of the default message
+    handler, as the QT_LOGGING_ASYNC environment variable does at startup.
+
+    When enabled, messages logged while no custom message handler is installed
+    are queued and a dedicated thread formats and writes them, so that the
+    logging thread does not wait for either. Messages of one thread are
+    written in order; \a overflow decides what happens when a thread logs
+    faster than they can be written. Fatal messages, and all messages if the
+    message pattern contains a backtrace, are written synchronously after the
+    queued ones.
+*/
+void setAsyncMessageOutput(bool enable, AsyncMessageOverflow overflow)
+{
+#ifdef QLOGGING_HAVE_ASYNC_OUTPUT
+    asyncOutputMode.storeRelaxed(enable ? 1 + int(overflow) : 0);
+    if (!enable)
+        flushAsyncMessageOutput();
+#else
+    Q_UNUSED(enable);
+    Q_UNUSED(overflow);
+#endif
+}
+
+/*!
+    \internal
+
+    Waits until the messages queued for asynchronous output so far have been
+    written.
+*/
+void flushAsyncMessageOutput()
+{
+#ifdef QLOGGING_HAVE_ASYNC_OUTPUT
+    if (asyncMessageSink.exists()) {
+        if (QAsyncMessageSink *sink = asyncMessageSink())
+            sink->flush();
+    }
+#endif
+}
+
+/*!
+    \internal
+
+    Makes the default message handler write messages to the binary log
+    \a fileName, instead of formatting them, as the QT_LOGGING_BINARY
+    environment variable does at startup. An empty \a fileName ends the
+    binary output. Returns false if the file can't be opened.
+
+    Messages logged with a format, like \c{qDebug("%d", value)}, are
+    recorded as the format and its arguments; other messages are recorded as
+    text. The qtlogdecode tool formats the messages of a binary log according
+    to the message pattern.
+*/
+bool setBinaryMessageOutput(const QString &fileName)
+{
+#ifdef QLOGGING_HAVE_BINARY_OUTPUT
+    const auto locker = qt_scoped_lock(binaryOutputMutex);
+    return openBinaryMessageOutput(fileName);
+#else
+    return fileName.isEmpty();
+#endif
+}
+
+/*!
+    \internal
+
+    Writes the messages recorded in the binary log so far to the file.
+*/
+void flushBinaryMessageOutput()
+{
+#ifdef QLOGGING_HAVE_BINARY_OUTPUT
+    if (binaryMessageWriter.exists()) {
+        if (QBinaryLogging::Writer *writer = binaryMessageWriter())
+            writer->flush();
+    }
+#endif
+}
+
+#ifndef QT_BOOTSTRAPPED
+/*!
+    \internal
+
+    Formats the message \a message of type \a type with the context
+    \a context according to the message pattern, like qFormatLogMessage(),
+    using the thread and time recorded in \a capture.
+*/
+QString formatLogMessage(QtMsgType type, const QMessageLogContext &context,
+                         const QString &message, const QMessageLogCapture &capture)
+{
+    currentMessageCapture = &capture;
+    const auto reset = qScopeGuard([] { currentMessageCapture = nullptr; });
+    return qFormatLogMessage(type, context, message);
+}
+#endif
+
+/*!
+    \internal
+
+    Returns the number of messages that were dropped because the queue of
+    the thread logging them was full.
+*/
+quint64 droppedAsyncMessageCount()
+{
+#ifdef QLOGGING_HAVE_ASYNC_OUTPUT
+    if (asyncMessageSink.exists()) {
+        if (QAsyncMessageSink *sink = asyncMessageSink())
+            return sink->droppedCount();
+    }
+#endif
+    return 0;
+}
+
+} // namespace QtPrivate
+
 /*!
     \internal
 */
@@ -2124,6 +2726,19 @@ void qErrnoWarning(int code, const char *msg, ...)
     application aborts immediately after handling that message. Custom
     message handlers should not attempt to exit an application on their own.
 
+    Setting the \c QT_LOGGING_ASYNC environment variable to \c 1 makes the
+    default message handler write messages from a dedicated thread, so that
+    logging does not block the calling thread on formatting and output. If a
+    thread logs faster than messages can be written, it waits; set the variable
+    to \c drop to drop such messages instead, or to \c count to also report
+    the number of dropped messages.
+
+    Setting the \c QT_LOGGING_BINARY environment variable to a file name makes
+    the default message handler write messages to that file in a compact
+    binary form instead. Messages logged with a format string are stored as
+    the format and its arguments, without being formatted; the \c qtlogdecode
+    tool turns the file into text according to the message pattern.
+
     Only one message handler can be defined, since this is usually
     done on an application-wide basis to control debug output.
 
@@ -2213,6 +2828,7 @@ void qErrnoWarning(int code, const char *msg, ...)
 
 QtMessageHandler qInstallMessageHandler(QtMessageHandler h)
 {
+    QtPrivate::flushAsyncMessageOutput();
     const auto old = messageHandler.fetchAndStoreOrdered(h);
     if (old)
         return old;
@@ -2222,6 +2838,9 @@ QtMessageHandler qInstallMessageHandler(QtMessageHandler h)
 
 void qSetMessagePattern(const QString &pattern)
 {
+    // messages already logged are still formatted with the old pattern
+    QtPrivate::flushAsyncMessageOutput();
+
     const auto locker = qt_scoped_lock(QMessagePattern::mutex);
 
     if (!qMessagePattern()->fromEnvironment)
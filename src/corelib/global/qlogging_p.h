@@ -16,13 +16,45 @@
 //
 
 #include <QtCore/private/qglobal_p.h>
+#include <QtCore/qlogging.h>
+#include <QtCore/qstring.h>
 
 QT_BEGIN_NAMESPACE
 
+class QThread;
+
+// What qFormatLogMessage() would otherwise query about the current thread and
+// time, for messages that are formatted after they were logged
+struct QMessageLogCapture
+{
+    qint64 threadId;
+    QThread *thread;
+    qint64 msecsSinceEpoch;
+    qint64 msecsSinceReference;
+    qint64 msecsSinceStart;     // or -1 to derive it from msecsSinceReference
+};
+
 namespace QtPrivate {
 
 Q_CORE_EXPORT bool shouldLogToStderr();
 
+enum class AsyncMessageOverflow {
+    Block,      // wait until there is room in the queue
+    Drop,       // drop the message
+    Count       // drop the message and report the number of dropped ones
+};
+
+Q_CORE_EXPORT void setAsyncMessageOutput(bool enable,
+                                         AsyncMessageOverflow overflow = AsyncMessageOverflow::Block);
+Q_CORE_EXPORT void flushAsyncMessageOutput();
+Q_CORE_EXPORT quint64 droppedAsyncMessageCount();
+
+Q_CORE_EXPORT bool setBinaryMessageOutput(const QString &fileName);
+Q_CORE_EXPORT void flushBinaryMessageOutput();
+
+Q_CORE_EXPORT QString formatLogMessage(QtMsgType type, const QMessageLogContext &context,
+                                       const QString &message, const QMessageLogCapture &capture);
+
 }
 
 QT_END_NAMESPACE
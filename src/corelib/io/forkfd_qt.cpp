@@ -1,12 +1,31 @@
 // Copyright (C) 2016 Intel Corporation.
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
-#include <QtCore/qglobal.h>
+#include <QtCore/private/qglobal_p.h>
 
-#define FORKFD_NO_SPAWNFD
 #if defined(QT_NO_DEBUG) && !defined(NDEBUG)
 #  define NDEBUG
 #endif
 
 #include <forkfd.h>
 #include "../../3rdparty/forkfd/forkfd.c"
+
+#if _POSIX_SPAWN > 0
+QT_BEGIN_NAMESPACE
+
+// Returns true if vforkfd() would have to fork() the whole process and
+// spawnfd() can start children instead
+bool qt_forkfd_prefer_spawnfd()
+{
+#if defined(__FreeBSD__) && __FreeBSD__ >= 9
+    // spawnfd() is only for systems without a system forkfd
+    return false;
+#elif defined(__linux__) && QT_CONFIG(forkfd_pidfd)
+    return system_forkfd_availability() < 0;
+#else
+    return true;
+#endif
+}
+
+QT_END_NAMESPACE
+#endif // _POSIX_SPAWN
@@ -803,6 +803,45 @@ bool QAbstractFileEngine::unmap(uchar *address)
     return extension(UnMapExtension, &options);
 }
 
+/*!
+    \since 6.6
+
+    Writes \a count buffers starting at \a data to the file, in order.
+    Returns the number of bytes written, or -1 if an error occurred.
+
+    This function bases its behavior on calling extension() with
+    WriteVectoredExtensionOption, which lets the engine pass all buffers to
+    the operating system at once. If the engine does not support this
+    extension, write() is called for each buffer instead.
+
+    \sa write(), supportsExtension()
+*/
+qint64 QAbstractFileEngine::writeVectored(const QByteArrayView *data, qsizetype count)
+{
+    if (supportsExtension(WriteVectoredExtension)) {
+        WriteVectoredExtensionOption option;
+        option.data = data;
+        option.count = count;
+        WriteVectoredExtensionReturn r;
+        if (extension(WriteVectoredExtension, &option, &r))
+            return r.written;
+        return -1;
+    }
+
+    qint64 written = 0;
+    for (qsizetype i = 0; i < count; ++i) {
+        if (data[i].isEmpty())
+            continue;
+        const qint64 ret = write(data[i].data(), data[i].size());
+        if (ret < 0)
+            return written ? written : ret;
+        written += ret;
+        if (ret < data[i].size())
+            break;
+    }
+    return written;
+}
+
 /*!
     \since 5.10
 
@@ -1148,6 +1187,10 @@ qint64 QAbstractFileEngine::readLine(char *data, qint64 maxlen)
 
    \value UnMapExtension Whether the file engine provides the ability to
    unmap memory that was previously mapped.
+
+   \value WriteVectoredExtension Whether the file engine can write several
+   buffers with a single gathering system call. This value was added in
+   Qt 6.6.
 */
 
 /*!
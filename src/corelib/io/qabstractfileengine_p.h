@@ -124,6 +124,7 @@ public:
     bool atEnd() const;
     uchar *map(qint64 offset, qint64 size, QFile::MemoryMapFlags flags);
     bool unmap(uchar *ptr);
+    qint64 writeVectored(const QByteArrayView *data, qsizetype count);
 
     typedef QAbstractFileEngineIterator Iterator;
     virtual Iterator *beginEntryList(QDir::Filters filters, const QStringList &filterNames);
@@ -140,7 +141,8 @@ public:
         AtEndExtension,
         FastReadLineExtension,
         MapExtension,
-        UnMapExtension
+        UnMapExtension,
+        WriteVectoredExtension
     };
     class ExtensionOption
     {};
@@ -163,6 +165,16 @@ public:
         uchar *address;
     };
 
+    class WriteVectoredExtensionOption : public ExtensionOption {
+    public:
+        const QByteArrayView *data;
+        qsizetype count;
+    };
+    class WriteVectoredExtensionReturn : public ExtensionReturn {
+    public:
+        qint64 written;
+    };
+
     virtual bool extension(Extension extension, const ExtensionOption *option = nullptr, ExtensionReturn *output = nullptr);
     virtual bool supportsExtension(Extension extension) const;
 
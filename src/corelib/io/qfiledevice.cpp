@@ -545,6 +545,62 @@ qint64 QFileDevice::writeData(const char *data, qint64 len)
     return len;
 }
 
+/*!
+    \internal
+
+    Appends the buffers to the write buffer if they fit. Otherwise, the
+    pending buffered data and all of the new buffers are handed to the file
+    engine in one vectored write, instead of flushing first and writing each
+    buffer separately.
+*/
+qint64 QFileDevicePrivate::writeVectored(const QByteArrayView *data, qsizetype count)
+{
+    Q_Q(QFileDevice);
+    qint64 len = 0;
+    for (qsizetype i = 0; i < count; ++i)
+        len += data[i].size();
+
+    const bool buffered = !(openMode & QIODevice::Unbuffered);
+    if ((buffered && writeBuffer.size() + len <= writeBufferChunkSize)
+        || (openMode & QIODevice::Text)
+        || !fileEngine->supportsExtension(QAbstractFileEngine::WriteVectoredExtension)) {
+        return QIODevicePrivate::writeVectored(data, count);
+    }
+
+    q->unsetError();
+    lastWasWrite = true;
+
+    QVarLengthArray<QByteArrayView, 16> buffers;
+    const qint64 pending = writeBuffer.size();
+    for (qint64 pos = 0; pos < pending; ) {
+        qint64 size;
+        const char *ptr = writeBuffer.readPointerAtPosition(pos, size);
+        buffers.append(QByteArrayView(ptr, size));
+        pos += size;
+    }
+    buffers.append(data, count);
+
+    const qint64 ret = fileEngine->writeVectored(buffers.constData(), buffers.size());
+    if (ret > 0)
+        writeBuffer.free(qMin(ret, pending));
+    if (ret < pending + len) {
+        QFileDevice::FileError err = fileEngine->error();
+        if (err == QFileDevice::UnspecifiedError)
+            err = QFileDevice::WriteError;
+        setError(err, fileEngine->errorString());
+        if (ret <= pending)
+            return -1;
+    }
+
+    const qint64 written = ret - pending;
+    if (!isSequential()) {
+        pos += written;
+        devicePos += written;
+        buffer.skip(written);
+    }
+    return written;
+}
+
 /*!
     Returns the file error status.
 
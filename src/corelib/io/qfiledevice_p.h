@@ -50,6 +50,7 @@ protected:
     inline bool ensureFlushed() const;
 
     bool putCharHelper(char c) override;
+    qint64 writeVectored(const QByteArrayView *data, qsizetype count) override;
 
     void setError(QFileDevice::FileError err);
     void setError(QFileDevice::FileError err, const QString &errorString);
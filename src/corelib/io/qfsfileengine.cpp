@@ -856,6 +856,16 @@ bool QFSFileEngine::extension(Extension extension, const ExtensionOption *option
         const UnMapExtensionOption *options = (const UnMapExtensionOption*)option;
         return d->unmap(options->address);
     }
+#ifndef Q_OS_WIN
+    if (extension == WriteVectoredExtension && !d->fh && d->fd != -1) {
+        const WriteVectoredExtensionOption *options =
+                static_cast<const WriteVectoredExtensionOption *>(option);
+        WriteVectoredExtensionReturn *returnValue =
+                static_cast<WriteVectoredExtensionReturn *>(output);
+        returnValue->written = d->writeVectoredFd(options->data, options->count);
+        return returnValue->written >= 0;
+    }
+#endif
 
     return false;
 }
@@ -874,6 +884,10 @@ bool QFSFileEngine::supportsExtension(Extension extension) const
         return true;
     if (extension == UnMapExtension || extension == MapExtension)
         return true;
+#ifndef Q_OS_WIN
+    if (extension == WriteVectoredExtension && !d->fh && d->fd != -1)
+        return true;
+#endif
     return false;
 }
 
@@ -150,6 +150,7 @@ public:
     bool nativeIsSequential() const;
 #ifndef Q_OS_WIN
     bool isSequentialFdFh() const;
+    qint64 writeVectoredFd(const QByteArrayView *data, qsizetype count);
 #endif
 
     uchar *map(qint64 offset, qint64 size, QFile::MemoryMapFlags flags);
@@ -18,6 +18,7 @@
 #include "qvarlengtharray.h"
 
 #include <sys/mman.h>
+#include <sys/uio.h>
 #include <stdlib.h>
 #include <limits.h>
 #include <errno.h>
@@ -278,6 +279,71 @@ bool QFSFileEnginePrivate::nativeIsSequential() const
     return isSequentialFdFh();
 }
 
+/*!
+    \internal
+
+    Writes \a count buffers starting at \a data to the unbuffered file
+    descriptor using writev(), retrying on short writes until everything
+    has been written or an error occurs.
+*/
+qint64 QFSFileEnginePrivate::writeVectoredFd(const QByteArrayView *data, qsizetype count)
+{
+    Q_Q(QFSFileEngine);
+    Q_ASSERT(!fh && fd != -1);
+
+    QVarLengthArray<struct iovec, 16> vec;
+    vec.reserve(count);
+    for (qsizetype i = 0; i < count; ++i) {
+        if (data[i].isEmpty())
+            continue;
+        struct iovec v;
+        v.iov_base = const_cast<char *>(data[i].data());
+        v.iov_len = size_t(data[i].size());
+        vec.append(v);
+    }
+    if (vec.isEmpty())
+        return 0;
+
+    qint64 writtenBytes = 0;
+    struct iovec *iov = vec.data();
+    qsizetype remaining = vec.size();
+    while (remaining > 0) {
+#ifdef IOV_MAX
+        const int iovcnt = int(qMin(remaining, qsizetype(IOV_MAX)));
+#else
+        const int iovcnt = int(remaining);
+#endif
+        ssize_t result;
+        EINTR_LOOP(result, ::writev(fd, iov, iovcnt));
+        if (result <= 0)
+            break;
+        writtenBytes += result;
+
+        // Drop the buffers that were written completely and adjust the one
+        // that was written partially, if any.
+        size_t done = size_t(result);
+        while (remaining > 0 && done >= iov->iov_len) {
+            done -= iov->iov_len;
+            ++iov;
+            --remaining;
+        }
+        if (done) {
+            iov->iov_base = static_cast<char *>(iov->iov_base) + done;
+            iov->iov_len -= done;
+        }
+    }
+
+    if (writtenBytes == 0) {
+        writtenBytes = -1;
+        q->setError(errno == ENOSPC ? QFile::ResourceError : QFile::WriteError, QSystemError::stdString());
+    } else {
+        // reset the cached size, if any
+        metaData.clearFlags(QFileSystemMetaData::SizeAttribute);
+    }
+
+    return writtenBytes;
+}
+
 bool QFSFileEngine::link(const QString &newName)
 {
     Q_D(QFSFileEngine);
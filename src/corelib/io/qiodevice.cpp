@@ -1445,37 +1445,102 @@ QByteArray QIODevice::readLine(qint64 maxSize)
     QByteArray result;
     CHECK_READABLE(readLine, result);
 
+    if (maxSize != 0) {
+        CHECK_LINEMAXLEN(readLine, result);
+        CHECK_MAXBYTEARRAYSIZE(readLine);
+    }
+
+    if (d->readLine(&result, maxSize) <= 0)
+        result.clear();
+    result.squeeze();
+    return result;
+}
+
+/*!
+    \since 6.6
+
+    Reads a line from the device, but no more than \a maxSize characters,
+    and stores it in \a line. If \a maxSize is 0, the line can be of any
+    length. The newline character ('\\n') is kept, as with readLine().
+
+    Unlike readLine(), this function reuses the memory already allocated
+    by \a line: once \a line has grown to hold the longest line, reading
+    further lines does not allocate memory, as long as \a line is not
+    shared with another QByteArray. This makes the following loop suitable
+    for processing large amounts of line-oriented data:
+
+    \code
+    QByteArray line;
+    while (device->readLineInto(&line))
+        process(QByteArrayView(line));
+    \endcode
+
+    Returns \c false if no data could be read, which can mean either that
+    no data was currently available or that an error occurred; otherwise
+    returns \c true. The previous contents of \a line are discarded in any
+    case.
+
+    \sa readLine(), canReadLine()
+*/
+bool QIODevice::readLineInto(QByteArray *line, qint64 maxSize)
+{
+    Q_D(QIODevice);
+    Q_ASSERT(line);
+#if defined QIODEVICE_DEBUG
+    printf("%p QIODevice::readLineInto(%p, %lld), d->pos = %lld, d->buffer.size() = %lld\n",
+           this, line, maxSize, d->pos, d->buffer.size());
+#endif
+
+    if (!line->isNull())
+        line->resize(0);
+    CHECK_READABLE(readLineInto, false);
+
+    if (maxSize != 0) {
+        CHECK_LINEMAXLEN(readLineInto, false);
+        CHECK_MAXBYTEARRAYSIZE(readLineInto);
+    }
+
+    return d->readLine(line, maxSize) > 0;
+}
+
+/*!
+    \internal
+
+    Reads a line of at most \a maxSize bytes into \a result, or a line of
+    any length if \a maxSize is 0. The size of \a result is set to the
+    number of bytes read; its capacity is never reduced. Returns the number
+    of bytes read, or -1 on error.
+*/
+qint64 QIODevicePrivate::readLine(QByteArray *result, qint64 maxSize)
+{
     qint64 readBytes = 0;
     if (maxSize == 0) {
         // Size is unknown, read incrementally.
         maxSize = MaxByteArraySize - 1;
 
-        // The first iteration needs to leave an extra byte for the terminating null
-        result.resize(1);
+        // The first iteration needs to leave an extra byte for the terminating null.
+        // Start with whatever capacity the array already has, so that reading
+        // into a reused array does not reallocate.
+        const qint64 chunk = buffer.chunkSize();
+        result->resize(qsizetype(qMin(maxSize, qMax(qint64(result->capacity()), chunk + 1))));
 
         qint64 readResult;
         do {
-            result.resize(qsizetype(qMin(maxSize, qint64(result.size() + d->buffer.chunkSize()))));
-            readResult = d->readLine(result.data() + readBytes, result.size() - readBytes);
+            if (readBytes > 0)
+                result->resize(qsizetype(qMin(maxSize, qint64(result->size()) + chunk)));
+            readResult = readLine(result->data() + readBytes, result->size() - readBytes);
             if (readResult > 0 || readBytes == 0)
                 readBytes += readResult;
-        } while (readResult == d->buffer.chunkSize()
-                && result[qsizetype(readBytes - 1)] != '\n');
+        } while (readResult == result->size() - (readBytes - readResult) - 1
+                 && result->at(qsizetype(readBytes - 1)) != '\n'
+                 && result->size() < maxSize);
     } else {
-        CHECK_LINEMAXLEN(readLine, result);
-        CHECK_MAXBYTEARRAYSIZE(readLine);
-
-        result.resize(maxSize);
-        readBytes = d->readLine(result.data(), result.size());
+        result->resize(qsizetype(maxSize));
+        readBytes = readLine(result->data(), result->size());
     }
 
-    if (readBytes <= 0)
-        result.clear();
-    else
-        result.resize(readBytes);
-
-    result.squeeze();
-    return result;
+    result->resize(qsizetype(qMax(readBytes, qint64(0))));
+    return readBytes;
 }
 
 /*!
@@ -1754,6 +1819,76 @@ qint64 QIODevice::write(const QByteArray &data)
     return ret;
 }
 
+/*!
+    \fn qint64 QIODevice::write(std::initializer_list<QByteArrayView> data)
+    \since 6.6
+    \overload
+
+    Writes the contents of all buffers in \a data to the device, in order, as
+    if they formed one contiguous block. Returns the number of bytes that were
+    actually written, or -1 if an error occurred.
+
+    Devices that support it hand all buffers to the operating system in a
+    single gathering call (such as \c writev() or \c sendmsg()) instead of
+    issuing one write per buffer, which avoids concatenating small pieces
+    such as protocol headers and payloads before writing them.
+
+    \sa read(), writeData()
+*/
+
+/*!
+    \fn qint64 QIODevice::write(const QList<QByteArrayView> &data)
+    \since 6.6
+    \overload
+
+    Writes the contents of all buffers in \a data to the device, in order, as
+    if they formed one contiguous block. Returns the number of bytes that were
+    actually written, or -1 if an error occurred.
+
+    \sa read(), writeData()
+*/
+
+/*!
+    \internal
+*/
+qint64 QIODevice::writeVectored(const QByteArrayView *data, qsizetype count)
+{
+    Q_D(QIODevice);
+    CHECK_WRITABLE(write, qint64(-1));
+
+    // Make sure the device is positioned correctly.
+    if (d->pos != d->devicePos && !d->isSequential() && !seek(d->pos))
+        return qint64(-1);
+
+    return d->writeVectored(data, count);
+}
+
+/*!
+    \internal
+
+    Writes \a count buffers starting at \a data to the device and advances
+    the position like QIODevice::write() does. Subclasses that can pass
+    several buffers to the operating system at once reimplement this
+    function. The default implementation calls QIODevice::write() for each
+    buffer and stops at the first short write.
+*/
+qint64 QIODevicePrivate::writeVectored(const QByteArrayView *data, qsizetype count)
+{
+    Q_Q(QIODevice);
+    qint64 written = 0;
+    for (qsizetype i = 0; i < count; ++i) {
+        if (data[i].isEmpty())
+            continue;
+        const qint64 ret = q->write(data[i].data(), data[i].size());
+        if (ret < 0)
+            return written ? written : ret;
+        written += ret;
+        if (ret < data[i].size())
+            break;
+    }
+    return written;
+}
+
 /*!
     \internal
 */
@@ -12,8 +12,11 @@
 #include <QtCore/qobjectdefs.h>
 #include <QtCore/qscopedpointer.h>
 #endif
+#include <QtCore/qlist.h>
 #include <QtCore/qstring.h>
 
+#include <initializer_list>
+
 #ifdef open
 #error qiodevice.h must be included before any header file that defines open
 #endif
@@ -78,6 +81,7 @@ public:
     QByteArray readAll();
     qint64 readLine(char *data, qint64 maxlen);
     QByteArray readLine(qint64 maxlen = 0);
+    bool readLineInto(QByteArray *line, qint64 maxlen = 0);
     virtual bool canReadLine() const;
 
     void startTransaction();
@@ -88,6 +92,10 @@ public:
     qint64 write(const char *data, qint64 len);
     qint64 write(const char *data);
     qint64 write(const QByteArray &data);
+    qint64 write(std::initializer_list<QByteArrayView> data)
+    { return writeVectored(data.begin(), qsizetype(data.size())); }
+    qint64 write(const QList<QByteArrayView> &data)
+    { return writeVectored(data.constData(), data.size()); }
 
     qint64 peek(char *data, qint64 maxlen);
     QByteArray peek(qint64 maxlen);
@@ -132,6 +140,8 @@ protected:
 #endif
 
 private:
+    qint64 writeVectored(const QByteArrayView *data, qsizetype count);
+
     Q_DECLARE_PRIVATE(QIODevice)
     Q_DISABLE_COPY(QIODevice)
 };
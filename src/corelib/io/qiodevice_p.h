@@ -146,10 +146,12 @@ public:
 
     qint64 read(char *data, qint64 maxSize, bool peeking = false);
     qint64 readLine(char *data, qint64 maxSize);
+    qint64 readLine(QByteArray *result, qint64 maxSize);
     virtual qint64 peek(char *data, qint64 maxSize);
     virtual QByteArray peek(qint64 maxSize);
     qint64 skipByReading(qint64 maxSize);
     void write(const char *data, qint64 size);
+    virtual qint64 writeVectored(const QByteArrayView *data, qsizetype count);
 
     inline bool isWriteChunkCached(const char *data, qint64 size) const
     {
@@ -307,6 +307,9 @@ public:
 #if defined(Q_OS_UNIX)
     void commitChannels() const;
     void execChild(const char *workingDirectory, char **argv, char **envp) const;
+    bool canSpawnChild(const char *workingDirectory) const;
+    int spawnChild(const char *workingDirectory, char **argv, char **envp, qint64 *pid,
+                   QString *errorMessage) const;
 #endif
     bool processStarted(QString *errorMessage = nullptr);
     void processFinished();
@@ -13,9 +13,11 @@
 #include "qstandardpaths.h"
 #include "private/qcore_unix_p.h"
 #include "private/qlocking_p.h"
+#include "qscopeguard.h"
 
 #ifdef Q_OS_DARWIN
 #include <private/qcore_mac_p.h>
+#include <crt_externs.h>
 #endif
 
 #include <private/qcoreapplication_p.h>
@@ -39,6 +41,9 @@
 
 #if QT_CONFIG(process)
 #include <forkfd.h>
+#  if _POSIX_SPAWN > 0
+#    define QPROCESS_HAVE_SPAWN
+#  endif
 #endif
 
 QT_BEGIN_NAMESPACE
@@ -72,6 +77,20 @@ QProcessEnvironment QProcessEnvironment::systemEnvironment()
 
 #if QT_CONFIG(process)
 
+#ifdef QPROCESS_HAVE_SPAWN
+// in forkfd_qt.cpp
+bool qt_forkfd_prefer_spawnfd();
+
+static char **systemEnvironment()
+{
+#ifdef Q_OS_DARWIN
+    return *_NSGetEnviron();
+#else
+    return environ;
+#endif
+}
+#endif
+
 namespace {
 struct AutoPipe
 {
@@ -456,39 +475,57 @@ void QProcessPrivate::startProcess()
         workingDirPtr = encodedWorkingDirectory.constData();
     }
 
-    // Start the child.
-    auto execChild1 = [this, workingDirPtr, &argv, &envp]() {
-        execChild(workingDirPtr, argv.pointers.get(), envp.pointers.get());
-    };
-    auto execChild2 = [](void *lambda) {
-        static_cast<decltype(execChild1) *>(lambda)->operator()();
-        return -1;
-    };
+#ifdef QPROCESS_HAVE_SPAWN
+    if (canSpawnChild(workingDirPtr)) {
+        QString errorMessage;
+        forkfd = spawnChild(workingDirPtr, argv.pointers.get(), envp.pointers.get(), &pid,
+                            &errorMessage);
+        if (forkfd == -1) {
+#if defined (QPROCESS_DEBUG)
+            qDebug("spawn failed: %ls", qUtf16Printable(errorMessage));
+#endif
+            q->setProcessState(QProcess::NotRunning);
+            setErrorAndEmit(QProcess::FailedToStart, errorMessage);
+            cleanup();
+            return;
+        }
+    } else
+#endif
+    {
+        // Start the child.
+        auto execChild1 = [this, workingDirPtr, &argv, &envp]() {
+            execChild(workingDirPtr, argv.pointers.get(), envp.pointers.get());
+        };
+        auto execChild2 = [](void *lambda) {
+            static_cast<decltype(execChild1) *>(lambda)->operator()();
+            return -1;
+        };
 
-    int ffdflags = FFD_CLOEXEC;
+        int ffdflags = FFD_CLOEXEC;
 
-    // QTBUG-86285
+        // QTBUG-86285
 #if defined(Q_OS_LINUX) && !QT_CONFIG(forkfd_pidfd)
-    ffdflags |= FFD_USE_FORK;
+        ffdflags |= FFD_USE_FORK;
 #endif
 
-    pid_t childPid;
-    forkfd = ::vforkfd(ffdflags , &childPid, execChild2, &execChild1);
-    int lastForkErrno = errno;
+        pid_t childPid;
+        forkfd = ::vforkfd(ffdflags , &childPid, execChild2, &execChild1);
+        int lastForkErrno = errno;
 
-    if (forkfd == -1) {
-        // Cleanup, report error and return
+        if (forkfd == -1) {
+            // Cleanup, report error and return
 #if defined (QPROCESS_DEBUG)
-        qDebug("fork failed: %ls", qUtf16Printable(qt_error_string(lastForkErrno)));
+            qDebug("fork failed: %ls", qUtf16Printable(qt_error_string(lastForkErrno)));
 #endif
-        q->setProcessState(QProcess::NotRunning);
-        setErrorAndEmit(QProcess::FailedToStart,
-                        QProcess::tr("Resource error (fork failure): %1").arg(qt_error_string(lastForkErrno)));
-        cleanup();
-        return;
-    }
+            q->setProcessState(QProcess::NotRunning);
+            setErrorAndEmit(QProcess::FailedToStart,
+                            QProcess::tr("Resource error (fork failure): %1").arg(qt_error_string(lastForkErrno)));
+            cleanup();
+            return;
+        }
 
-    pid = qint64(childPid);
+        pid = qint64(childPid);
+    }
     Q_ASSERT(pid > 0);
 
     // parent
@@ -567,6 +604,107 @@ report_errno:
     qt_safe_write(childStartedPipe[1], &error, sizeof(error));
 }
 
+/*!
+    \internal
+
+    Returns true if the child can be started with posix_spawn() instead of
+    execChild(). That is only the case if vforkfd() would otherwise have to
+    fork() the whole parent process, which takes longer the more memory it
+    has mapped, and nothing needs to run in the child before it execs.
+*/
+bool QProcessPrivate::canSpawnChild(const char *workingDirectory) const
+{
+#ifdef QPROCESS_HAVE_SPAWN
+    if (childProcessModifier)
+        return false;
+#  if defined(__GLIBC__) && __GLIBC_PREREQ(2, 29)
+    Q_UNUSED(workingDirectory);
+#  else
+    // no posix_spawn_file_actions_addchdir_np()
+    if (workingDirectory)
+        return false;
+#  endif
+    return qt_forkfd_prefer_spawnfd();
+#else
+    Q_UNUSED(workingDirectory);
+    return false;
+#endif
+}
+
+/*!
+    \internal
+
+    Starts the child with posix_spawn(), setting it up the way execChild()
+    does. Returns the forkfd of the child and sets \a pid, or returns -1 and
+    sets \a errorMessage.
+*/
+int QProcessPrivate::spawnChild(const char *workingDirectory, char **argv, char **envp,
+                                qint64 *pid, QString *errorMessage) const
+{
+#ifdef QPROCESS_HAVE_SPAWN
+    posix_spawn_file_actions_t fileActions;
+    posix_spawnattr_t attributes;
+    posix_spawn_file_actions_init(&fileActions);
+    posix_spawnattr_init(&attributes);
+    const auto cleanup = qScopeGuard([&] {
+        posix_spawnattr_destroy(&attributes);
+        posix_spawn_file_actions_destroy(&fileActions);
+    });
+
+    // reset the signal that we ignored
+    sigset_t defaultSignals;
+    sigemptyset(&defaultSignals);
+    sigaddset(&defaultSignals, SIGPIPE);
+    posix_spawnattr_setsigdefault(&attributes, &defaultSignals);
+    posix_spawnattr_setflags(&attributes, POSIX_SPAWN_SETSIGDEF);
+
+    // the same as commitChannels()
+    if (stdinChannel.pipe[0] != INVALID_Q_PIPE)
+        posix_spawn_file_actions_adddup2(&fileActions, stdinChannel.pipe[0], STDIN_FILENO);
+    if (stdoutChannel.pipe[1] != INVALID_Q_PIPE)
+        posix_spawn_file_actions_adddup2(&fileActions, stdoutChannel.pipe[1], STDOUT_FILENO);
+    if (stderrChannel.pipe[1] != INVALID_Q_PIPE)
+        posix_spawn_file_actions_adddup2(&fileActions, stderrChannel.pipe[1], STDERR_FILENO);
+    else if (processChannelMode == QProcess::MergedChannels)
+        posix_spawn_file_actions_adddup2(&fileActions, STDOUT_FILENO, STDERR_FILENO);
+
+    if (workingDirectory) {
+#  if defined(__GLIBC__) && __GLIBC_PREREQ(2, 29)
+        posix_spawn_file_actions_addchdir_np(&fileActions, workingDirectory);
+#  else
+        Q_UNREACHABLE();
+#  endif
+    }
+
+    pid_t childPid;
+    const int ffd = ::spawnfd(FFD_CLOEXEC, &childPid, argv[0], &fileActions, &attributes,
+                              argv, envp ? envp : systemEnvironment());
+    if (ffd == -1) {
+        const int spawnErrno = errno;
+        // posix_spawn() doesn't tell which step failed; report a working
+        // directory that can't be entered as execChild() would
+        const char *function = envp ? "execve" : "execvp";
+        int code = spawnErrno;
+        QT_STATBUF st;
+        if (workingDirectory && QT_STAT(workingDirectory, &st) == -1) {
+            function = "chdir";
+            code = errno;
+        }
+        *errorMessage = QLatin1StringView(function) + ": "_L1 + qt_error_string(code);
+        return -1;
+    }
+    *pid = qint64(childPid);
+    return ffd;
+#else
+    Q_UNUSED(workingDirectory);
+    Q_UNUSED(argv);
+    Q_UNUSED(envp);
+    Q_UNUSED(pid);
+    Q_UNUSED(errorMessage);
+    Q_UNREACHABLE_RETURN(-1);
+#endif
+}
+
 bool QProcessPrivate::processStarted(QString *errorMessage)
 {
     Q_Q(QProcess);
@@ -0,0 +1,742 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qprocesspipeline.h"
+#include "qprocesspipeline_p.h"
+
+#include <qeventloop.h>
+#include <qsocketnotifier.h>
+#include <qtimer.h>
+#include <qvarlengtharray.h>
+
+#include <algorithm>
+
+#ifdef Q_OS_UNIX
+#include <private/qcore_unix_p.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+#ifdef Q_OS_UNIX
+
+static void setNonBlocking(int fd)
+{
+    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+}
+
+static bool wouldBlock()
+{
+    return errno == EAGAIN || errno == EWOULDBLOCK;
+}
+
+// The notifiers are deleted later, as this may be called from one of them
+static void releaseNotifier(std::unique_ptr<QSocketNotifier> &notifier)
+{
+    if (!notifier)
+        return;
+    notifier->setEnabled(false);
+    notifier.release()->deleteLater();
+}
+
+QPipeForwarder::QPipeForwarder(int source, const QList<int> &sinkFds, CopyFunction copy,
+                               std::function<void()> finished)
+    : source(source), sinks(sinkFds.size()), openSinks(sinkFds.size()),
+      copy(std::move(copy)), finished(std::move(finished))
+{
+    // a consumer that exits early must not take us with it
+    qt_ignore_sigpipe();
+
+    sourceNotifier.reset(new QSocketNotifier(source, QSocketNotifier::Read));
+    QObject::connect(sourceNotifier.get(), &QSocketNotifier::activated,
+                     sourceNotifier.get(), [this] { readSource(); });
+
+    for (qsizetype i = 0; i < sinkFds.size(); ++i) {
+        Sink &sink = sinks[i];
+        sink.fd = sinkFds.at(i);
+        sink.notifier.reset(new QSocketNotifier(sink.fd, QSocketNotifier::Write));
+        sink.notifier->setEnabled(false);
+        QObject::connect(sink.notifier.get(), &QSocketNotifier::activated,
+                         sink.notifier.get(), [this, &sink] { writeSink(sink); });
+    }
+}
+
+QPipeForwarder::~QPipeForwarder()
+{
+    sourceNotifier.reset();
+    if (source != -1)
+        qt_safe_close(source);
+    for (Sink &sink : sinks) {
+        sink.notifier.reset();
+        if (sink.fd != -1)
+            qt_safe_close(sink.fd);
+    }
+}
+
+void QPipeForwarder::readSource()
+{
+    if (copy || !forwardInKernel())
+        forwardRead();
+    updateSourceNotifier();
+}
+
+/*!
+    \internal
+
+    Moves the data without reading it into this process: tee() duplicates it
+    into every sink but the last one, and splice() then moves it into the last
+    one, which consumes it from the source. Returns false if nothing could be
+    forwarded that way, in which case forwardRead() has to deal with the
+    source.
+*/
+bool QPipeForwarder::forwardInKernel()
+{
+#ifdef Q_OS_LINUX
+    QVarLengthArray<Sink *, 8> targets;
+    for (Sink &sink : sinks) {
+        if (sink.fd == -1)
+            continue;
+        // a sink that has fallen behind needs its data in order
+        if (!sink.pending.isEmpty())
+            return false;
+        targets.append(&sink);
+    }
+    if (targets.isEmpty())
+        return false;
+
+    Sink *last = targets.back();
+    targets.removeLast();
+    ssize_t size = PendingLimit;
+    QVarLengthArray<ssize_t, 8> teed(targets.size());
+    bool complete = true;
+    for (qsizetype i = 0; i < targets.size(); ++i) {
+        ssize_t n;
+        EINTR_LOOP(n, ::tee(source, targets[i]->fd, size, SPLICE_F_NONBLOCK));
+        if (i == 0) {
+            // nothing available, the end of the source or the first sink is
+            // full: let the buffered path sort it out
+            if (n <= 0)
+                return false;
+            size = n;
+        } else if (n < 0) {
+            if (!wouldBlock())
+                closeSink(*targets[i]);
+            n = targets[i]->fd == -1 ? size : 0;
+        }
+        teed[i] = n;
+        complete = complete && n == size;
+    }
+
+    if (complete) {
+        ssize_t spliced;
+        EINTR_LOOP(spliced, ::splice(source, nullptr, last->fd, nullptr, size,
+                                     SPLICE_F_NONBLOCK | SPLICE_F_MOVE));
+        if (spliced <= 0 && targets.isEmpty())
+            return false;
+        if (spliced < 0) {
+            if (!wouldBlock())
+                closeSink(*last);
+            spliced = 0;
+        }
+        if (spliced == size)
+            return true;
+        // the last sink is full, so the rest of what the others already have
+        // needs to be buffered for it
+        QByteArray rest(size - spliced, Qt::Uninitialized);
+        const qint64 n = qt_safe_read(source, rest.data(), rest.size());
+        if (n > 0 && last->fd != -1)
+            append(*last, rest.constData(), n);
+        return true;
+    }
+
+    // Some sink took less than the others: consume what the first sink got
+    // and buffer the missing part for each of them.
+    QByteArray buffer(size, Qt::Uninitialized);
+    const qint64 n = qt_safe_read(source, buffer.data(), buffer.size());
+    if (n <= 0)
+        return true;
+    for (qsizetype i = 0; i < targets.size(); ++i) {
+        if (targets[i]->fd != -1 && teed[i] < n)
+            append(*targets[i], buffer.constData() + teed[i], n - teed[i]);
+    }
+    if (last->fd != -1)
+        append(*last, buffer.constData(), n);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void QPipeForwarder::forwardRead()
+{
+    QByteArray buffer(ReadChunk, Qt::Uninitialized);
+    const qint64 size = qt_safe_read(source, buffer.data(), buffer.size());
+    if (size < 0 && wouldBlock())
+        return;
+    if (size <= 0) {
+        closeSource();
+        return;
+    }
+
+    buffer.truncate(size);
+    if (copy)
+        copy(buffer);
+    for (Sink &sink : sinks) {
+        if (sink.fd != -1)
+            append(sink, buffer.constData(), size);
+    }
+}
+
+void QPipeForwarder::append(Sink &sink, const char *data, qsizetype size)
+{
+    if (sink.pending.isEmpty()) {
+        qint64 written = qt_safe_write(sink.fd, data, size);
+        if (written < 0) {
+            if (!wouldBlock()) {
+                closeSink(sink);
+                return;
+            }
+            written = 0;
+        }
+        data += written;
+        size -= written;
+        if (size == 0)
+            return;
+    }
+    sink.pending.append(data, size);
+    sink.notifier->setEnabled(true);
+}
+
+void QPipeForwarder::writeSink(Sink &sink)
+{
+    const qint64 written = qt_safe_write(sink.fd, sink.pending.constData(), sink.pending.size());
+    if (written < 0) {
+        if (!wouldBlock())
+            closeSink(sink);
+    } else {
+        sink.pending.remove(0, written);
+        if (sink.pending.isEmpty()) {
+            sink.notifier->setEnabled(false);
+            if (source == -1)
+                closeSink(sink);
+        }
+    }
+    updateSourceNotifier();
+}
+
+void QPipeForwarder::closeSink(Sink &sink)
+{
+    releaseNotifier(sink.notifier);
+    qt_safe_close(sink.fd);
+    sink.fd = -1;
+    sink.pending.clear();
+    --openSinks;
+    checkFinished();
+}
+
+void QPipeForwarder::closeSource()
+{
+    releaseNotifier(sourceNotifier);
+    qt_safe_close(source);
+    source = -1;
+
+    // the sinks that are still catching up are closed once they are done
+    for (Sink &sink : sinks) {
+        if (sink.fd != -1 && sink.pending.isEmpty())
+            closeSink(sink);
+    }
+    checkFinished();
+}
+
+void QPipeForwarder::checkFinished()
+{
+    if (!finishedReported && isFinished()) {
+        finishedReported = true;
+        finished();
+    }
+}
+
+void QPipeForwarder::updateSourceNotifier()
+{
+    if (source == -1)
+        return;
+    // stop reading while a sink can't keep up, which lets the pipe to the
+    // source fill up and block the process writing to it
+    bool enable = true;
+    for (const Sink &sink : sinks) {
+        if (sink.pending.size() >= PendingLimit)
+            enable = false;
+    }
+    sourceNotifier->setEnabled(enable);
+}
+
+#endif // Q_OS_UNIX
+
+/*!
+    \class QProcessPipeline
+    \inmodule QtCore
+    \since 6.6
+
+    \brief The QProcessPipeline class connects the output of processes to the
+    input of other processes.
+
+    \reentrant
+    \ingroup io
+    \ingroup misc
+
+    A pipeline consists of stages, each of which is a QProcess, or for the
+    last stage, any number of them. The standard output of each stage is
+    connected to the standard input of the processes of the next one, like a
+    shell pipeline does:
+
+    \code
+        QProcess grep;
+        grep.setProgram("grep");
+        grep.setArguments({"-v", "DEBUG"});
+        QProcess gzip;
+        gzip.setProgram("gzip");
+
+        QProcessPipeline pipeline;
+        pipeline.appendStage(&grep);
+        pipeline.appendStage(&gzip);
+        pipeline.start();
+        grep.write(log);
+        grep.closeWriteChannel();
+        pipeline.waitForFinished();
+        QByteArray compressed = gzip.readAllStandardOutput();
+    \endcode
+
+    The standard input of the first stage and the standard output of the last
+    one are available through the QProcess objects as usual.
+
+    Where one process feeds exactly one other, the two are connected by a
+    single pipe, the same as with QProcess::setStandardOutputProcess(). When
+    the last stage has several processes, or the output of a stage is
+    captured with setStageOutputCaptured(), the pipeline forwards the data
+    from the event loop of the thread it lives in. On Linux, the data is
+    duplicated and moved between the pipes with the tee() and splice() system
+    calls and is only read into this process if a consumer can't keep up, or
+    if it is captured. Elsewhere, it is read and written again. In all cases,
+    a producer is held back while a consumer has more than a few megabytes
+    pending, instead of buffering without bound.
+
+    start() configures the standard input and output of the processes that
+    it connects, so these must not be redirected otherwise. On Unix, it also
+    installs a child process modifier that runs before the one set with
+    QProcess::setChildProcessModifier(), if any.
+
+    \sa QProcess, QProcessPool
+*/
+
+/*!
+    \fn void QProcessPipeline::stageOutputReady(qsizetype index)
+
+    This signal is emitted when there is new output of the stage \a index
+    available to readStageOutput().
+
+    \sa setStageOutputCaptured()
+*/
+
+/*!
+    \fn void QProcessPipeline::finished()
+
+    This signal is emitted when all processes of the pipeline have finished,
+    and all their output has been forwarded.
+*/
+
+/*!
+    Constructs an empty pipeline with the given \a parent.
+*/
+QProcessPipeline::QProcessPipeline(QObject *parent)
+    : QObject(*new QProcessPipelinePrivate, parent)
+{
+}
+
+/*!
+    Destroys the pipeline. This does not affect the processes, but any output
+    that hasn't been forwarded yet is lost.
+*/
+QProcessPipeline::~QProcessPipeline()
+{
+}
+
+/*!
+    Appends a stage consisting of \a process to the pipeline. The pipeline
+    does not take ownership of the process.
+*/
+void QProcessPipeline::appendStage(QProcess *process)
+{
+    appendStage(QList<QProcess *>{ process });
+}
+
+/*!
+    \overload
+
+    Appends a stage consisting of \a processes to the pipeline, each of which
+    receives all output of the previous stage. Only the last stage can have
+    more than one process.
+*/
+void QProcessPipeline::appendStage(const QList<QProcess *> &processes)
+{
+    Q_D(QProcessPipeline);
+    if (d->running) {
+        qWarning("QProcessPipeline::appendStage: Cannot change a running pipeline");
+        return;
+    }
+    QProcessPipelinePrivate::Stage stage;
+    for (QProcess *process : processes)
+        stage.processes.append(process);
+    d->stages.append(std::move(stage));
+}
+
+/*!
+    Returns the number of stages of the pipeline.
+*/
+qsizetype QProcessPipeline::stageCount() const
+{
+    Q_D(const QProcessPipeline);
+    return d->stages.size();
+}
+
+/*!
+    Returns the processes of the stage \a index.
+*/
+QList<QProcess *> QProcessPipeline::stage(qsizetype index) const
+{
+    Q_D(const QProcessPipeline);
+    QList<QProcess *> result;
+    for (QProcess *process : d->stages.at(index).processes)
+        result.append(process);
+    return result;
+}
+
+/*!
+    If \a capture is true, the output of the stage \a index is also made
+    available to readStageOutput() as it passes through the pipeline.
+    By default, it is not. Capturing the output of a stage other than the last
+    one requires the pipeline to forward it, as described above.
+
+    This must be set before start().
+
+    \sa stageOutputReady()
+*/
+void QProcessPipeline::setStageOutputCaptured(qsizetype index, bool capture)
+{
+    Q_D(QProcessPipeline);
+    if (d->running) {
+        qWarning("QProcessPipeline::setStageOutputCaptured: Cannot change a running pipeline");
+        return;
+    }
+    d->stages[index].captured = capture;
+}
+
+/*!
+    Returns whether the output of the stage \a index is captured.
+*/
+bool QProcessPipeline::isStageOutputCaptured(qsizetype index) const
+{
+    Q_D(const QProcessPipeline);
+    return d->stages.at(index).captured;
+}
+
+/*!
+    Returns the output of the stage \a index that has been captured since the
+    last call, and discards it from the pipeline.
+
+    \sa setStageOutputCaptured()
+*/
+QByteArray QProcessPipeline::readStageOutput(qsizetype index)
+{
+    Q_D(QProcessPipeline);
+    return std::exchange(d->stages[index].output, QByteArray());
+}
+
+bool QProcessPipelinePrivate::validateStages() const
+{
+    if (stages.isEmpty()) {
+        qWarning("QProcessPipeline::start: The pipeline has no stages");
+        return false;
+    }
+    for (qsizetype i = 0; i < stages.size(); ++i) {
+        const QList<QPointer<QProcess>> &processes = stages.at(i).processes;
+        if (processes.isEmpty() || (i < stages.size() - 1 && processes.size() > 1)) {
+            qWarning("QProcessPipeline::start: Stage %lld must have %s", qlonglong(i),
+                     i < stages.size() - 1 ? "exactly one process" : "a process");
+            return false;
+        }
+        for (const QPointer<QProcess> &process : processes) {
+            if (!process) {
+                qWarning("QProcessPipeline::start: A process of stage %lld was deleted",
+                         qlonglong(i));
+                return false;
+            }
+            if (process->state() != QProcess::NotRunning) {
+                qWarning("QProcessPipeline::start: A process of stage %lld is already running",
+                         qlonglong(i));
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void QProcessPipelinePrivate::connectProcess(QProcess *process)
+{
+    Q_Q(QProcessPipeline);
+    connections.append(QObject::connect(process, &QProcess::finished, q,
+                                        [this] { processFinished(); }));
+    connections.append(QObject::connect(process, &QProcess::errorOccurred, q,
+                                        [this](QProcess::ProcessError error) {
+        // there won't be a finished() for this one
+        if (error == QProcess::FailedToStart)
+            processFinished();
+    }));
+}
+
+void QProcessPipelinePrivate::captureOutput(qsizetype index, const QByteArray &data)
+{
+    Q_Q(QProcessPipeline);
+    if (data.isEmpty())
+        return;
+    stages[index].output.append(data);
+    emit q->stageOutputReady(index, QProcessPipeline::QPrivateSignal());
+}
+
+void QProcessPipelinePrivate::processFinished()
+{
+    --runningProcesses;
+    checkFinished();
+}
+
+void QProcessPipelinePrivate::checkFinished()
+{
+    Q_Q(QProcessPipeline);
+    if (!running || runningProcesses > 0)
+        return;
+#ifdef Q_OS_UNIX
+    for (const auto &forwarder : forwarders) {
+        if (!forwarder->isFinished())
+            return;
+    }
+    forwarders.clear();
+#endif
+    running = false;
+    emit q->finished(QProcessPipeline::QPrivateSignal());
+}
+
+/*!
+    Connects and starts the processes of the pipeline. Returns false if the
+    stages can't be connected, for instance because one of them is running
+    already. A process that fails to start reports that through its own
+    QProcess::errorOccurred() signal, and the processes next to it see the
+    end of their input or a closed output, respectively.
+
+    The program and arguments of each process must be set before.
+
+    \sa QProcess::setProgram(), QProcess::setArguments()
+*/
+bool QProcessPipeline::start()
+{
+    Q_D(QProcessPipeline);
+    if (d->running) {
+        qWarning("QProcessPipeline::start: The pipeline is already running");
+        return false;
+    }
+    if (!d->validateStages())
+        return false;
+
+    for (const QMetaObject::Connection &connection : std::as_const(d->connections))
+        disconnect(connection);
+    d->connections.clear();
+    for (QProcessPipelinePrivate::Stage &stage : d->stages)
+        stage.output.clear();
+
+#ifdef Q_OS_UNIX
+    // dup2(fd, target) in the child process, and close fd in the parent
+    // once it has started
+    struct Redirection
+    {
+        QProcess *process;
+        int fd;
+        int target;
+    };
+    QList<Redirection> redirections;
+    const auto closeRedirections = [&redirections] {
+        for (const Redirection &redirection : std::as_const(redirections))
+            qt_safe_close(redirection.fd);
+    };
+#endif
+
+    const qsizetype last = d->stages.size() - 1;
+    for (qsizetype i = 0; i < last; ++i) {
+        QProcess *source = d->stages.at(i).processes.constFirst();
+        const QList<QPointer<QProcess>> &consumers = d->stages.at(i + 1).processes;
+        if (consumers.size() == 1 && !d->stages.at(i).captured) {
+            // the data never leaves the kernel
+            source->setStandardOutputProcess(consumers.constFirst());
+            continue;
+        }
+
+#ifdef Q_OS_UNIX
+        int sourcePipe[2];
+        if (qt_safe_pipe(sourcePipe) == -1) {
+            qErrnoWarning("QProcessPipeline::start: Cannot create pipe");
+            closeRedirections();
+            d->forwarders.clear();
+            return false;
+        }
+        setNonBlocking(sourcePipe[0]);
+        redirections.append({ source, sourcePipe[1], STDOUT_FILENO });
+
+        QList<int> sinks;
+        for (QProcess *consumer : consumers) {
+            int sinkPipe[2];
+            if (qt_safe_pipe(sinkPipe) == -1) {
+                qErrnoWarning("QProcessPipeline::start: Cannot create pipe");
+                qt_safe_close(sourcePipe[0]);
+                for (int sink : std::as_const(sinks))
+                    qt_safe_close(sink);
+                closeRedirections();
+                d->forwarders.clear();
+                return false;
+            }
+            setNonBlocking(sinkPipe[1]);
+            redirections.append({ consumer, sinkPipe[0], STDIN_FILENO });
+            sinks.append(sinkPipe[1]);
+        }
+
+        QPipeForwarder::CopyFunction copy;
+        if (d->stages.at(i).captured)
+            copy = [d, i](const QByteArray &data) { d->captureOutput(i, data); };
+        // deliver the end asynchronously, as a slot connected to finished()
+        // may well delete the pipeline
+        auto done = [this] {
+            QMetaObject::invokeMethod(this, [this] { d_func()->checkFinished(); },
+                                      Qt::QueuedConnection);
+        };
+        d->forwarders.emplace_back(new QPipeForwarder(sourcePipe[0], sinks, std::move(copy),
+                                                      std::move(done)));
+#else
+        d->connections.append(connect(source, &QProcess::readyReadStandardOutput, this,
+                                      [d, i, source, consumers] {
+            const QByteArray data = source->readAllStandardOutput();
+            if (d->stages.at(i).captured)
+                d->captureOutput(i, data);
+            for (QProcess *consumer : consumers) {
+                if (consumer && consumer->state() == QProcess::Running)
+                    consumer->write(data);
+            }
+        }));
+        d->connections.append(connect(source, &QProcess::finished, this, [consumers] {
+            for (QProcess *consumer : consumers) {
+                if (consumer)
+                    consumer->closeWriteChannel();
+            }
+        }));
+#endif
+    }
+
+    if (d->stages.at(last).captured) {
+        for (QProcess *process : std::as_const(d->stages.at(last).processes)) {
+            d->connections.append(connect(process, &QProcess::readyReadStandardOutput, this,
+                                          [d, last, process] {
+                d->captureOutput(last, process->readAllStandardOutput());
+            }));
+        }
+    }
+
+#ifdef Q_OS_UNIX
+    // The pipes replace what QProcess connects to the channels
+    QList<std::pair<QProcess *, std::function<void(void)>>> modifiers;
+    for (const Redirection &redirection : std::as_const(redirections)) {
+        QProcess *process = redirection.process;
+        if (redirection.target == STDOUT_FILENO)
+            process->setStandardOutputFile(QProcess::nullDevice());
+        else
+            process->setStandardInputFile(QProcess::nullDevice());
+
+        const auto found = std::find_if(modifiers.cbegin(), modifiers.cend(),
+                                        [process](const auto &entry) {
+            return entry.first == process;
+        });
+        if (found != modifiers.cend())
+            continue;
+
+        QVarLengthArray<std::pair<int, int>, 2> dups;
+        for (const Redirection &other : std::as_const(redirections)) {
+            if (other.process == process)
+                dups.append({ other.fd, other.target });
+        }
+        std::function<void(void)> previous = process->childProcessModifier();
+        modifiers.append({ process, previous });
+        process->setChildProcessModifier([dups, previous] {
+            for (const auto &[fd, target] : dups)
+                ::dup2(fd, target);
+            if (previous)
+                previous();
+        });
+    }
+#endif
+
+    d->running = true;
+    d->runningProcesses = 0;
+    for (const QProcessPipelinePrivate::Stage &stage : std::as_const(d->stages))
+        d->runningProcesses += stage.processes.size();
+    for (const QProcessPipelinePrivate::Stage &stage : std::as_const(d->stages)) {
+        for (QProcess *process : stage.processes) {
+            d->connectProcess(process);
+            process->start();
+        }
+    }
+
+#ifdef Q_OS_UNIX
+    for (const auto &[process, previous] : std::as_const(modifiers))
+        process->setChildProcessModifier(previous);
+    closeRedirections();
+#endif
+
+    d->checkFinished();
+    return true;
+}
+
+/*!
+    Returns true if the pipeline has been started and has not finished yet.
+*/
+bool QProcessPipeline::isRunning() const
+{
+    Q_D(const QProcessPipeline);
+    return d->running;
+}
+
+/*!
+    Runs an event loop until the pipeline has finished, or until \a msecs
+    milliseconds have passed. If \a msecs is -1, this function will not time
+    out. Returns true if the pipeline has finished, and false if it wasn't
+    running or the operation timed out.
+
+    \sa finished()
+*/
+bool QProcessPipeline::waitForFinished(int msecs)
+{
+    Q_D(QProcessPipeline);
+    if (!d->running)
+        return false;
+
+    QEventLoop loop;
+    connect(this, &QProcessPipeline::finished, &loop, &QEventLoop::quit);
+    QTimer timer;
+    if (msecs >= 0) {
+        timer.setSingleShot(true);
+        connect(&timer, &QTimer::timeout, &loop, &QEventLoop::quit);
+        timer.start(msecs);
+    }
+    loop.exec();
+    return !d->running;
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qprocesspipeline.cpp"
@@ -0,0 +1,47 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QPROCESSPIPELINE_H
+#define QPROCESSPIPELINE_H
+
+#include <QtCore/qobject.h>
+#include <QtCore/qlist.h>
+
+QT_REQUIRE_CONFIG(process);
+
+QT_BEGIN_NAMESPACE
+
+
+class QProcess;
+class QProcessPipelinePrivate;
+
+class Q_CORE_EXPORT QProcessPipeline : public QObject
+{
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(QProcessPipeline)
+
+public:
+    explicit QProcessPipeline(QObject *parent = nullptr);
+    ~QProcessPipeline();
+
+    void appendStage(QProcess *process);
+    void appendStage(const QList<QProcess *> &processes);
+    qsizetype stageCount() const;
+    QList<QProcess *> stage(qsizetype index) const;
+
+    void setStageOutputCaptured(qsizetype index, bool capture);
+    bool isStageOutputCaptured(qsizetype index) const;
+    QByteArray readStageOutput(qsizetype index);
+
+    bool start();
+    bool isRunning() const;
+    bool waitForFinished(int msecs = 30000);
+
+Q_SIGNALS:
+    void stageOutputReady(qsizetype index, QPrivateSignal);
+    void finished(QPrivateSignal);
+};
+
+QT_END_NAMESPACE
+
+#endif // QPROCESSPIPELINE_H
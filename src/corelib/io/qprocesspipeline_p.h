@@ -0,0 +1,114 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QPROCESSPIPELINE_P_H
+#define QPROCESSPIPELINE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API. It exists purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qprocesspipeline.h"
+
+QT_REQUIRE_CONFIG(process);
+
+#include <private/qobject_p.h>
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qpointer.h>
+#include <QtCore/qprocess.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+class QSocketNotifier;
+
+#ifdef Q_OS_UNIX
+// Moves the data written to the pipe \a source into each of the pipes in
+// \a sinks, keeping it in the kernel whenever possible. Only if a sink can't
+// keep up, or the data is also wanted in the parent process, is it read into
+// a buffer. Takes ownership of the descriptors, which must be non-blocking.
+class QPipeForwarder
+{
+public:
+    using CopyFunction = std::function<void(const QByteArray &)>;
+
+    QPipeForwarder(int source, const QList<int> &sinks, CopyFunction copy,
+                   std::function<void()> finished);
+    ~QPipeForwarder();
+    Q_DISABLE_COPY_MOVE(QPipeForwarder)
+
+    bool isFinished() const { return source == -1 && openSinks == 0; }
+
+    // Don't stop reading before this much data is pending for a sink
+    static constexpr qsizetype PendingLimit = 1024 * 1024;
+    static constexpr qsizetype ReadChunk = 64 * 1024;
+
+private:
+    struct Sink
+    {
+        int fd = -1;
+        QByteArray pending;
+        std::unique_ptr<QSocketNotifier> notifier;
+    };
+
+    void readSource();
+    bool forwardInKernel();
+    void forwardRead();
+    void writeSink(Sink &sink);
+    void append(Sink &sink, const char *data, qsizetype size);
+    void closeSink(Sink &sink);
+    void closeSource();
+    void updateSourceNotifier();
+    void checkFinished();
+
+    int source;
+    std::unique_ptr<QSocketNotifier> sourceNotifier;
+    std::vector<Sink> sinks;
+    qsizetype openSinks = 0;
+    CopyFunction copy;
+    std::function<void()> finished;
+    bool finishedReported = false;
+};
+#endif
+
+class QProcessPipelinePrivate : public QObjectPrivate
+{
+    Q_DECLARE_PUBLIC(QProcessPipeline)
+
+public:
+    struct Stage
+    {
+        QList<QPointer<QProcess>> processes;
+        QByteArray output;
+        bool captured = false;
+    };
+
+    bool validateStages() const;
+    void connectProcess(QProcess *process);
+    void captureOutput(qsizetype index, const QByteArray &data);
+    void processFinished();
+    void checkFinished();
+
+    QList<Stage> stages;
+    QList<QMetaObject::Connection> connections;
+#ifdef Q_OS_UNIX
+    std::vector<std::unique_ptr<QPipeForwarder>> forwarders;
+#endif
+    qsizetype runningProcesses = 0;
+    bool running = false;
+};
+
+QT_END_NAMESPACE
+
+#endif // QPROCESSPIPELINE_P_H
@@ -0,0 +1,267 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qprocesspool.h"
+
+#include <qprocess.h>
+
+#include <private/qobject_p.h>
+
+QT_BEGIN_NAMESPACE
+
+class QProcessPoolPrivate : public QObjectPrivate
+{
+    Q_DECLARE_PUBLIC(QProcessPool)
+
+public:
+    QProcess *startProcess();
+    void release(QProcess *process);
+    void kill(QProcess *process);
+    void scheduleRefill();
+    void refill();
+
+    QString program;
+    QStringList arguments;
+    QList<QProcess *> spares;
+    int spareCount = 1;
+    bool refillScheduled = false;
+};
+
+QProcess *QProcessPoolPrivate::startProcess()
+{
+    auto process = new QProcess;
+    process->setProgram(program);
+    process->setArguments(arguments);
+    process->start();
+    return process;
+}
+
+// Stops watching a spare, which either leaves the pool or is deleted
+void QProcessPoolPrivate::release(QProcess *process)
+{
+    Q_Q(QProcessPool);
+    spares.removeOne(process);
+    QObject::disconnect(process, nullptr, q, nullptr);
+}
+
+void QProcessPoolPrivate::kill(QProcess *process)
+{
+    release(process);
+    process->kill();
+    process->waitForFinished();
+    delete process;
+}
+
+void QProcessPoolPrivate::scheduleRefill()
+{
+    Q_Q(QProcessPool);
+    if (refillScheduled || program.isEmpty() || spares.size() >= spareCount)
+        return;
+    refillScheduled = true;
+    QMetaObject::invokeMethod(q, [this] { refill(); }, Qt::QueuedConnection);
+}
+
+void QProcessPoolPrivate::refill()
+{
+    Q_Q(QProcessPool);
+    refillScheduled = false;
+    while (!program.isEmpty() && spares.size() < spareCount) {
+        QProcess *process = startProcess();
+        process->setParent(q);
+        spares.append(process);
+
+        // A spare that goes away on its own is not replaced until the next
+        // takeProcess(), so that a program that can't run doesn't keep the
+        // pool busy.
+        QObject::connect(process, &QProcess::finished, q, [this, process] {
+            release(process);
+            process->deleteLater();
+        });
+        QObject::connect(process, &QProcess::errorOccurred, q,
+                         [this, process](QProcess::ProcessError error) {
+            if (error != QProcess::FailedToStart)
+                return;
+            release(process);
+            process->deleteLater();
+        });
+    }
+}
+
+/*!
+    \class QProcessPool
+    \inmodule QtCore
+    \since 6.6
+
+    \brief The QProcessPool class keeps processes started in advance.
+
+    \reentrant
+    \ingroup io
+    \ingroup misc
+
+    Starting a process takes time, mostly for creating the new address space
+    and for the dynamic linking and initialization of the program. An
+    application that frequently runs the same helper program can hide that
+    latency by having a QProcessPool start it ahead of time:
+
+    \code
+        QProcessPool pool;
+        pool.setProgram("converter");
+        pool.setArguments({"--stdin"});
+        pool.setSpareCount(2);
+        ...
+        QProcess *converter = pool.takeProcess();
+        converter->write(data);
+        converter->closeWriteChannel();
+    \endcode
+
+    takeProcess() hands out one of the processes that are already running,
+    which are waiting to read their standard input, and the pool starts a
+    replacement from the event loop. The processes are started with the
+    program() and arguments() of the pool, and otherwise with the default
+    settings of QProcess. A process that finishes while it is waiting in the
+    pool is discarded.
+
+    \sa QProcess, QProcessPipeline
+*/
+
+/*!
+    Constructs an empty pool with the given \a parent.
+*/
+QProcessPool::QProcessPool(QObject *parent)
+    : QObject(*new QProcessPoolPrivate, parent)
+{
+}
+
+/*!
+    Destroys the pool, killing the processes that are waiting in it.
+
+    \sa clear()
+*/
+QProcessPool::~QProcessPool()
+{
+    clear();
+}
+
+/*!
+    Sets the program that the processes of the pool run to \a program.
+    The processes that were started with the previous program are killed.
+*/
+void QProcessPool::setProgram(const QString &program)
+{
+    Q_D(QProcessPool);
+    if (d->program == program)
+        return;
+    clear();
+    d->program = program;
+    d->scheduleRefill();
+}
+
+/*!
+    Returns the program that the processes of the pool run.
+*/
+QString QProcessPool::program() const
+{
+    Q_D(const QProcessPool);
+    return d->program;
+}
+
+/*!
+    Sets the arguments that the processes of the pool are started with to
+    \a arguments. The processes that were started with the previous
+    arguments are killed.
+*/
+void QProcessPool::setArguments(const QStringList &arguments)
+{
+    Q_D(QProcessPool);
+    if (d->arguments == arguments)
+        return;
+    clear();
+    d->arguments = arguments;
+    d->scheduleRefill();
+}
+
+/*!
+    Returns the arguments that the processes of the pool are started with.
+*/
+QStringList QProcessPool::arguments() const
+{
+    Q_D(const QProcessPool);
+    return d->arguments;
+}
+
+/*!
+    Sets the number of processes that the pool keeps running in advance to
+    \a count. The default is 1. Setting it to 0 disables the pool, so that
+    takeProcess() starts each process on demand.
+*/
+void QProcessPool::setSpareCount(int count)
+{
+    Q_D(QProcessPool);
+    d->spareCount = qMax(count, 0);
+    while (d->spares.size() > d->spareCount)
+        d->kill(d->spares.constLast());
+    d->scheduleRefill();
+}
+
+/*!
+    Returns the number of processes that the pool keeps running in advance.
+*/
+int QProcessPool::spareCount() const
+{
+    Q_D(const QProcessPool);
+    return d->spareCount;
+}
+
+/*!
+    Returns the number of processes that are waiting in the pool.
+*/
+int QProcessPool::availableCount() const
+{
+    Q_D(const QProcessPool);
+    return int(d->spares.size());
+}
+
+/*!
+    Returns a process running program() with arguments(), and schedules the
+    start of its replacement. The caller takes ownership of the process,
+    which has no parent.
+
+    If no process is waiting in the pool, a new one is started, so the
+    process may still be in the QProcess::Starting state.
+
+    \sa QProcess::waitForStarted()
+*/
+QProcess *QProcessPool::takeProcess()
+{
+    Q_D(QProcessPool);
+    if (d->program.isEmpty()) {
+        qWarning("QProcessPool::takeProcess: No program set");
+        return nullptr;
+    }
+
+    QProcess *process;
+    if (!d->spares.isEmpty()) {
+        process = d->spares.constFirst();
+        d->release(process);
+        process->setParent(nullptr);
+    } else {
+        process = d->startProcess();
+    }
+    d->scheduleRefill();
+    return process;
+}
+
+/*!
+    Kills the processes that are waiting in the pool. New ones are started
+    when a process is taken out of it again.
+*/
+void QProcessPool::clear()
+{
+    Q_D(QProcessPool);
+    while (!d->spares.isEmpty())
+        d->kill(d->spares.constLast());
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qprocesspool.cpp"
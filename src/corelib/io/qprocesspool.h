@@ -0,0 +1,42 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QPROCESSPOOL_H
+#define QPROCESSPOOL_H
+
+#include <QtCore/qobject.h>
+#include <QtCore/qstringlist.h>
+
+QT_REQUIRE_CONFIG(process);
+
+QT_BEGIN_NAMESPACE
+
+
+class QProcess;
+class QProcessPoolPrivate;
+
+class Q_CORE_EXPORT QProcessPool : public QObject
+{
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(QProcessPool)
+
+public:
+    explicit QProcessPool(QObject *parent = nullptr);
+    ~QProcessPool();
+
+    void setProgram(const QString &program);
+    QString program() const;
+    void setArguments(const QStringList &arguments);
+    QStringList arguments() const;
+
+    void setSpareCount(int count);
+    int spareCount() const;
+    int availableCount() const;
+
+    QProcess *takeProcess();
+    void clear();
+};
+
+QT_END_NAMESPACE
+
+#endif // QPROCESSPOOL_H
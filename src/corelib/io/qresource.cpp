@@ -15,6 +15,9 @@
 #include "qbytearray.h"
 #include "qstringlist.h"
 #include "qendian.h"
+#include "qcache.h"
+#include "qhash.h"
+#include "qvarlengtharray.h"
 #include <qshareddata.h>
 #include <qplatformdefs.h>
 #include <qendian.h>
@@ -25,6 +28,8 @@
 #include "private/qtools_p.h"
 #include "private/qsystemerror_p.h"
 
+#include <memory>
+
 #ifndef QT_NO_COMPRESS
 #  include <zconf.h>
 #  include <zlib.h>
@@ -40,6 +45,10 @@
 
 //#define DEBUG_RESOURCE_MATCH
 
+#ifndef QRESOURCE_CACHE_SIZE
+#define QRESOURCE_CACHE_SIZE (8 * 1024 * 1024)
+#endif
+
 QT_BEGIN_NAMESPACE
 
 using namespace Qt::StringLiterals;
@@ -106,18 +115,31 @@ public:
     };
 
 private:
+    // Maps the hash of every full path in the tree to its node, so that
+    // lookups don't need to walk the tree one segment at a time. The path
+    // hashes are folded from the per-segment hashes that rcc stores.
+    struct PathIndex {
+        QHash<size_t, int> nodes;   // -1 if more than one path has that hash
+        QList<int> parents;
+    };
+
     const uchar *tree, *names, *payloads;
     int version;
+    mutable QAtomicPointer<PathIndex> pathIndex = nullptr;
     inline int findOffset(int node) const { return node * (14 + (version >= 0x02 ? 8 : 0)); } //sizeof each tree element
     uint hash(int node) const;
     QString name(int node) const;
+    bool nameEquals(int node, QStringView name) const;
+    bool sameName(int node1, int node2) const;
     short flags(int node) const;
+    const PathIndex *ensurePathIndex() const;
+    int findIndexedNode(QStringView path, const QLocale &locale, bool *ambiguous) const;
 public:
     mutable QAtomicInt ref;
 
     inline QResourceRoot(): tree(nullptr), names(nullptr), payloads(nullptr), version(0) {}
     inline QResourceRoot(int version, const uchar *t, const uchar *n, const uchar *d) { setSource(version, t, n, d); }
-    virtual ~QResourceRoot() { }
+    virtual ~QResourceRoot();
     int findNode(const QString &path, const QLocale &locale=QLocale()) const;
     inline bool isContainer(int node) const { return flags(node) & Directory; }
     QResource::Compression compressionAlgo(int node)
@@ -167,6 +189,11 @@ struct QResourceGlobalData
 {
     QRecursiveMutex resourceMutex;
     ResourceList resourceList;
+
+    // Recently decompressed resource data, keyed by the address of the
+    // compressed data and limited to QRESOURCE_CACHE_SIZE bytes in total.
+    QMutex decompressedCacheMutex;
+    QCache<const uchar *, QByteArray> decompressedCache{QRESOURCE_CACHE_SIZE};
 };
 Q_GLOBAL_STATIC(QResourceGlobalData, resourceGlobalData)
 
@@ -660,8 +687,10 @@ const uchar *QResource::data() const
     compressed. If the resource is a directory or an error occurs while
     decompressing, a null QByteArray is returned.
 
-    \note If the data was compressed, this function will decompress every time
-    it is called. The result is not cached between calls.
+    \note If the data was compressed, the most recently decompressed resources
+    are kept in a cache of limited size that is shared by all QResource
+    objects, so that reading the same resource again does not need to
+    decompress it again.
 
     \sa uncompressedSize(), size(), compressionAlgorithm(), isFile()
 */
@@ -679,13 +708,25 @@ QByteArray QResource::uncompressedData() const
     if (d->compressionAlgo == NoCompression)
         return QByteArray::fromRawData(reinterpret_cast<const char *>(d->data), n);
 
+    QResourceGlobalData *global = resourceGlobalData();
+    if (global) {
+        const auto locker = qt_scoped_lock(global->decompressedCacheMutex);
+        if (const QByteArray *cached = global->decompressedCache.object(d->data))
+            return *cached;
+    }
+
     // decompress
     QByteArray result(n, Qt::Uninitialized);
     n = d->decompress(result.data(), n);
-    if (n < 0)
+    if (n < 0) {
         result.clear();
-    else
+    } else {
         result.truncate(n);
+        if (global) {
+            const auto locker = qt_scoped_lock(global->decompressedCacheMutex);
+            global->decompressedCache.insert(d->data, new QByteArray(result), result.size());
+        }
+    }
     return result;
 }
 
@@ -757,6 +798,156 @@ inline QString QResourceRoot::name(int node) const
     return ret;
 }
 
+inline bool QResourceRoot::nameEquals(int node, QStringView name) const
+{
+    if (!node) // root
+        return name.isEmpty();
+    const int offset = findOffset(node);
+    qint32 name_offset = qFromBigEndian<qint32>(tree + offset);
+    const quint16 name_length = qFromBigEndian<qint16>(names + name_offset);
+    if (name_length != name.size())
+        return false;
+    name_offset += 2;
+    name_offset += 4; // jump past hash
+
+    const uchar *data = names + name_offset;
+    for (qsizetype i = 0; i < name_length; ++i) {
+        if (qFromBigEndian<char16_t>(data + 2 * i) != name[i].unicode())
+            return false;
+    }
+    return true;
+}
+
+inline bool QResourceRoot::sameName(int node1, int node2) const
+{
+    const qint32 name_offset1 = qFromBigEndian<qint32>(tree + findOffset(node1));
+    const qint32 name_offset2 = qFromBigEndian<qint32>(tree + findOffset(node2));
+    if (name_offset1 == name_offset2)
+        return true;
+    const quint16 name_length = qFromBigEndian<qint16>(names + name_offset1);
+    if (name_length != qFromBigEndian<quint16>(names + name_offset2))
+        return false;
+    // compare the hashes and the names in one go
+    return memcmp(names + name_offset1 + 2, names + name_offset2 + 2, 4 + 2 * name_length) == 0;
+}
+
+QResourceRoot::~QResourceRoot()
+{
+    delete pathIndex.loadRelaxed();
+
+    // The cache is keyed by the address of the compressed data, which may
+    // be released together with this root.
+    if (payloads && !resourceGlobalData.isDestroyed()) {
+        QResourceGlobalData *global = resourceGlobalData();
+        const auto locker = qt_scoped_lock(global->decompressedCacheMutex);
+        global->decompressedCache.clear();
+    }
+}
+
+const QResourceRoot::PathIndex *QResourceRoot::ensurePathIndex() const
+{
+    if (const PathIndex *index = pathIndex.loadAcquire())
+        return index;
+
+    auto index = std::make_unique<PathIndex>();
+    index->parents.append(-1); // the root node is always first
+
+    // walk the tree breadth first, as rcc lays it out
+    QList<std::pair<int, size_t>> directories;
+    directories.append({0, 0});
+    for (qsizetype i = 0; i < directories.size(); ++i) {
+        const auto [dir, dirHash] = directories.at(i);
+        const int offset = findOffset(dir) + 6; // jump past name and flags
+        const qint32 child_count = qFromBigEndian<qint32>(tree + offset);
+        const qint32 child = qFromBigEndian<qint32>(tree + offset + 4);
+        if (child_count <= 0 || child <= dir) // empty or malformed
+            continue;
+        if (index->parents.size() < child + child_count)
+            index->parents.resize(child + child_count, -1);
+
+        for (int sub_node = child; sub_node < child + child_count; ++sub_node) {
+            index->parents[sub_node] = dir;
+            // rcc stores one node per locale of a file, next to each other;
+            // only the first one goes into the index
+            if (sub_node > child && sameName(sub_node, sub_node - 1))
+                continue;
+            const size_t h = QtPrivate::QHashCombine()(dirHash, hash(sub_node));
+            auto it = index->nodes.find(h);
+            if (it == index->nodes.end())
+                index->nodes.insert(h, sub_node);
+            else
+                *it = -1;
+            if (flags(sub_node) & Directory)
+                directories.append({sub_node, h});
+        }
+    }
+
+    PathIndex *existing = nullptr;
+    if (pathIndex.testAndSetOrdered(nullptr, index.get(), existing))
+        return index.release();
+    return existing;
+}
+
+// Returns the node for \a path using the path index. Sets \a ambiguous if
+// the index can't tell, in which case the tree has to be walked.
+int QResourceRoot::findIndexedNode(QStringView path, const QLocale &locale, bool *ambiguous) const
+{
+    QVarLengthArray<QStringView, 16> segments;
+    size_t h = 0;
+    QStringSplitter splitter(path);
+    while (splitter.hasNext()) {
+        const QStringView segment = splitter.next();
+        segments.append(segment);
+        h = QtPrivate::QHashCombine()(h, qt_hash(segment));
+    }
+    if (segments.isEmpty())
+        return -1;
+
+    const PathIndex *index = ensurePathIndex();
+    const auto it = index->nodes.constFind(h);
+    if (it == index->nodes.cend())
+        return -1;
+    if (*it == -1) {
+        *ambiguous = true;
+        return -1;
+    }
+
+    // no other path has this hash, so the path either is this one or doesn't exist
+    const int found = *it;
+    int node = found;
+    for (qsizetype i = segments.size() - 1; i >= 0; --i) {
+        if (node <= 0 || !nameEquals(node, segments.at(i)))
+            return -1;
+        node = index->parents.at(node);
+    }
+    if (node != 0)
+        return -1;
+
+    if (flags(found) & Directory)
+        return found;
+
+    // pick the best match for the locale among the nodes for this file
+    const int parent = index->parents.at(found);
+    const int parentOffset = findOffset(parent) + 6; // jump past name and flags
+    const int end = qFromBigEndian<qint32>(tree + parentOffset + 4)
+                    + qFromBigEndian<qint32>(tree + parentOffset);
+    int result = -1;
+    for (int sub_node = found; sub_node < end && hash(sub_node) == hash(found); ++sub_node) {
+        if (!sameName(sub_node, found))
+            continue;
+        const int offset = findOffset(sub_node) + 6; // jump past name and flags
+        const qint16 territory = qFromBigEndian<qint16>(tree + offset);
+        const qint16 language = qFromBigEndian<qint16>(tree + offset + 2);
+        if (territory == locale.territory() && language == locale.language())
+            return sub_node;
+        if ((territory == QLocale::AnyTerritory && language == locale.language())
+            || (territory == QLocale::AnyTerritory && language == QLocale::C && result == -1)) {
+            result = sub_node;
+        }
+    }
+    return result;
+}
+
 int QResourceRoot::findNode(const QString &_path, const QLocale &locale) const
 {
     QString path = _path;
@@ -782,6 +973,11 @@ int QResourceRoot::findNode(const QString &_path, const QLocale &locale) const
     if (path == "/"_L1)
         return 0;
 
+    bool ambiguous = false;
+    const int indexed = findIndexedNode(path, locale, &ambiguous);
+    if (!ambiguous)
+        return indexed;
+
     // the root node is always first
     qint32 child_count = qFromBigEndian<qint32>(tree + 6);
     qint32 child       = qFromBigEndian<qint32>(tree + 10);
@@ -823,7 +1019,7 @@ int QResourceRoot::findNode(const QString &_path, const QLocale &locale) const
                 --sub_node;
             for (; sub_node < child + child_count && hash(sub_node) == h;
                  ++sub_node) { // here we go...
-                if (name(sub_node) == segment) {
+                if (nameEquals(sub_node, segment)) {
                     found = true;
                     int offset = findOffset(sub_node);
 #ifdef DEBUG_RESOURCE_MATCH
@@ -878,7 +878,10 @@ QStringList QSettingsPrivate::splitArgs(const QString &s, qsizetype idx)
 
 void QConfFileSettingsPrivate::initFormat()
 {
-    extension = (format == QSettings::NativeFormat) ? ".conf"_L1 : ".ini"_L1;
+    if (format == QSettings::BinaryFormat)
+        extension = ".qsettings"_L1;
+    else
+        extension = (format == QSettings::NativeFormat) ? ".conf"_L1 : ".ini"_L1;
     readFunc = nullptr;
     writeFunc = nullptr;
 #if defined(Q_OS_DARWIN)
@@ -905,7 +908,7 @@ void QConfFileSettingsPrivate::initFormat()
 void QConfFileSettingsPrivate::initAccess()
 {
     if (!confFiles.isEmpty()) {
-        if (format > QSettings::IniFormat) {
+        if (format > QSettings::IniFormat && format != QSettings::BinaryFormat) {
             if (!readFunc)
                 setStatus(QSettings::AccessError);
         }
@@ -1292,7 +1295,7 @@ QString QConfFileSettingsPrivate::fileName() const
 
 bool QConfFileSettingsPrivate::isWritable() const
 {
-    if (format > QSettings::IniFormat && !writeFunc)
+    if (format > QSettings::IniFormat && format != QSettings::BinaryFormat && !writeFunc)
         return false;
 
     if (confFiles.isEmpty())
@@ -1358,6 +1361,7 @@ void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
 
     if (mustReadFile) {
         confFile->unparsedIniSections.clear();
+        confFile->binaryData.clear();
         confFile->originalKeys.clear();
 
         QFile file(confFile->name);
@@ -1381,6 +1385,12 @@ void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
             if (format <= QSettings::IniFormat) {
                 QByteArray data = file.readAll();
                 ok = readIniFile(data, &confFile->unparsedIniSections);
+            } else if (format == QSettings::BinaryFormat) {
+#ifndef QT_NO_DATASTREAM
+                // only the section directory is decoded here
+                confFile->binaryData = file.readAll();
+                ok = readBinaryFile(confFile->binaryData, &confFile->unparsedIniSections);
+#endif
             } else if (readFunc) {
                 QSettings::SettingsMap tempNewKeys;
                 ok = readFunc(file, tempNewKeys);
@@ -1409,7 +1419,13 @@ void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
     */
     if (!readOnly) {
         bool ok = false;
-        ensureAllSectionsParsed(confFile);
+        if (format == QSettings::BinaryFormat) {
+            // Sections without pending changes are written back without being parsed.
+            for (auto i = confFile->addedKeys.cbegin(); i != confFile->addedKeys.cend(); ++i)
+                ensureSectionParsed(confFile, i.key());
+        } else {
+            ensureAllSectionsParsed(confFile);
+        }
         ParsedSettingsMap mergedKeys = confFile->mergedKeyMap();
 
 #if !defined(QT_BOOTSTRAPPED) && QT_CONFIG(temporaryfile)
@@ -1435,6 +1451,13 @@ void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
 #endif
         if (format <= QSettings::IniFormat) {
             ok = writeIniFile(sf, mergedKeys);
+        } else if (format == QSettings::BinaryFormat) {
+#ifndef QT_NO_DATASTREAM
+            const QByteArray data = writeBinaryFile(mergedKeys, &confFile->unparsedIniSections);
+            // the unparsed sections now point into data
+            confFile->binaryData = data;
+            ok = sf.write(data) == data.size();
+#endif
         } else if (writeFunc) {
             QSettings::SettingsMap tempOriginalKeys;
 
@@ -1452,7 +1475,8 @@ void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
 #endif
 
         if (ok) {
-            confFile->unparsedIniSections.clear();
+            if (format != QSettings::BinaryFormat)
+                confFile->unparsedIniSections.clear();
             confFile->originalKeys = mergedKeys;
             confFile->addedKeys.clear();
             confFile->removedKeys.clear();
@@ -1815,13 +1839,155 @@ bool QConfFileSettingsPrivate::writeIniFile(QIODevice &device, const ParsedSetti
     return !writeError;
 }
 
+#ifndef QT_NO_DATASTREAM
+/*
+    A BinaryFormat file starts with a directory of its top-level sections,
+    followed by the section data. Each section is a sequence of QDataStream
+    serialized (QByteArray, QVariant) pairs, holding the UTF-8 encoded keys
+    relative to the section. Only the directory is decoded when the file is read; sections
+    are decoded on first access, and sections without pending changes are
+    copied verbatim when the file is written back.
+*/
+static constexpr char binarySettingsMagic[] = { 'Q', 'S', 'B', '1' };
+static constexpr QDataStream::Version binarySettingsVersion = QDataStream::Qt_6_6;
+
+bool QConfFileSettingsPrivate::readBinaryFile(const QByteArray &data,
+                                              UnparsedSettingsMap *unparsedSections)
+{
+    if (!data.startsWith(QByteArrayView(binarySettingsMagic, sizeof(binarySettingsMagic))))
+        return false;
+
+    struct SectionEntry
+    {
+        QString name;
+        quint32 offset;
+        quint32 size;
+    };
+    QList<SectionEntry> sections;
+
+    QDataStream in(data);
+    in.setVersion(binarySettingsVersion);
+    in.skipRawData(sizeof(binarySettingsMagic));
+    quint32 count = 0;
+    in >> count;
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        SectionEntry entry;
+        in >> entry.name >> entry.offset >> entry.size;
+        sections.append(std::move(entry));
+    }
+    if (in.status() != QDataStream::Ok)
+        return false;
+
+    const qint64 start = in.device()->pos();
+    const qint64 available = data.size() - start;
+    for (const SectionEntry &entry : std::as_const(sections)) {
+        if (qint64(entry.offset) + entry.size > available)
+            return false;
+        unparsedSections->insert(QSettingsKey(entry.name, IniCaseSensitivity),
+                                 QByteArray::fromRawData(data.constData() + start + entry.offset,
+                                                         entry.size));
+    }
+    return true;
+}
+
+bool QConfFileSettingsPrivate::readBinarySection(const QSettingsKey &section,
+                                                 const QByteArray &data,
+                                                 ParsedSettingsMap *settingsMap)
+{
+    QDataStream in(data);
+    in.setVersion(binarySettingsVersion);
+    const QString prefix = section.originalCaseKey();
+    QByteArray key;
+    QVariant value;
+    while (!in.atEnd()) {
+        in >> key >> value;
+        if (in.status() != QDataStream::Ok)
+            return false;
+        settingsMap->insert(QSettingsKey(prefix + QString::fromUtf8(key), IniCaseSensitivity),
+                            value);
+    }
+    return true;
+}
+
+/*
+    Encodes the parsed keys of \a map, together with the sections that are
+    still in \a unparsedSections. The latter are updated to point into the
+    returned data.
+*/
+QByteArray QConfFileSettingsPrivate::writeBinaryFile(const ParsedSettingsMap &map,
+                                                     UnparsedSettingsMap *unparsedSections)
+{
+    // group the keys by their top-level section
+    using Key = std::pair<QString, ParsedSettingsMap::const_iterator>;
+    QList<Key> keys;
+    keys.reserve(map.size());
+    for (auto i = map.cbegin(); i != map.cend(); ++i) {
+        const QString key = i.key().originalCaseKey();
+        const qsizetype slashPos = key.indexOf(u'/');
+        keys.append(Key(slashPos == -1 ? QString() : key.left(slashPos + 1), i));
+    }
+    std::stable_sort(keys.begin(), keys.end(), [](const Key &lhs, const Key &rhs) {
+        return lhs.first < rhs.first;
+    });
+
+    QMap<QString, QByteArray> sections;
+    for (auto i = keys.cbegin(); i != keys.cend(); ) {
+        const QString &name = i->first;
+        QByteArray &sectionData = sections[name];
+        QDataStream out(&sectionData, QIODevice::WriteOnly);
+        out.setVersion(binarySettingsVersion);
+        for (; i != keys.cend() && i->first == name; ++i)
+            out << QStringView(i->second.key().originalCaseKey()).sliced(name.size()).toUtf8()
+                << i->second.value();
+    }
+    for (auto i = unparsedSections->cbegin(); i != unparsedSections->cend(); ++i)
+        sections.insert(i.key().originalCaseKey(), i.value());
+
+    QByteArray result;
+    qint64 start;
+    {
+        QDataStream out(&result, QIODevice::WriteOnly);
+        out.setVersion(binarySettingsVersion);
+        out.writeRawData(binarySettingsMagic, sizeof(binarySettingsMagic));
+        out << quint32(sections.size());
+        quint32 offset = 0;
+        for (auto i = sections.cbegin(); i != sections.cend(); ++i) {
+            out << i.key() << offset << quint32(i.value().size());
+            offset += i.value().size();
+        }
+        start = out.device()->pos();
+        for (auto i = sections.cbegin(); i != sections.cend(); ++i)
+            out.writeRawData(i.value().constData(), i.value().size());
+    }
+
+    qint64 offset = start;
+    for (auto i = sections.cbegin(); i != sections.cend(); ++i) {
+        auto unparsed = unparsedSections->find(QSettingsKey(i.key(), IniCaseSensitivity));
+        if (unparsed != unparsedSections->end())
+            *unparsed = QByteArray::fromRawData(result.constData() + offset, i.value().size());
+        offset += i.value().size();
+    }
+    return result;
+}
+#endif // QT_NO_DATASTREAM
+
+bool QConfFileSettingsPrivate::readSection(const QSettingsKey &section, const QByteArray &data,
+                                           ParsedSettingsMap *settingsMap) const
+{
+#ifndef QT_NO_DATASTREAM
+    if (format == QSettings::BinaryFormat)
+        return readBinarySection(section, data, settingsMap);
+#endif
+    return readIniSection(section, data, settingsMap);
+}
+
 void QConfFileSettingsPrivate::ensureAllSectionsParsed(QConfFile *confFile) const
 {
     auto i = confFile->unparsedIniSections.constBegin();
     const auto end = confFile->unparsedIniSections.constEnd();
 
     for (; i != end; ++i) {
-        if (!QConfFileSettingsPrivate::readIniSection(i.key(), i.value(), &confFile->originalKeys))
+        if (!readSection(i.key(), i.value(), &confFile->originalKeys))
             setStatus(QSettings::FormatError);
     }
     confFile->unparsedIniSections.clear();
@@ -1849,7 +2015,7 @@ void QConfFileSettingsPrivate::ensureSectionParsed(QConfFile *confFile,
             return;
     }
 
-    if (!QConfFileSettingsPrivate::readIniSection(i.key(), i.value(), &confFile->originalKeys))
+    if (!readSection(i.key(), i.value(), &confFile->originalKeys))
         setStatus(QSettings::FormatError);
     confFile->unparsedIniSections.erase(i);
 }
@@ -2362,6 +2528,13 @@ void QConfFileSettingsPrivate::ensureSectionParsed(QConfFile *confFile,
                             lose the distinction between numeric data and the
                             strings used to encode them, so values written as
                             numbers shall be read back as QString.
+    \value BinaryFormat     Store the settings in a compact binary file with the
+                            \c .qsettings extension. Values keep their type.
+                            Top-level groups are only decoded when first
+                            accessed, and groups that were not modified are
+                            copied as-is when the file is written back, which
+                            makes this format well suited for large settings
+                            files. This enum value was added in Qt 6.6.
 
     \value InvalidFormat    Special value returned by registerFormat().
     \omitvalue CustomFormat1
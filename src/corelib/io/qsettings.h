@@ -54,6 +54,8 @@ public:
         Registry64Format,
 #endif
 
+        BinaryFormat = 4,
+
 #if defined(Q_OS_WASM)
     // FIXME: add public API in next minor release.
     // WebLocalStorageFormat (IniFormat + 1)
@@ -127,6 +127,8 @@ public:
     QDateTime timeStamp;
     qint64 size;
     UnparsedSettingsMap unparsedIniSections;
+    // contents of a BinaryFormat file; its unparsed sections point into it
+    QByteArray binaryData;
     ParsedSettingsMap originalKeys;
     ParsedSettingsMap addedKeys;
     ParsedSettingsMap removedKeys;
@@ -242,6 +244,13 @@ public:
     static bool readIniLine(QByteArrayView data, qsizetype &dataPos,
                             qsizetype &lineStart, qsizetype &lineLen,
                             qsizetype &equalsPos);
+#ifndef QT_NO_DATASTREAM
+    static bool readBinaryFile(const QByteArray &data, UnparsedSettingsMap *unparsedSections);
+    static bool readBinarySection(const QSettingsKey &section, const QByteArray &data,
+                                  ParsedSettingsMap *settingsMap);
+    static QByteArray writeBinaryFile(const ParsedSettingsMap &map,
+                                      UnparsedSettingsMap *unparsedSections);
+#endif
 
 private:
     void initFormat();
@@ -252,6 +261,8 @@ private:
     bool readPlistFile(const QByteArray &data, ParsedSettingsMap *map) const;
     bool writePlistFile(QIODevice &file, const ParsedSettingsMap &map) const;
 #endif
+    bool readSection(const QSettingsKey &section, const QByteArray &data,
+                     ParsedSettingsMap *settingsMap) const;
     void ensureAllSectionsParsed(QConfFile *confFile) const;
     void ensureSectionParsed(QConfFile *confFile, const QSettingsKey &key) const;
 
@@ -8,7 +8,14 @@
 #include <qendian.h>
 #include <qdebug.h>
 #include <qdir.h>
+#include <qhash.h>
+#if QT_CONFIG(thread)
+#include <qsemaphore.h>
+#include <qthreadpool.h>
+#endif
 
+#include <deque>
+#include <limits>
 #include <memory>
 
 #include <zlib.h>
@@ -478,11 +485,172 @@ public:
     {
     }
 
+    struct EntryData
+    {
+        qint64 offset;
+        qint64 compressedSize;
+        qint64 uncompressedSize;
+        int compressionMethod;
+    };
+
     void scanFiles();
+    int indexOf(const QString &fileName);
+    bool findEntryData(const QString &fileName, EntryData *entry);
+    void unmapArchive();
 
     QZipReader::Status status;
+    // archive file mapped into memory, if the device allows it
+    const uchar *mappedData = nullptr;
+    qint64 mappedSize = 0;
+    QHash<QString, int> fileIndex;
+};
+
+/*
+    Reads the data of a single archive entry, inflating it incrementally
+    when it is compressed. The compressed data is taken straight from the
+    mapped archive when available, otherwise it is read from the archive
+    device in chunks.
+*/
+class QZipEntryDevice : public QIODevice
+{
+public:
+    QZipEntryDevice(QIODevice *archive, const uchar *mappedData,
+                    const QZipReaderPrivate::EntryData &entry);
+    ~QZipEntryDevice();
+
+    bool isSequential() const override { return true; }
+    qint64 bytesAvailable() const override;
+
+protected:
+    qint64 readData(char *data, qint64 maxlen) override;
+    qint64 writeData(const char *, qint64) override { return -1; }
+
+private:
+    qint64 readInput(char *data, qint64 maxlen);
+    void setCorrupted();
+
+    QIODevice *archive;
+    const uchar *mappedData;
+    qint64 inputPos;
+    qint64 inputEnd;
+    qint64 uncompressedSize;
+    qint64 produced = 0;
+    QByteArray inputBuffer;
+    z_stream stream;
+    bool deflated;
+    bool finished = false;
 };
 
+QZipEntryDevice::QZipEntryDevice(QIODevice *archive, const uchar *mappedData,
+                                 const QZipReaderPrivate::EntryData &entry)
+    : archive(archive),
+      mappedData(mappedData),
+      inputPos(entry.offset),
+      inputEnd(entry.offset + entry.compressedSize),
+      uncompressedSize(entry.uncompressedSize),
+      deflated(entry.compressionMethod == CompressionMethodDeflated)
+{
+    memset(&stream, 0, sizeof(stream));
+    if (deflated && inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+        qWarning("QZip: Z_MEM_ERROR: Not enough memory");
+        finished = true;
+    }
+    open(QIODevice::ReadOnly);
+}
+
+QZipEntryDevice::~QZipEntryDevice()
+{
+    if (deflated)
+        inflateEnd(&stream);
+}
+
+qint64 QZipEntryDevice::bytesAvailable() const
+{
+    const qint64 pending = finished ? 0 : qMax(uncompressedSize - produced, qint64(0));
+    return pending + QIODevice::bytesAvailable();
+}
+
+qint64 QZipEntryDevice::readInput(char *data, qint64 maxlen)
+{
+    const qint64 length = qMin(maxlen, inputEnd - inputPos);
+    if (length <= 0)
+        return 0;
+    if (mappedData) {
+        memcpy(data, mappedData + inputPos, length);
+        inputPos += length;
+        return length;
+    }
+    if (!archive->seek(inputPos))
+        return -1;
+    const qint64 readBytes = archive->read(data, length);
+    if (readBytes > 0)
+        inputPos += readBytes;
+    return readBytes;
+}
+
+void QZipEntryDevice::setCorrupted()
+{
+    qWarning("QZip: Z_DATA_ERROR: Input data is corrupted");
+    setErrorString(QStringLiteral("Corrupted zip entry data"));
+    finished = true;
+}
+
+qint64 QZipEntryDevice::readData(char *data, qint64 maxlen)
+{
+    if (finished)
+        return -1;
+
+    if (!deflated) {
+        const qint64 readBytes = readInput(data, qMin(maxlen, uncompressedSize - produced));
+        if (readBytes <= 0) {
+            finished = true;
+            return -1;
+        }
+        produced += readBytes;
+        if (produced == uncompressedSize)
+            finished = true;
+        return readBytes;
+    }
+
+    stream.next_out = reinterpret_cast<Bytef *>(data);
+    stream.avail_out = uInt(qMin(maxlen, qint64(std::numeric_limits<uInt>::max())));
+    while (stream.avail_out > 0 && !finished) {
+        if (stream.avail_in == 0) {
+            const qint64 chunk = qMin(inputEnd - inputPos, qint64(std::numeric_limits<uInt>::max()));
+            if (chunk <= 0) {
+                setCorrupted(); // the deflate stream is truncated
+                break;
+            }
+            if (mappedData) {
+                stream.next_in = const_cast<Bytef *>(mappedData + inputPos);
+                stream.avail_in = uInt(chunk);
+                inputPos += chunk;
+            } else {
+                inputBuffer.resize(qMin(chunk, qint64(16384)));
+                const qint64 readBytes = readInput(inputBuffer.data(), inputBuffer.size());
+                if (readBytes <= 0) {
+                    setCorrupted();
+                    break;
+                }
+                stream.next_in = reinterpret_cast<Bytef *>(inputBuffer.data());
+                stream.avail_in = uInt(readBytes);
+            }
+        }
+
+        const int res = ::inflate(&stream, Z_NO_FLUSH);
+        if (res == Z_STREAM_END)
+            finished = true;
+        else if (res != Z_OK && !(res == Z_BUF_ERROR && stream.avail_in == 0))
+            setCorrupted();
+    }
+
+    const qint64 readBytes = reinterpret_cast<char *>(stream.next_out) - data;
+    produced += readBytes;
+    if (readBytes == 0 && finished)
+        return -1;
+    return readBytes;
+}
+
 class QZipWriterPrivate : public QZipPrivate
 {
 public:
@@ -500,7 +668,27 @@ public:
 
     enum EntryType { Directory, File, Symlink };
 
+    struct Entry
+    {
+        FileHeader header;
+        QByteArray data; // as stored in the archive
+#if QT_CONFIG(thread)
+        QSemaphore ready;
+#endif
+    };
+
     void addEntry(EntryType type, const QString &fileName, const QByteArray &contents);
+    static void compressEntry(Entry *entry, const QByteArray &contents,
+                              QZipWriter::CompressionPolicy compression);
+    void writeEntry(Entry *entry);
+
+#if QT_CONFIG(thread)
+    void writePendingEntries(qsizetype keep = 0);
+
+    QThreadPool *threadPool = nullptr;
+    // entries being compressed by the pool, in archive order
+    std::deque<std::unique_ptr<Entry>> pendingEntries;
+#endif
 };
 
 static LocalFileHeader toLocalHeader(const CentralFileHeader &ch)
@@ -606,6 +794,83 @@ void QZipReaderPrivate::scanFiles()
         ZDEBUG("found file '%s'", header.file_name.data());
         fileHeaders.append(header);
     }
+
+    // Entry data is read straight from the mapping when the archive is a file.
+    if (QFileDevice *file = qobject_cast<QFileDevice *>(device)) {
+        const qint64 size = file->size();
+        if (size > 0 && (mappedData = file->map(0, size)))
+            mappedSize = size;
+    }
+}
+
+int QZipReaderPrivate::indexOf(const QString &fileName)
+{
+    scanFiles();
+    if (fileIndex.isEmpty() && !fileHeaders.isEmpty()) {
+        fileIndex.reserve(fileHeaders.size());
+        // iterate backwards, so that the first entry with a given name wins
+        for (qsizetype i = fileHeaders.size() - 1; i >= 0; --i)
+            fileIndex.insert(QString::fromLocal8Bit(fileHeaders.at(i).file_name), int(i));
+    }
+    return fileIndex.value(fileName, -1);
+}
+
+bool QZipReaderPrivate::findEntryData(const QString &fileName, EntryData *entry)
+{
+    const int i = indexOf(fileName);
+    if (i < 0)
+        return false;
+
+    const FileHeader &header = fileHeaders.at(i);
+
+    ushort version_needed = readUShort(header.h.version_needed);
+    if (version_needed > ZIP_VERSION) {
+        qWarning("QZip: .ZIP specification version %d implementationis needed to extract the data.", version_needed);
+        return false;
+    }
+
+    ushort general_purpose_bits = readUShort(header.h.general_purpose_bits);
+    if ((general_purpose_bits & Encrypted) != 0) {
+        qWarning("QZip: Unsupported encryption method is needed to extract the data.");
+        return false;
+    }
+
+    const qint64 start = readUInt(header.h.offset_local_header);
+    LocalFileHeader lh;
+    if (mappedData) {
+        if (start + qint64(sizeof(LocalFileHeader)) > mappedSize)
+            return false;
+        memcpy(&lh, mappedData + start, sizeof(LocalFileHeader));
+    } else {
+        device->seek(start);
+        if (device->read((char *)&lh, sizeof(LocalFileHeader)) != qint64(sizeof(LocalFileHeader)))
+            return false;
+    }
+    const uint skip = readUShort(lh.file_name_length) + readUShort(lh.extra_field_length);
+
+    entry->offset = start + sizeof(LocalFileHeader) + skip;
+    entry->compressedSize = readUInt(header.h.compressed_size);
+    entry->uncompressedSize = readUInt(header.h.uncompressed_size);
+    entry->compressionMethod = readUShort(lh.compression_method);
+    if (mappedData)
+        entry->compressedSize = qBound(qint64(0), mappedSize - entry->offset, entry->compressedSize);
+
+    if (entry->compressionMethod != CompressionMethodStored
+            && entry->compressionMethod != CompressionMethodDeflated) {
+        qWarning("QZip: Unsupported compression method %d is needed to extract the data.", entry->compressionMethod);
+        return false;
+    }
+    return true;
+}
+
+void QZipReaderPrivate::unmapArchive()
+{
+    if (mappedData) {
+        if (QFileDevice *file = qobject_cast<QFileDevice *>(device))
+            file->unmap(const_cast<uchar *>(mappedData));
+        mappedData = nullptr;
+        mappedSize = 0;
+    }
 }
 
 void QZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const QByteArray &contents/*, QFile::Permissions permissions, QZip::Method m*/)
@@ -622,7 +887,6 @@ void QZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const
         status = QZipWriter::FileOpenError;
         return;
     }
-    device->seek(start_of_directory);
 
     // don't compress small files
     QZipWriter::CompressionPolicy compression = compressionPolicy;
@@ -633,44 +897,13 @@ void QZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const
             compression = QZipWriter::AlwaysCompress;
     }
 
-    FileHeader header;
+    auto entry = std::make_unique<Entry>();
+    FileHeader &header = entry->header;
     memset(&header.h, 0, sizeof(CentralFileHeader));
     writeUInt(header.h.signature, 0x02014b50);
 
     writeUShort(header.h.version_needed, ZIP_VERSION);
-    writeUInt(header.h.uncompressed_size, contents.size());
     writeMSDosDate(header.h.last_mod_file, QDateTime::currentDateTime());
-    QByteArray data = contents;
-    if (compression == QZipWriter::AlwaysCompress) {
-        writeUShort(header.h.compression_method, CompressionMethodDeflated);
-
-       ulong len = contents.size();
-        // shamelessly copied form zlib
-        len += (len >> 12) + (len >> 14) + 11;
-        int res;
-        do {
-            data.resize(len);
-            res = deflate((uchar*)data.data(), &len, (const uchar*)contents.constData(), contents.size());
-
-            switch (res) {
-            case Z_OK:
-                data.resize(len);
-                break;
-            case Z_MEM_ERROR:
-                qWarning("QZip: Z_MEM_ERROR: Not enough memory to compress file, skipping");
-                data.resize(0);
-                break;
-            case Z_BUF_ERROR:
-                len *= 2;
-                break;
-            }
-        } while (res == Z_BUF_ERROR);
-    }
-// TODO add a check if data.length() > contents.length().  Then try to store the original and revert the compression method to be uncompressed
-    writeUInt(header.h.compressed_size, data.size());
-    uint crc_32 = ::crc32(0, nullptr, 0);
-    crc_32 = ::crc32(crc_32, (const uchar *)contents.constData(), contents.size());
-    writeUInt(header.h.crc_32, crc_32);
 
     // if bit 11 is set, the filename and comment fields must be encoded using UTF-8
     ushort general_purpose_bits = Utf8Names; // always use utf-8
@@ -708,19 +941,93 @@ void QZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const
         break;
     }
     writeUInt(header.h.external_file_attributes, mode << 16);
-    writeUInt(header.h.offset_local_header, start_of_directory);
 
+#if QT_CONFIG(thread)
+    if (threadPool) {
+        // Compress on the pool; entries are still written in the order they were added.
+        Entry *e = entry.get();
+        threadPool->start([e, contents, compression] {
+            compressEntry(e, contents, compression);
+            e->ready.release();
+        });
+        pendingEntries.push_back(std::move(entry));
+        // bound the amount of compressed data held in memory
+        writePendingEntries(2 * qMax(threadPool->maxThreadCount(), 1));
+        return;
+    }
+    writePendingEntries();
+#endif
+
+    compressEntry(entry.get(), contents, compression);
+    writeEntry(entry.get());
+}
+
+void QZipWriterPrivate::compressEntry(Entry *entry, const QByteArray &contents,
+                                      QZipWriter::CompressionPolicy compression)
+{
+    FileHeader &header = entry->header;
+    writeUInt(header.h.uncompressed_size, contents.size());
+    QByteArray data = contents;
+    if (compression == QZipWriter::AlwaysCompress) {
+        writeUShort(header.h.compression_method, CompressionMethodDeflated);
+
+       ulong len = contents.size();
+        // shamelessly copied form zlib
+        len += (len >> 12) + (len >> 14) + 11;
+        int res;
+        do {
+            data.resize(len);
+            res = deflate((uchar*)data.data(), &len, (const uchar*)contents.constData(), contents.size());
+
+            switch (res) {
+            case Z_OK:
+                data.resize(len);
+                break;
+            case Z_MEM_ERROR:
+                qWarning("QZip: Z_MEM_ERROR: Not enough memory to compress file, skipping");
+                data.resize(0);
+                break;
+            case Z_BUF_ERROR:
+                len *= 2;
+                break;
+            }
+        } while (res == Z_BUF_ERROR);
+    }
+// TODO add a check if data.length() > contents.length().  Then try to store the original and revert the compression method to be uncompressed
+    writeUInt(header.h.compressed_size, data.size());
+    uint crc_32 = ::crc32(0, nullptr, 0);
+    crc_32 = ::crc32(crc_32, (const uchar *)contents.constData(), contents.size());
+    writeUInt(header.h.crc_32, crc_32);
+    entry->data = std::move(data);
+}
+
+void QZipWriterPrivate::writeEntry(Entry *entry)
+{
+    FileHeader &header = entry->header;
+    device->seek(start_of_directory);
+    writeUInt(header.h.offset_local_header, start_of_directory);
 
     fileHeaders.append(header);
 
     LocalFileHeader h = toLocalHeader(header.h);
-    device->write((const char *)&h, sizeof(LocalFileHeader));
-    device->write(header.file_name);
-    device->write(data);
+    device->write({ QByteArrayView(reinterpret_cast<const char *>(&h), sizeof(LocalFileHeader)),
+                    header.file_name, entry->data });
     start_of_directory = device->pos();
     dirtyFileTree = true;
 }
 
+#if QT_CONFIG(thread)
+void QZipWriterPrivate::writePendingEntries(qsizetype keep)
+{
+    while (qsizetype(pendingEntries.size()) > keep) {
+        Entry *entry = pendingEntries.front().get();
+        entry->ready.acquire();
+        writeEntry(entry);
+        pendingEntries.pop_front();
+    }
+}
+#endif
+
 //////////////////////////////  Reader
 
 /*!
@@ -898,82 +1205,76 @@ QZipReader::FileInfo QZipReader::entryInfoAt(int index) const
 */
 QByteArray QZipReader::fileData(const QString &fileName) const
 {
-    d->scanFiles();
-    int i;
-    for (i = 0; i < d->fileHeaders.size(); ++i) {
-        if (QString::fromLocal8Bit(d->fileHeaders.at(i).file_name) == fileName)
-            break;
-    }
-    if (i == d->fileHeaders.size())
+    QZipReaderPrivate::EntryData entry;
+    if (!d->findEntryData(fileName, &entry))
         return QByteArray();
 
-    FileHeader header = d->fileHeaders.at(i);
+    //qDebug("file=%s: compressed_size=%lld, uncompressed_size=%lld", fileName.toLocal8Bit().data(), entry.compressedSize, entry.uncompressedSize);
 
-    ushort version_needed = readUShort(header.h.version_needed);
-    if (version_needed > ZIP_VERSION) {
-        qWarning("QZip: .ZIP specification version %d implementationis needed to extract the data.", version_needed);
-        return QByteArray();
+    if (entry.compressionMethod == CompressionMethodStored) {
+        // no compression
+        const qint64 size = qMin(entry.compressedSize, entry.uncompressedSize);
+        if (d->mappedData)
+            return QByteArray(reinterpret_cast<const char *>(d->mappedData + entry.offset), size);
+        d->device->seek(entry.offset);
+        return d->device->read(size);
     }
 
-    ushort general_purpose_bits = readUShort(header.h.general_purpose_bits);
-    int compressed_size = readUInt(header.h.compressed_size);
-    int uncompressed_size = readUInt(header.h.uncompressed_size);
-    int start = readUInt(header.h.offset_local_header);
-    //qDebug("uncompressing file %d: local header at %d", i, start);
-
-    d->device->seek(start);
-    LocalFileHeader lh;
-    d->device->read((char *)&lh, sizeof(LocalFileHeader));
-    uint skip = readUShort(lh.file_name_length) + readUShort(lh.extra_field_length);
-    d->device->seek(d->device->pos() + skip);
-
-    int compression_method = readUShort(lh.compression_method);
-    //qDebug("file=%s: compressed_size=%d, uncompressed_size=%d", fileName.toLocal8Bit().data(), compressed_size, uncompressed_size);
-
-    if ((general_purpose_bits & Encrypted) != 0) {
-        qWarning("QZip: Unsupported encryption method is needed to extract the data.");
-        return QByteArray();
+    // Deflate, straight from the mapped archive when possible
+    QByteArray compressed;
+    const uchar *source = d->mappedData ? d->mappedData + entry.offset : nullptr;
+    if (!source) {
+        d->device->seek(entry.offset);
+        compressed = d->device->read(entry.compressedSize);
+        source = reinterpret_cast<const uchar *>(compressed.constData());
     }
+    //qDebug("compressed=%lld", entry.compressedSize);
+    QByteArray baunzip;
+    ulong len = qMax(entry.uncompressedSize, qint64(1));
+    int res;
+    do {
+        baunzip.resize(len);
+        res = inflate((uchar*)baunzip.data(), &len, source, entry.compressedSize);
+
+        switch (res) {
+        case Z_OK:
+            if ((int)len != baunzip.size())
+                baunzip.resize(len);
+            break;
+        case Z_MEM_ERROR:
+            qWarning("QZip: Z_MEM_ERROR: Not enough memory");
+            break;
+        case Z_BUF_ERROR:
+            len *= 2;
+            break;
+        case Z_DATA_ERROR:
+            qWarning("QZip: Z_DATA_ERROR: Input data is corrupted");
+            break;
+        }
+    } while (res == Z_BUF_ERROR);
+    return baunzip;
+}
 
-    //qDebug("file at %lld", d->device->pos());
-    QByteArray compressed = d->device->read(compressed_size);
-    if (compression_method == CompressionMethodStored) {
-        // no compression
-        compressed.truncate(uncompressed_size);
-        return compressed;
-    } else if (compression_method == CompressionMethodDeflated) {
-        // Deflate
-        //qDebug("compressed=%d", compressed.size());
-        compressed.truncate(compressed_size);
-        QByteArray baunzip;
-        ulong len = qMax(uncompressed_size,  1);
-        int res;
-        do {
-            baunzip.resize(len);
-            res = inflate((uchar*)baunzip.data(), &len,
-                          (const uchar*)compressed.constData(), compressed_size);
+/*!
+    \since 6.6
 
-            switch (res) {
-            case Z_OK:
-                if ((int)len != baunzip.size())
-                    baunzip.resize(len);
-                break;
-            case Z_MEM_ERROR:
-                qWarning("QZip: Z_MEM_ERROR: Not enough memory");
-                break;
-            case Z_BUF_ERROR:
-                len *= 2;
-                break;
-            case Z_DATA_ERROR:
-                qWarning("QZip: Z_DATA_ERROR: Input data is corrupted");
-                break;
-            }
-        } while (res == Z_BUF_ERROR);
-        return baunzip;
-    }
+    Returns a sequential, read-only device that delivers the uncompressed
+    contents of \a fileName, or \nullptr if the archive does not contain it.
+
+    Unlike fileData(), the entry is inflated incrementally as it is read,
+    so arbitrarily large entries can be processed with bounded memory. When
+    the archive is a file the compressed data is read from a memory mapping.
 
-    qWarning("QZip: Unsupported compression method %d is needed to extract the data.", compression_method);
-    return QByteArray();
+    The returned device refers to this reader and must not outlive it, nor be
+    used after close(). Reading from several entry devices at once is fine,
+    as long as they are all used from the same thread.
+*/
+std::unique_ptr<QIODevice> QZipReader::fileDevice(const QString &fileName) const
+{
+    QZipReaderPrivate::EntryData entry;
+    if (!d->findEntryData(fileName, &entry))
+        return nullptr;
+    return std::make_unique<QZipEntryDevice>(d->device, d->mappedData, entry);
 }
 
 /*!
@@ -1077,6 +1378,7 @@ QZipReader::Status QZipReader::status() const
 */
 void QZipReader::close()
 {
+    d->unmapArchive();
     d->device->close();
 }
 
@@ -1242,6 +1544,41 @@ QFile::Permissions QZipWriter::creationPermissions() const
     return d->permissions;
 }
 
+#if QT_CONFIG(thread)
+/*!
+    \since 6.6
+
+    Sets the thread pool used to compress added files to \a pool.
+
+    With a thread pool, addFile() hands the compression off to \a pool and
+    returns early; the entries are still stored in the order they were added.
+    At most twice the pool's maximum thread count of entries are compressed
+    ahead of being written. Passing \nullptr, the default, compresses every
+    file in the calling thread.
+
+    The pool must stay alive until close() has returned.
+
+    \sa threadPool()
+*/
+void QZipWriter::setThreadPool(QThreadPool *pool)
+{
+    d->threadPool = pool;
+}
+
+/*!
+    \since 6.6
+
+    Returns the thread pool used to compress added files, or \nullptr if
+    files are compressed in the calling thread.
+
+    \sa setThreadPool()
+*/
+QThreadPool *QZipWriter::threadPool() const
+{
+    return d->threadPool;
+}
+#endif
+
 /*!
     Add a file to the archive with \a data as the file contents.
     The file will be stored in the archive using the \a fileName which
@@ -1311,6 +1648,9 @@ void QZipWriter::addSymLink(const QString &fileName, const QString &destination)
 */
 void QZipWriter::close()
 {
+#if QT_CONFIG(thread)
+    d->writePendingEntries();
+#endif
     if (!(d->device->openMode() & QIODevice::WriteOnly)) {
         d->device->close();
         return;
@@ -18,6 +18,7 @@
 #include <qbitarray.h>
 #include <qdatetime.h>
 #include <qloggingcategory.h>
+#include <qvarlengtharray.h>
 
 #include <limits.h>
 
@@ -2993,6 +2994,37 @@ bool QAbstractItemModelPrivate::allowMove(const QModelIndex &srcParent, int star
  */
 void QAbstractItemModelPrivate::executePendingOperations() const { }
 
+/*!
+    \internal
+
+    Fills \a roleDataSpan with one multiData() call for each item from
+    \a topLeft to \a bottomRight. Models that can do better reimplement this
+    function, see QAbstractItemModel::blockData().
+*/
+void QAbstractItemModelPrivate::blockData(const QModelIndex &topLeft,
+                                          const QModelIndex &bottomRight,
+                                          QModelRoleDataSpan roleDataSpan) const
+{
+    Q_Q(const QAbstractItemModel);
+    const qsizetype itemCount = blockItemCount(topLeft, bottomRight);
+    const qsizetype roleCount = roleDataSpan.size() / itemCount;
+    QVarLengthArray<QModelRoleData, 16> itemData;
+    itemData.reserve(roleCount);
+    for (qsizetype role = 0; role < roleCount; ++role)
+        itemData.emplace_back(roleDataSpan[role * itemCount].role());
+
+    const QModelIndex parent = topLeft.parent();
+    qsizetype item = 0;
+    for (int row = topLeft.row(); row <= bottomRight.row(); ++row) {
+        for (int column = topLeft.column(); column <= bottomRight.column(); ++column, ++item) {
+            q->multiData(q->index(row, column, parent), itemData);
+            // swapping lets the next multiData() call reuse the old values
+            for (qsizetype role = 0; role < roleCount; ++role)
+                roleDataSpan[role * itemCount + item].data().swap(itemData[role].data());
+        }
+    }
+}
+
 /*!
     \since 4.6
 
@@ -3671,6 +3703,51 @@ void QAbstractItemModel::multiData(const QModelIndex &index, QModelRoleDataSpan
         d.setData(data(index, d.role()));
 }
 
+/*!
+    \since 6.6
+
+    Fills the \a roleDataSpan with the requested data for all the items from
+    \a topLeft to \a bottomRight, which must have the same parent.
+
+    The span holds one column of elements for each role, one after the other.
+    Each column has one element for each item of the block, row after row, and
+    all its elements have the same role. For a block of \c rows times
+    \c columns items, the data for the \c{k}th role of the item at
+    (\c row, \c column) is therefore stored at the position
+    \c{(k * rows + row - topLeft.row()) * columns + column - topLeft.column()}
+    of the span:
+
+    \snippet code/src_corelib_kernel_qabstractitemmodel.cpp 17
+
+    This is equivalent to calling multiData() for each item of the block with
+    the roles of the columns, but the models and proxy models of Qt can
+    provide the data of a whole block faster, for instance by calling the
+    source model only once. Like for multiData(), the span may be reused in
+    the next calls, which avoids allocating the data again.
+
+    \note The models of Qt only take these shortcuts when they are not
+    subclassed, as a subclass may reimplement data(). Such subclasses must use
+    the Q_OBJECT macro.
+
+    \note It is illegal to pass invalid model indexes to this function.
+
+    \sa multiData(), QModelRoleDataSpan
+*/
+void QAbstractItemModel::blockData(const QModelIndex &topLeft, const QModelIndex &bottomRight,
+                                   QModelRoleDataSpan roleDataSpan) const
+{
+    Q_D(const QAbstractItemModel);
+    Q_ASSERT(checkIndex(topLeft, CheckIndexOption::IndexIsValid));
+    Q_ASSERT(checkIndex(bottomRight, CheckIndexOption::IndexIsValid));
+    Q_ASSERT(topLeft.parent() == bottomRight.parent());
+    Q_ASSERT(topLeft.row() <= bottomRight.row() && topLeft.column() <= bottomRight.column());
+    Q_ASSERT(roleDataSpan.size() % d->blockItemCount(topLeft, bottomRight) == 0);
+
+    if (!roleDataSpan.size())
+        return;
+    d->blockData(topLeft, bottomRight, roleDataSpan);
+}
+
 /*!
     \class QAbstractTableModel
     \inmodule QtCore
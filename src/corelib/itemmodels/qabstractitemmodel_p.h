@@ -66,6 +66,15 @@ public:
     // ugly hack for QTreeModel, see QTBUG-94546
     virtual void executePendingOperations() const;
 
+    // see QAbstractItemModel::blockData(); the arguments have been checked
+    virtual void blockData(const QModelIndex &topLeft, const QModelIndex &bottomRight,
+                           QModelRoleDataSpan roleDataSpan) const;
+    static qsizetype blockItemCount(const QModelIndex &topLeft, const QModelIndex &bottomRight)
+    {
+        return qsizetype(bottomRight.row() - topLeft.row() + 1)
+                * (bottomRight.column() - topLeft.column() + 1);
+    }
+
     inline QModelIndex createIndex(int row, int column, void *data = nullptr) const {
         return q_func()->createIndex(row, column, data);
     }
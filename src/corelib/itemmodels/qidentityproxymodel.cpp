@@ -373,6 +373,24 @@ void QIdentityProxyModel::setSourceModel(QAbstractItemModel* newSourceModel)
     endResetModel();
 }
 
+/*!
+    \internal
+
+    Gets the data of the whole block from the source model, unless a subclass
+    may provide other data than it.
+*/
+void QIdentityProxyModelPrivate::blockData(const QModelIndex &topLeft,
+                                           const QModelIndex &bottomRight,
+                                           QModelRoleDataSpan roleDataSpan) const
+{
+    Q_Q(const QIdentityProxyModel);
+    if (q->metaObject() != &QIdentityProxyModel::staticMetaObject) {
+        QAbstractProxyModelPrivate::blockData(topLeft, bottomRight, roleDataSpan);
+        return;
+    }
+    model->blockData(q->mapToSource(topLeft), q->mapToSource(bottomRight), roleDataSpan);
+}
+
 void QIdentityProxyModelPrivate::_q_sourceColumnsAboutToBeInserted(const QModelIndex &parent, int start, int end)
 {
     Q_ASSERT(parent.isValid() ? parent.model() == model : true);
@@ -55,6 +55,8 @@ public:
     void _q_sourceModelAboutToBeReset();
     void _q_sourceModelReset();
 
+    void blockData(const QModelIndex &topLeft, const QModelIndex &bottomRight,
+                   QModelRoleDataSpan roleDataSpan) const override;
 };
 
 QT_END_NAMESPACE
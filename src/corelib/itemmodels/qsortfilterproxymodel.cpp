@@ -6,13 +6,19 @@
 #include <qsize.h>
 #include <qdebug.h>
 #include <qdatetime.h>
+#include <qdeadlinetimer.h>
 #include <qpair.h>
 #include <qstringlist.h>
 #include <private/qabstractitemmodel_p.h>
 #include <private/qabstractproxymodel_p.h>
 #include <private/qproperty_p.h>
+#if QT_CONFIG(thread)
+#include <qsemaphore.h>
+#include <qthreadpool.h>
+#endif
 
 #include <algorithm>
+#include <numeric>
 
 QT_BEGIN_NAMESPACE
 
@@ -78,6 +84,88 @@ private:
 };
 
 
+// The number of rows from which the parallel mode uses more than one thread
+static constexpr qsizetype ParallelRowCount = 10000;
+// The number of rows each thread takes at once while filtering
+static constexpr qsizetype ParallelChunkSize = 1024;
+// The number of rows checked at once by a time-sliced filter change
+static constexpr qsizetype FilterSliceRowCount = 256;
+
+// Calls work(i) for each i in [0, count) on the calling thread and on the
+// free threads of the global thread pool
+template <typename F>
+static void runInParallel(qsizetype count, F work)
+{
+    QAtomicInteger<qsizetype> next = 0;
+    const auto run = [&] {
+        for (qsizetype i = next.fetchAndAddRelaxed(1); i < count; i = next.fetchAndAddRelaxed(1))
+            work(i);
+    };
+
+#if QT_CONFIG(thread)
+    // Only start helpers on threads that are free, as the calling thread may
+    // itself be one of the pool
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const qsizetype maxHelpers = qMin(qsizetype(pool->maxThreadCount()), count) - 1;
+    QSemaphore finished;
+    int helpers = 0;
+    while (helpers < maxHelpers && pool->tryStart([&] { run(); finished.release(); }))
+        ++helpers;
+    run();
+    finished.acquire(helpers);
+#else
+    run();
+#endif
+}
+
+static int parallelThreadCount(qsizetype count)
+{
+#if QT_CONFIG(thread)
+    if (count >= ParallelRowCount)
+        return qMax(QThreadPool::globalInstance()->maxThreadCount(), 1);
+#else
+    Q_UNUSED(count);
+#endif
+    return 1;
+}
+
+// Sorts the items like std::stable_sort(), sorting one part of them on each
+// thread and then merging the parts in parallel
+template <typename LessThan>
+static void parallelStableSort(QList<int> &items, LessThan lessThan)
+{
+    const qsizetype count = items.size();
+    const int threadCount = parallelThreadCount(count);
+    if (threadCount == 1) {
+        std::stable_sort(items.begin(), items.end(), lessThan);
+        return;
+    }
+
+    int *data = items.data();
+    const qsizetype partSize = (count + threadCount - 1) / threadCount;
+    runInParallel(threadCount, [&](qsizetype part) {
+        const qsizetype begin = qMin(part * partSize, count);
+        std::stable_sort(data + begin, data + qMin(begin + partSize, count), lessThan);
+    });
+
+    QList<int> buffer(count);
+    int *from = data;
+    int *to = buffer.data();
+    for (qsizetype width = partSize; width < count; width *= 2) {
+        runInParallel((count + 2 * width - 1) / (2 * width), [&](qsizetype merge) {
+            const qsizetype begin = merge * 2 * width;
+            const qsizetype middle = qMin(begin + width, count);
+            const qsizetype end = qMin(begin + 2 * width, count);
+            // std::merge() takes the equal items from the first range first
+            std::merge(from + begin, from + middle, from + middle, from + end, to + begin,
+                       lessThan);
+        });
+        std::swap(from, to);
+    }
+    if (from != data)
+        std::copy(from, from + count, data);
+}
+
 //this struct is used to store what are the rows that are removed
 //between a call to rowsAboutToBeRemoved and rowsRemoved
 //it avoids readding rows to the mapping that are currently being removed
@@ -184,6 +272,17 @@ public:
     int proxy_sort_column = -1;
     Qt::SortOrder sort_order = Qt::AscendingOrder;
     bool complete_insert = false;
+    bool parallel_sortfilter = false;
+    bool incremental_filtering = false;
+    int filter_time_slice = 0;
+    QString filter_fixed_string;
+
+    // The rows of the root that a time-sliced filter change still has to
+    // check: first the mapped ones, then the ones that were filtered out
+    QList<int> pending_filter_rows;
+    qsizetype pending_filter_mapped_count = 0;
+    qsizetype pending_filter_next = 0;
+    bool pending_filter_scheduled = false;
 
     Q_OBJECT_COMPAT_PROPERTY_WITH_ARGS(
             QSortFilterProxyModelPrivate, Qt::CaseSensitivity, sort_casesensitivity,
@@ -333,6 +432,10 @@ public:
     int find_source_sort_column() const;
     void sort_source_rows(QList<int> &source_rows,
                           const QModelIndex &source_parent) const;
+    void sort_source_rows_by_key(QList<int> &source_rows,
+                                 const QModelIndex &source_parent) const;
+    QList<int> filter_source_rows(const QList<int> &source_rows,
+                                  const QModelIndex &source_parent, bool accepted) const;
     QList<QPair<int, QList<int>>> proxy_intervals_for_source_items_to_add(
         const QList<int> &proxy_to_source, const QList<int> &source_items,
         const QModelIndex &source_parent, Qt::Orientation orient) const;
@@ -366,16 +469,27 @@ public:
     void update_persistent_indexes(const QModelIndexPairList &source_indexes);
 
     void filter_about_to_be_changed(const QModelIndex &source_parent = QModelIndex());
-    void filter_changed(Direction dir, const QModelIndex &source_parent = QModelIndex());
+    void filter_changed(Direction dir, const QModelIndex &source_parent = QModelIndex(),
+                        bool refine = false);
     QSet<int> handle_filter_changed(
         QList<int> &source_to_proxy, QList<int> &proxy_to_source,
-        const QModelIndex &source_parent, Qt::Orientation orient);
+        const QModelIndex &source_parent, Qt::Orientation orient, bool refine = false);
+
+    bool has_pending_filter() const { return pending_filter_next < pending_filter_rows.size(); }
+    void start_pending_filter(Mapping *m, bool refine);
+    bool filter_pending_rows(QDeadlineTimer deadline);
+    void schedule_pending_filter();
+    void finish_pending_filter();
+    void cancel_pending_filter();
 
     void updateChildrenMapping(const QModelIndex &source_parent, Mapping *parent_mapping,
                                Qt::Orientation orient, int start, int end, int delta_item_count, bool remove);
 
     void _q_sourceModelDestroyed() override;
 
+    void blockData(const QModelIndex &topLeft, const QModelIndex &bottomRight,
+                   QModelRoleDataSpan roleDataSpan) const override;
+
     bool needsReorder(const QList<int> &source_rows, const QModelIndex &source_parent) const;
 
     bool filterAcceptsRowInternal(int source_row, const QModelIndex &source_parent) const;
@@ -463,6 +577,7 @@ void QSortFilterProxyModelPrivate::_q_clearMapping()
     // store the persistent indexes
     QModelIndexPairList source_indexes = store_persistent_indexes();
 
+    cancel_pending_filter();
     qDeleteAll(source_index_mapping);
     source_index_mapping.clear();
     if (dynamic_sortfilter)
@@ -484,10 +599,16 @@ IndexMap::const_iterator QSortFilterProxyModelPrivate::create_mapping(
     Mapping *m = new Mapping;
 
     int source_rows = model->rowCount(source_parent);
-    m->source_rows.reserve(source_rows);
-    for (int i = 0; i < source_rows; ++i) {
-        if (filterAcceptsRowInternal(i, source_parent))
-            m->source_rows.append(i);
+    if (parallel_sortfilter && source_rows >= ParallelRowCount) {
+        QList<int> all_rows(source_rows);
+        std::iota(all_rows.begin(), all_rows.end(), 0);
+        m->source_rows = filter_source_rows(all_rows, source_parent, true);
+    } else {
+        m->source_rows.reserve(source_rows);
+        for (int i = 0; i < source_rows; ++i) {
+            if (filterAcceptsRowInternal(i, source_parent))
+                m->source_rows.append(i);
+        }
     }
     int source_cols = model->columnCount(source_parent);
     m->source_columns.reserve(source_cols);
@@ -580,6 +701,72 @@ QModelIndex QSortFilterProxyModelPrivate::source_to_proxy(const QModelIndex &sou
     return create_index(proxy_row, proxy_column, it);
 }
 
+/*!
+  \internal
+
+  Gets the data of each run of rows that are consecutive in the source model
+  with one call of its blockData(), unless a subclass may provide other data
+  than the source model.
+*/
+void QSortFilterProxyModelPrivate::blockData(const QModelIndex &topLeft,
+                                             const QModelIndex &bottomRight,
+                                             QModelRoleDataSpan roleDataSpan) const
+{
+    Q_Q(const QSortFilterProxyModel);
+    if (q->metaObject() != &QSortFilterProxyModel::staticMetaObject) {
+        QAbstractProxyModelPrivate::blockData(topLeft, bottomRight, roleDataSpan);
+        return;
+    }
+    IndexMap::const_iterator it = index_to_iterator(topLeft);
+    const Mapping *m = it.value();
+    const QModelIndex &source_parent = it.key();
+
+    // The columns have to be consecutive in the source model too
+    const int column_count = bottomRight.column() - topLeft.column() + 1;
+    const int source_left = m->source_columns.at(topLeft.column());
+    for (int column = 1; column < column_count; ++column) {
+        if (m->source_columns.at(topLeft.column() + column) != source_left + column) {
+            QAbstractProxyModelPrivate::blockData(topLeft, bottomRight, roleDataSpan);
+            return;
+        }
+    }
+
+    const qsizetype item_count = blockItemCount(topLeft, bottomRight);
+    const qsizetype role_count = roleDataSpan.size() / item_count;
+    QList<QModelRoleData> run_data;
+    for (int row = topLeft.row(); row <= bottomRight.row();) {
+        const int source_top = m->source_rows.at(row);
+        int end = row + 1;
+        while (end <= bottomRight.row() && m->source_rows.at(end) == source_top + end - row)
+            ++end;
+        const QModelIndex source_top_left = model->index(source_top, source_left, source_parent);
+        const QModelIndex source_bottom_right = model->index(source_top + end - row - 1,
+                                                             source_left + column_count - 1,
+                                                             source_parent);
+        if (row == topLeft.row() && end > bottomRight.row()) {
+            // the layout of the span is the same in the source model
+            model->blockData(source_top_left, source_bottom_right, roleDataSpan);
+            return;
+        }
+
+        const qsizetype run_item_count = qsizetype(end - row) * column_count;
+        const qsizetype offset = qsizetype(row - topLeft.row()) * column_count;
+        run_data.clear();
+        for (qsizetype role = 0; role < role_count; ++role) {
+            for (qsizetype item = 0; item < run_item_count; ++item)
+                run_data.emplace_back(roleDataSpan[role * item_count].role());
+        }
+        model->blockData(source_top_left, source_bottom_right, run_data);
+        for (qsizetype role = 0; role < role_count; ++role) {
+            for (qsizetype item = 0; item < run_item_count; ++item) {
+                roleDataSpan[role * item_count + offset + item].data().swap(
+                        run_data[role * run_item_count + item].data());
+            }
+        }
+        row = end;
+    }
+}
+
 bool QSortFilterProxyModelPrivate::can_create_mapping(const QModelIndex &source_parent) const
 {
     if (source_parent.isValid()) {
@@ -682,7 +869,9 @@ void QSortFilterProxyModelPrivate::sort_source_rows(
 {
     Q_Q(const QSortFilterProxyModel);
     if (source_sort_column >= 0) {
-        if (sort_order == Qt::AscendingOrder) {
+        if (parallel_sortfilter) {
+            sort_source_rows_by_key(source_rows, source_parent);
+        } else if (sort_order == Qt::AscendingOrder) {
             QSortFilterProxyModelLessThan lt(source_sort_column, source_parent, model, q);
             std::stable_sort(source_rows.begin(), source_rows.end(), lt);
         } else {
@@ -694,6 +883,106 @@ void QSortFilterProxyModelPrivate::sort_source_rows(
     }
 }
 
+/*!
+  \internal
+
+  Sorts the given \a source_rows like sort_source_rows(), but reads the data
+  of each row only once and compares it like the default implementation of
+  lessThan(). The data is read, and the rows are sorted, in parallel when
+  there are many rows.
+*/
+void QSortFilterProxyModelPrivate::sort_source_rows_by_key(
+    QList<int> &source_rows, const QModelIndex &source_parent) const
+{
+    const qsizetype count = source_rows.size();
+    QList<QModelRoleData> keys;
+    keys.reserve(count);
+    for (qsizetype i = 0; i < count; ++i)
+        keys.emplace_back(sort_role);
+    QModelRoleData *key = keys.data();
+    const auto readKeys = [&](qsizetype begin, qsizetype end) {
+        // Get the data of the rows that are consecutive in the source model
+        // at once
+        for (qsizetype i = begin; i < end;) {
+            const int source_top = source_rows.at(i);
+            qsizetype run_end = i + 1;
+            while (run_end < end && source_rows.at(run_end) == source_top + (run_end - i))
+                ++run_end;
+            model->blockData(model->index(source_top, source_sort_column, source_parent),
+                             model->index(source_rows.at(run_end - 1), source_sort_column,
+                                          source_parent),
+                             QModelRoleDataSpan(key + i, run_end - i));
+            i = run_end;
+        }
+    };
+    if (parallelThreadCount(count) > 1) {
+        runInParallel((count + ParallelChunkSize - 1) / ParallelChunkSize, [&](qsizetype chunk) {
+            const qsizetype begin = chunk * ParallelChunkSize;
+            readKeys(begin, qMin(begin + ParallelChunkSize, count));
+        });
+    } else {
+        readKeys(0, count);
+    }
+
+    // Sort the positions of the rows in source_rows
+    QList<int> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    const Qt::CaseSensitivity cs = sort_casesensitivity;
+    const bool localeAware = sort_localeaware;
+    if (sort_order == Qt::AscendingOrder) {
+        parallelStableSort(order, [&](int left, int right) {
+            return QAbstractItemModelPrivate::isVariantLessThan(key[left].data(),
+                                                                key[right].data(), cs,
+                                                                localeAware);
+        });
+    } else {
+        parallelStableSort(order, [&](int left, int right) {
+            return QAbstractItemModelPrivate::isVariantLessThan(key[right].data(),
+                                                                key[left].data(), cs,
+                                                                localeAware);
+        });
+    }
+
+    const QList<int> unsorted = source_rows;
+    for (qsizetype i = 0; i < count; ++i)
+        source_rows[i] = unsorted.at(order.at(i));
+}
+
+/*!
+  \internal
+
+  Returns the rows among \a source_rows that are accepted by the filter if
+  \a accepted is true, or rejected if it's false, in the same order.
+  filterAcceptsRow() is called in parallel when there are many rows.
+*/
+QList<int> QSortFilterProxyModelPrivate::filter_source_rows(
+    const QList<int> &source_rows, const QModelIndex &source_parent, bool accepted) const
+{
+    const qsizetype count = source_rows.size();
+    QList<bool> matches(count);
+    bool *match = matches.data();
+    const auto filterRows = [&](qsizetype begin, qsizetype end) {
+        for (qsizetype i = begin; i < end; ++i)
+            match[i] = filterAcceptsRowInternal(source_rows.at(i), source_parent) == accepted;
+    };
+    if (parallelThreadCount(count) > 1) {
+        runInParallel((count + ParallelChunkSize - 1) / ParallelChunkSize, [&](qsizetype chunk) {
+            const qsizetype begin = chunk * ParallelChunkSize;
+            filterRows(begin, qMin(begin + ParallelChunkSize, count));
+        });
+    } else {
+        filterRows(0, count);
+    }
+
+    QList<int> result;
+    result.reserve(std::count(matches.cbegin(), matches.cend(), true));
+    for (qsizetype i = 0; i < count; ++i) {
+        if (match[i])
+            result.append(source_rows.at(i));
+    }
+    return result;
+}
+
 /*!
   \internal
 
@@ -1278,15 +1567,30 @@ void QSortFilterProxyModelPrivate::filter_about_to_be_changed(const QModelIndex
   \internal
 
   Updates the proxy model (adds/removes rows) based on the
-  new filter.
+  new filter. If \a refine is true, the new filter accepts no rows that the
+  previous one rejected, so only the mapped rows are checked.
 */
-void QSortFilterProxyModelPrivate::filter_changed(Direction dir, const QModelIndex &source_parent)
+void QSortFilterProxyModelPrivate::filter_changed(Direction dir, const QModelIndex &source_parent,
+                                                  bool refine)
 {
     IndexMap::const_iterator it = source_index_mapping.constFind(source_parent);
     if (it == source_index_mapping.constEnd())
         return;
     Mapping *m = it.value();
-    const QSet<int> rows_removed = (dir & Direction::Rows) ? handle_filter_changed(m->proxy_rows, m->source_rows, source_parent, Qt::Vertical) : QSet<int>();
+    if (!source_parent.isValid() && has_pending_filter()) {
+        // The mapped rows are all checked again, but the rows that the
+        // previous change did not insert yet are only checked if it's not a
+        // refinement
+        if (pending_filter_rows.size() > qMax(pending_filter_next, pending_filter_mapped_count))
+            refine = false;
+        cancel_pending_filter();
+    }
+    // Check the rows of a large flat model in several steps from the event
+    // loop
+    const bool sliced = (dir & Direction::Rows) && !source_parent.isValid()
+            && filter_time_slice > 0 && m->mapped_children.isEmpty()
+            && m->proxy_rows.size() > FilterSliceRowCount;
+    const QSet<int> rows_removed = (dir & Direction::Rows) && !sliced ? handle_filter_changed(m->proxy_rows, m->source_rows, source_parent, Qt::Vertical, refine) : QSet<int>();
     const QSet<int> columns_removed = (dir & Direction::Columns) ? handle_filter_changed(m->proxy_columns, m->source_columns, source_parent, Qt::Horizontal) : QSet<int>();
 
     // We need to iterate over a copy of m->mapped_children because otherwise it may be changed by other code, invalidating
@@ -1301,7 +1605,7 @@ void QSortFilterProxyModelPrivate::filter_changed(Direction dir, const QModelInd
             indexesToRemove.push_back(i);
             remove_from_mapping(source_child_index);
         } else {
-            filter_changed(dir, source_child_index);
+            filter_changed(dir, source_child_index, refine);
         }
     }
     QList<int>::const_iterator removeIt = indexesToRemove.constEnd();
@@ -1316,6 +1620,113 @@ void QSortFilterProxyModelPrivate::filter_changed(Direction dir, const QModelInd
         --removeIt;
         m->mapped_children.remove(*removeIt);
     }
+
+    if (sliced)
+        start_pending_filter(m, refine);
+}
+
+/*!
+  \internal
+
+  Starts checking the rows of the root mapping \a m against the new filter
+  in time slices, first the mapped rows, then the others unless \a refine is
+  true.
+*/
+void QSortFilterProxyModelPrivate::start_pending_filter(Mapping *m, bool refine)
+{
+    pending_filter_rows = m->source_rows;
+    pending_filter_mapped_count = pending_filter_rows.size();
+    pending_filter_next = 0;
+    if (!refine) {
+        for (int source_row = 0; source_row < m->proxy_rows.size(); ++source_row) {
+            if (m->proxy_rows.at(source_row) == -1)
+                pending_filter_rows.append(source_row);
+        }
+    }
+    if (!filter_pending_rows(QDeadlineTimer(filter_time_slice)))
+        schedule_pending_filter();
+}
+
+/*!
+  \internal
+
+  Checks the rows of the root that the last filter change did not check yet
+  until the \a deadline expires, removing and inserting them as needed.
+  Returns true if all of them have been checked.
+*/
+bool QSortFilterProxyModelPrivate::filter_pending_rows(QDeadlineTimer deadline)
+{
+    const QModelIndex source_parent;
+    while (has_pending_filter()) {
+        IndexMap::const_iterator it = source_index_mapping.constFind(source_parent);
+        if (it == source_index_mapping.constEnd())
+            break;
+        Mapping *m = it.value();
+
+        // The rows that are checked are taken first, as removing or inserting
+        // them may get here again
+        const bool mapped = pending_filter_next < pending_filter_mapped_count;
+        const qsizetype end = qMin(pending_filter_next + FilterSliceRowCount,
+                                   mapped ? pending_filter_mapped_count : pending_filter_rows.size());
+        const QList<int> source_rows = pending_filter_rows.sliced(pending_filter_next,
+                                                                  end - pending_filter_next);
+        pending_filter_next = end;
+
+        if (mapped) {
+            const QList<int> source_items_remove =
+                    filter_source_rows(source_rows, source_parent, false);
+            if (!source_items_remove.isEmpty()) {
+                const QSet<int> rows_removed = qListToSet(source_items_remove);
+                m->mapped_children.removeIf([&](const QModelIndex &source_child_index) {
+                    if (!rows_removed.contains(source_child_index.row()))
+                        return false;
+                    remove_from_mapping(source_child_index);
+                    return true;
+                });
+                remove_source_items(m->proxy_rows, m->source_rows, source_items_remove,
+                                    source_parent, Qt::Vertical);
+            }
+        } else {
+            QList<int> source_items_insert = filter_source_rows(source_rows, source_parent, true);
+            if (!source_items_insert.isEmpty()) {
+                sort_source_rows(source_items_insert, source_parent);
+                insert_source_items(m->proxy_rows, m->source_rows, source_items_insert,
+                                    source_parent, Qt::Vertical);
+            }
+        }
+
+        if (deadline.hasExpired())
+            return !has_pending_filter();
+    }
+    cancel_pending_filter();
+    return true;
+}
+
+void QSortFilterProxyModelPrivate::schedule_pending_filter()
+{
+    Q_Q(QSortFilterProxyModel);
+    if (pending_filter_scheduled)
+        return;
+    pending_filter_scheduled = true;
+    QMetaObject::invokeMethod(q, [this] {
+        pending_filter_scheduled = false;
+        if (has_pending_filter() && !filter_pending_rows(QDeadlineTimer(filter_time_slice)))
+            schedule_pending_filter();
+    }, Qt::QueuedConnection);
+}
+
+// Checks the remaining rows at once, before the source model changes
+void QSortFilterProxyModelPrivate::finish_pending_filter()
+{
+    if (has_pending_filter())
+        filter_pending_rows(QDeadlineTimer(QDeadlineTimer::Forever));
+}
+
+void QSortFilterProxyModelPrivate::cancel_pending_filter()
+{
+    pending_filter_rows.clear();
+    pending_filter_mapped_count = 0;
+    pending_filter_next = 0;
 }
 
 /*!
@@ -1324,30 +1735,41 @@ void QSortFilterProxyModelPrivate::filter_changed(Direction dir, const QModelInd
 */
 QSet<int> QSortFilterProxyModelPrivate::handle_filter_changed(
     QList<int> &source_to_proxy, QList<int> &proxy_to_source,
-    const QModelIndex &source_parent, Qt::Orientation orient)
+    const QModelIndex &source_parent, Qt::Orientation orient, bool refine)
 {
     Q_Q(QSortFilterProxyModel);
-    // Figure out which mapped items to remove
     QList<int> source_items_remove;
-    for (int i = 0; i < proxy_to_source.size(); ++i) {
-        const int source_item = proxy_to_source.at(i);
-        if ((orient == Qt::Vertical)
-            ? !filterAcceptsRowInternal(source_item, source_parent)
-            : !q->filterAcceptsColumn(source_item, source_parent)) {
-            // This source item does not satisfy the filter, so it must be removed
-            source_items_remove.append(source_item);
-        }
-    }
-    // Figure out which non-mapped items to insert
     QList<int> source_items_insert;
-    int source_count = source_to_proxy.size();
-    for (int source_item = 0; source_item < source_count; ++source_item) {
-        if (source_to_proxy.at(source_item) == -1) {
+    const int source_count = source_to_proxy.size();
+    if (orient == Qt::Vertical && parallel_sortfilter && source_count >= ParallelRowCount) {
+        source_items_remove = filter_source_rows(proxy_to_source, source_parent, false);
+        QList<int> source_items_unmapped;
+        for (int source_item = 0; !refine && source_item < source_count; ++source_item) {
+            if (source_to_proxy.at(source_item) == -1)
+                source_items_unmapped.append(source_item);
+        }
+        source_items_insert = filter_source_rows(source_items_unmapped, source_parent, true);
+    } else {
+        // Figure out which mapped items to remove
+        for (int i = 0; i < proxy_to_source.size(); ++i) {
+            const int source_item = proxy_to_source.at(i);
             if ((orient == Qt::Vertical)
-                ? filterAcceptsRowInternal(source_item, source_parent)
-                : q->filterAcceptsColumn(source_item, source_parent)) {
-                // This source item satisfies the filter, so it must be added
-                source_items_insert.append(source_item);
+                ? !filterAcceptsRowInternal(source_item, source_parent)
+                : !q->filterAcceptsColumn(source_item, source_parent)) {
+                // This source item does not satisfy the filter, so it must be removed
+                source_items_remove.append(source_item);
+            }
+        }
+        // Figure out which non-mapped items to insert, unless the filter only
+        // became stricter
+        for (int source_item = 0; !refine && source_item < source_count; ++source_item) {
+            if (source_to_proxy.at(source_item) == -1) {
+                if ((orient == Qt::Vertical)
+                    ? filterAcceptsRowInternal(source_item, source_parent)
+                    : q->filterAcceptsColumn(source_item, source_parent)) {
+                    // This source item satisfies the filter, so it must be added
+                    source_items_insert.append(source_item);
+                }
             }
         }
     }
@@ -1397,6 +1819,7 @@ void QSortFilterProxyModelPrivate::_q_sourceDataChanged(const QModelIndex &sourc
     Q_Q(QSortFilterProxyModel);
     if (!source_top_left.isValid() || !source_bottom_right.isValid())
         return;
+    finish_pending_filter();
 
     std::vector<QSortFilterProxyModelDataChanged> data_changed_list;
     data_changed_list.emplace_back(source_top_left, source_bottom_right);
@@ -1579,6 +2002,7 @@ void QSortFilterProxyModelPrivate::_q_sourceHeaderDataChanged(Qt::Orientation or
 void QSortFilterProxyModelPrivate::_q_sourceAboutToBeReset()
 {
     Q_Q(QSortFilterProxyModel);
+    cancel_pending_filter();
     q->beginResetModel();
 }
 
@@ -1597,6 +2021,7 @@ void QSortFilterProxyModelPrivate::_q_sourceLayoutAboutToBeChanged(const QList<Q
 {
     Q_Q(QSortFilterProxyModel);
     Q_UNUSED(hint); // We can't forward Hint because we might filter additional rows or columns
+    finish_pending_filter();
     saved_persistent_indexes.clear();
 
     saved_layoutChange_parents.clear();
@@ -1648,6 +2073,7 @@ void QSortFilterProxyModelPrivate::_q_sourceLayoutChanged(const QList<QPersisten
 void QSortFilterProxyModelPrivate::_q_sourceRowsAboutToBeInserted(
     const QModelIndex &source_parent, int start, int end)
 {
+    finish_pending_filter();
     Q_UNUSED(start);
     Q_UNUSED(end);
 
@@ -1709,6 +2135,7 @@ void QSortFilterProxyModelPrivate::_q_sourceRowsInserted(
 void QSortFilterProxyModelPrivate::_q_sourceRowsAboutToBeRemoved(
     const QModelIndex &source_parent, int start, int end)
 {
+    finish_pending_filter();
     itemsBeingRemoved = QRowsRemoval(source_parent, start, end);
     source_items_about_to_be_removed(source_parent, start, end,
                                      Qt::Vertical);
@@ -1771,6 +2198,7 @@ void QSortFilterProxyModelPrivate::_q_sourceRowsMoved(
 void QSortFilterProxyModelPrivate::_q_sourceColumnsAboutToBeInserted(
     const QModelIndex &source_parent, int start, int end)
 {
+    finish_pending_filter();
     Q_UNUSED(start);
     Q_UNUSED(end);
     //Force the creation of a mapping now, even if it's empty.
@@ -1802,6 +2230,7 @@ void QSortFilterProxyModelPrivate::_q_sourceColumnsInserted(
 void QSortFilterProxyModelPrivate::_q_sourceColumnsAboutToBeRemoved(
     const QModelIndex &source_parent, int start, int end)
 {
+    finish_pending_filter();
     source_items_about_to_be_removed(source_parent, start, end,
                                      Qt::Horizontal);
 }
@@ -2846,9 +3275,15 @@ void QSortFilterProxyModel::setFilterFixedString(const QString &pattern)
 {
     Q_D(QSortFilterProxyModel);
     d->filter_regularexpression.removeBindingUnlessInWrapper();
+    // A string containing the previous one matches fewer rows, unless the
+    // filter was set in another way meanwhile
+    const bool refine = d->incremental_filtering && pattern.contains(d->filter_fixed_string)
+            && d->filter_regularexpression.value().pattern()
+                    == QRegularExpression::escape(d->filter_fixed_string);
     d->filter_about_to_be_changed();
     d->set_filter_pattern(QRegularExpression::escape(pattern));
-    d->filter_changed(QSortFilterProxyModelPrivate::Direction::Rows);
+    d->filter_fixed_string = pattern;
+    d->filter_changed(QSortFilterProxyModelPrivate::Direction::Rows, QModelIndex(), refine);
     d->filter_regularexpression.notify();
 }
 
@@ -3065,6 +3500,106 @@ QBindable<bool> QSortFilterProxyModel::bindableAutoAcceptChildRows()
     return QBindable<bool>(&d->accept_children);
 }
 
+/*!
+    \since 6.6
+    \property QSortFilterProxyModel::parallelSortFilterEnabled
+    \brief whether the rows are sorted and filtered on several threads.
+
+    When this property is true, the proxy model reads the data that the rows
+    are sorted by only once for each row, and compares it like the default
+    implementation of lessThan() does, instead of calling lessThan(). When a
+    parent has many rows, the data is read, the rows are sorted and
+    filterAcceptsRow() is called on the threads of
+    QThreadPool::globalInstance() as well, while the thread of the proxy model
+    waits for them. The proxy model is only updated from its own thread.
+
+    This is only safe if the index(), data(), rowCount() and columnCount()
+    functions of the source model, as well as filterAcceptsRow(), can be
+    called from several threads at the same time. Subclasses that reimplement
+    lessThan() should not enable it.
+
+    The default value is false.
+
+    \sa lessThan(), filterAcceptsRow(), QThreadPool
+*/
+bool QSortFilterProxyModel::isParallelSortFilterEnabled() const
+{
+    Q_D(const QSortFilterProxyModel);
+    return d->parallel_sortfilter;
+}
+
+void QSortFilterProxyModel::setParallelSortFilterEnabled(bool enable)
+{
+    Q_D(QSortFilterProxyModel);
+    d->parallel_sortfilter = enable;
+}
+
+/*!
+    \since 6.6
+    \property QSortFilterProxyModel::incrementalFilteringEnabled
+    \brief whether a fixed string filter that is made longer only checks the
+    rows that are shown.
+
+    When this property is true and setFilterFixedString() is called with a
+    string that contains the previous fixed string, the proxy model assumes
+    that the new filter accepts no row that the previous one rejected. It
+    then only checks the rows that it currently shows, as refineRowsFilter()
+    does. This is the case for the default implementation of
+    filterAcceptsRow(), and makes filtering as the user types faster on large
+    models.
+
+    Do not enable it if a reimplementation of filterAcceptsRow() may accept
+    more rows for a longer string.
+
+    The default value is false.
+
+    \sa refineRowsFilter(), filterTimeSlice
+*/
+bool QSortFilterProxyModel::isIncrementalFilteringEnabled() const
+{
+    Q_D(const QSortFilterProxyModel);
+    return d->incremental_filtering;
+}
+
+void QSortFilterProxyModel::setIncrementalFilteringEnabled(bool enable)
+{
+    Q_D(QSortFilterProxyModel);
+    d->incremental_filtering = enable;
+}
+
+/*!
+    \since 6.6
+    \property QSortFilterProxyModel::filterTimeSlice
+    \brief the time in milliseconds that a filter change may take before
+    the proxy model returns to the event loop.
+
+    When this property is greater than 0, a change of the filter of a flat
+    model with many rows checks the rows in several steps. The rows checked
+    in each step are removed or inserted right away, and the next step is
+    started from the event loop, so that the application stays responsive
+    while a huge model is filtered. Until the last step, the proxy model
+    may show rows that the new filter rejects, or miss rows that it accepts.
+    The remaining rows are checked at once when the source model changes.
+
+    The default value is 0, which checks all rows before the function that
+    changed the filter returns.
+
+    \sa incrementalFilteringEnabled
+*/
+int QSortFilterProxyModel::filterTimeSlice() const
+{
+    Q_D(const QSortFilterProxyModel);
+    return d->filter_time_slice;
+}
+
+void QSortFilterProxyModel::setFilterTimeSlice(int msecs)
+{
+    Q_D(QSortFilterProxyModel);
+    d->filter_time_slice = qMax(msecs, 0);
+    if (d->filter_time_slice == 0)
+        d->finish_pending_filter();
+}
+
 /*!
    \since 4.3
 
@@ -3142,6 +3677,25 @@ void QSortFilterProxyModel::invalidateRowsFilter()
     d->filter_changed(QSortFilterProxyModelPrivate::Direction::Rows);
 }
 
+/*!
+   \since 6.6
+
+   Updates the filtering of the rows after the filter became stricter.
+
+   Call this function instead of invalidateRowsFilter() if your filter
+   parameters have changed so that filterAcceptsRow() accepts no row that
+   it rejected before, like when the user types one more character of a
+   string to search for. Only the rows that the proxy model currently shows
+   are checked again, and rows are only removed.
+
+   \sa invalidateRowsFilter(), incrementalFilteringEnabled
+*/
+void QSortFilterProxyModel::refineRowsFilter()
+{
+    Q_D(QSortFilterProxyModel);
+    d->filter_changed(QSortFilterProxyModelPrivate::Direction::Rows, QModelIndex(), true);
+}
+
 /*!
     Returns \c true if the value of the item referred to by the given
     index \a source_left is less than the value of the item referred to by
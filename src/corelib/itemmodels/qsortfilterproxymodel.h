@@ -46,6 +46,11 @@ class Q_CORE_EXPORT QSortFilterProxyModel : public QAbstractProxyModel
                BINDABLE bindableRecursiveFilteringEnabled)
     Q_PROPERTY(bool autoAcceptChildRows READ autoAcceptChildRows WRITE setAutoAcceptChildRows
                NOTIFY autoAcceptChildRowsChanged BINDABLE bindableAutoAcceptChildRows)
+    Q_PROPERTY(bool parallelSortFilterEnabled READ isParallelSortFilterEnabled
+               WRITE setParallelSortFilterEnabled)
+    Q_PROPERTY(bool incrementalFilteringEnabled READ isIncrementalFilteringEnabled
+               WRITE setIncrementalFilteringEnabled)
+    Q_PROPERTY(int filterTimeSlice READ filterTimeSlice WRITE setFilterTimeSlice)
 
 public:
     explicit QSortFilterProxyModel(QObject *parent = nullptr);
@@ -101,6 +106,15 @@ public:
     void setAutoAcceptChildRows(bool accept);
     QBindable<bool> bindableAutoAcceptChildRows();
 
+    bool isParallelSortFilterEnabled() const;
+    void setParallelSortFilterEnabled(bool enable);
+
+    bool isIncrementalFilteringEnabled() const;
+    void setIncrementalFilteringEnabled(bool enable);
+
+    int filterTimeSlice() const;
+    void setFilterTimeSlice(int msecs);
+
 public Q_SLOTS:
     void setFilterRegularExpression(const QString &pattern);
     void setFilterRegularExpression(const QRegularExpression &regularExpression);
@@ -116,6 +130,7 @@ protected:
     void invalidateFilter();
     void invalidateRowsFilter();
     void invalidateColumnsFilter();
+    void refineRowsFilter();
 
 public:
     using QObject::parent;
@@ -9,6 +9,7 @@
 
 #include <QtCore/qlist.h>
 #include <QtCore/qmap.h>
+#include <QtCore/private/qabstractitemmodel_p.h>
 
 #include <algorithm>
 
@@ -51,12 +52,45 @@ QT_BEGIN_NAMESPACE
     \sa QAbstractListModel, QAbstractItemModel, {Model Classes}
 */
 
+class QStringListModelPrivate : public QAbstractItemModelPrivate
+{
+    Q_DECLARE_PUBLIC(QStringListModel)
+
+public:
+    void blockData(const QModelIndex &topLeft, const QModelIndex &bottomRight,
+                   QModelRoleDataSpan roleDataSpan) const override;
+};
+
+// Reads the strings directly, unless a subclass may provide other data
+void QStringListModelPrivate::blockData(const QModelIndex &topLeft,
+                                        const QModelIndex &bottomRight,
+                                        QModelRoleDataSpan roleDataSpan) const
+{
+    Q_Q(const QStringListModel);
+    if (q->metaObject() != &QStringListModel::staticMetaObject) {
+        QAbstractItemModelPrivate::blockData(topLeft, bottomRight, roleDataSpan);
+        return;
+    }
+    // one column of the span for each role
+    QModelRoleData *roleData = roleDataSpan.begin();
+    while (roleData != roleDataSpan.end()) {
+        const int role = roleData->role();
+        const bool hasData = role == Qt::DisplayRole || role == Qt::EditRole;
+        for (int row = topLeft.row(); row <= bottomRight.row(); ++row, ++roleData) {
+            if (hasData)
+                roleData->setData(q->lst.at(row));
+            else
+                roleData->clearData();
+        }
+    }
+}
+
 /*!
     Constructs a string list model with the given \a parent.
 */
 
 QStringListModel::QStringListModel(QObject *parent)
-    : QAbstractListModel(parent)
+    : QAbstractListModel(*new QStringListModelPrivate, parent)
 {
 }
 
@@ -66,7 +100,7 @@ QStringListModel::QStringListModel(QObject *parent)
 */
 
 QStringListModel::QStringListModel(const QStringList &strings, QObject *parent)
-    : QAbstractListModel(parent), lst(strings)
+    : QAbstractListModel(*new QStringListModelPrivate, parent), lst(strings)
 {
 }
 
@@ -11,6 +11,8 @@ QT_REQUIRE_CONFIG(stringlistmodel);
 
 QT_BEGIN_NAMESPACE
 
+class QStringListModelPrivate;
+
 class Q_CORE_EXPORT QStringListModel : public QAbstractListModel
 {
     Q_OBJECT
@@ -43,6 +45,7 @@ public:
 
 private:
     Q_DISABLE_COPY(QStringListModel)
+    Q_DECLARE_PRIVATE(QStringListModel)
     QStringList lst;
 };
 
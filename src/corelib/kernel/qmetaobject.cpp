@@ -170,6 +170,59 @@ static inline int typeFromTypeInfo(const QMetaObject *mo, uint typeInfo)
     return QMetaType::fromName(rawStringData(mo, typeInfo & TypeNameIndexMask)).id();
 }
 
+// Returns the hash table of the method names of mo, which is followed by the
+// one of the property names, or nullptr if it has none
+static inline const uint *nameHashTable(const QMetaObject *mo)
+{
+    const QMetaObjectPrivate *d = priv(mo->d.data);
+    if (d->revision < 13 || !d->nameHashData)
+        return nullptr;
+    return mo->d.data + d->nameHashData;
+}
+
+// Returns the slot of the name with the given hash in table, or -1 if the
+// table is empty
+static inline int nameHashSlot(const uint *table, uint hash)
+{
+    const uint bucketCount = table[0];
+    if (!bucketCount)
+        return -1;
+    const uint seed = table[2 + (QMetaObjectPrivate::nameHashMix(hash, 0) & (bucketCount - 1))];
+    return int(QMetaObjectPrivate::nameHashMix(hash, seed) & (table[1] - 1));
+}
+
+// Sets indexes to the relative indexes of the methods of mo that may have
+// the name with the given hash, in ascending order, and returns how many
+// there are. Returns -1 if mo has no hash table, so that all of its
+// methods need to be checked.
+static int methodsByNameHash(const QMetaObject *mo, uint hash, const uint **indexes)
+{
+    const uint *table = nameHashTable(mo);
+    if (!table)
+        return -1;
+    const int slot = nameHashSlot(table, hash);
+    if (slot < 0)
+        return 0;
+    const uint *offsets = table + 2 + table[0];
+    *indexes = offsets + table[1] + 1 + offsets[slot];
+    return int(offsets[slot + 1] - offsets[slot]);
+}
+
+// Returns the relative index + 1 of the property of mo that may have the
+// name with the given hash, 0 if there is none, or -1 if mo has no hash table
+static int propertyByNameHash(const QMetaObject *mo, uint hash)
+{
+    const uint *table = nameHashTable(mo);
+    if (!table)
+        return -1;
+    // skip the table of the method names
+    if (table[0])
+        table += table[0] + table[1] + 1 + priv(mo->d.data)->methodCount;
+    table += 2;
+    const int slot = nameHashSlot(table, hash);
+    return slot < 0 ? 0 : int(table[2 + table[0] + slot]);
+}
+
 namespace {
 class QMetaMethodPrivate : public QMetaMethodInvoker
 {
@@ -668,11 +721,15 @@ bool QMetaObjectPrivate::methodMatch(const QMetaObject *m, const QMetaMethod &me
  */
 QMetaMethod QMetaObjectPrivate::firstMethod(const QMetaObject *baseObject, QByteArrayView name)
 {
+    const uint hash = nameHash(name.data(), name.size());
     for (const QMetaObject *currentObject = baseObject; currentObject; currentObject = currentObject->superClass()) {
-        const int start = priv(currentObject->d.data)->methodCount - 1;
+        const uint *indexes;
+        const int count = methodsByNameHash(currentObject, hash, &indexes);
+        const int start = (count < 0 ? priv(currentObject->d.data)->methodCount : count) - 1;
         const int end = 0;
         for (int i = start; i >= end; --i) {
-            auto candidate = QMetaMethod::fromRelativeMethodIndex(currentObject, i);
+            auto candidate = QMetaMethod::fromRelativeMethodIndex(currentObject,
+                                                                  count < 0 ? i : int(indexes[i]));
             if (name == candidate.name())
                 return candidate;
         }
@@ -691,6 +748,7 @@ inline int QMetaObjectPrivate::indexOfMethodRelative(const QMetaObject **baseObj
                                         const QByteArray &name, int argc,
                                         const QArgumentType *types)
 {
+    const uint hash = nameHash(name.constData(), name.size());
     for (const QMetaObject *m = *baseObject; m; m = m->d.superdata) {
         Q_ASSERT(priv(m->d.data)->revision >= 7);
         int i = (MethodType == MethodSignal)
@@ -698,6 +756,22 @@ inline int QMetaObjectPrivate::indexOfMethodRelative(const QMetaObject **baseObj
         const int end = (MethodType == MethodSlot)
                         ? (priv(m->d.data)->signalCount) : 0;
 
+        const uint *indexes;
+        const int count = methodsByNameHash(m, hash, &indexes);
+        if (count >= 0) {
+            for (int n = count - 1; n >= 0; --n) {
+                const int index = int(indexes[n]);
+                if (index > i || index < end)
+                    continue;
+                auto data = QMetaMethod::fromRelativeMethodIndex(m, index);
+                if (methodMatch(m, data, name, argc, types)) {
+                    *baseObject = m;
+                    return index;
+                }
+            }
+            continue;
+        }
+
         for (; i >= end; --i) {
             auto data = QMetaMethod::fromRelativeMethodIndex(m, i);
             if (methodMatch(m, data, name, argc, types)) {
@@ -1100,7 +1174,18 @@ int QMetaObject::indexOfEnumerator(const char *name) const
 int QMetaObject::indexOfProperty(const char *name) const
 {
     const QMetaObject *m = this;
+    const uint hash = QMetaObjectPrivate::nameHash(name, qsizetype(strlen(name)));
     while (m) {
+        if (const int index = propertyByNameHash(m, hash); index >= 0) {
+            if (index > 0) {
+                const QMetaProperty::Data data = QMetaProperty::getMetaPropertyData(m, index - 1);
+                if (strcmp(name, rawStringData(m, data.name())) == 0)
+                    return index - 1 + m->propertyOffset();
+            }
+            m = m->d.superdata;
+            continue;
+        }
+
         const QMetaObjectPrivate *d = priv(m->d.data);
         for (int i = 0; i < d->propertyCount; ++i) {
             const QMetaProperty::Data data = QMetaProperty::getMetaPropertyData(m, i);
@@ -1588,11 +1673,14 @@ bool QMetaObject::invokeMethodImpl(QObject *obj, const char *member, Qt::Connect
     if (name.isEmpty())
         return false;
 
+    const uint hash = QMetaObjectPrivate::nameHash(name.data(), name.size());
     const QMetaObject *meta = obj->metaObject();
     for ( ; meta; meta = meta->superClass()) {
-        auto priv = QMetaObjectPrivate::get(meta);
-        for (int i = 0; i < priv->methodCount; ++i) {
-            QMetaMethod m = QMetaMethod::fromRelativeMethodIndex(meta, i);
+        const uint *indexes;
+        const int count = methodsByNameHash(meta, hash, &indexes);
+        const int methodCount = count < 0 ? QMetaObjectPrivate::get(meta)->methodCount : count;
+        for (int i = 0; i < methodCount; ++i) {
+            QMetaMethod m = QMetaMethod::fromRelativeMethodIndex(meta, count < 0 ? i : int(indexes[i]));
             if (m.parameterCount() != (paramCount - 1))
                 continue;
             if (name != stringDataView(meta, m.data.name()))
@@ -176,7 +176,8 @@ struct QMetaObjectPrivate
     //                        and metamethods store a flag stating whether they are const
     // revision 11 is Qt 6.5: The metatype for void is stored in the metatypes array
     // revision 12 is Qt 6.6: It adds the metatype for enums
-    enum { OutputRevision = 12 }; // Used by moc, qmetaobjectbuilder and qdbus
+    // revision 13 is Qt 6.6: It adds the hash tables of the method and property names
+    enum { OutputRevision = 13 }; // Used by moc, qmetaobjectbuilder and qdbus
     enum { IntsPerMethod = QMetaMethod::Data::Size };
     enum { IntsPerEnum = QMetaEnum::Data::Size };
     enum { IntsPerProperty = QMetaProperty::Data::Size };
@@ -190,6 +191,7 @@ struct QMetaObjectPrivate
     int constructorCount, constructorData;
     int flags;
     int signalCount;
+    int nameHashData;   // 0 if there are no hash tables
 
     static inline const QMetaObjectPrivate *get(const QMetaObject *metaobject)
     { return reinterpret_cast<const QMetaObjectPrivate*>(metaobject->d.data); }
@@ -259,6 +261,34 @@ struct QMetaObjectPrivate
                             const QArgumentType *types);
     Q_CORE_EXPORT static QMetaMethod firstMethod(const QMetaObject *baseObject, QByteArrayView name);
 
+    // The names of the methods and properties of a class are looked up in
+    // perfect hash tables, generated by moc. Each table is made of
+    //     bucketCount, slotCount, seeds[bucketCount], ...
+    // and a name goes to the slot nameHashMix(hash, seed) of the seed of
+    // the bucket nameHashMix(hash, 0), where hash is nameHash(name). The
+    // method table continues with the offsets of the methods of each slot
+    // in the method indexes that follow, slotCount + 1 of them, and the
+    // property table with the property index + 1 of each slot, or 0. An
+    // empty table only has a bucketCount and slotCount of 0.
+    static constexpr uint nameHash(const char *name, qsizetype size) noexcept
+    {
+        uint h = 2166136261U;
+        for (qsizetype i = 0; i < size; ++i) {
+            h ^= uchar(name[i]);
+            h *= 16777619U;
+        }
+        return h;
+    }
+    static constexpr uint nameHashMix(uint hash, uint seed) noexcept
+    {
+        hash ^= seed * 0x9e3779b9U;
+        hash ^= hash >> 16;
+        hash *= 0x85ebca6bU;
+        hash ^= hash >> 13;
+        hash *= 0xc2b2ae35U;
+        hash ^= hash >> 16;
+        return hash;
+    }
 };
 
 // For meta-object generators
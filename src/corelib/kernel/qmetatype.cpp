@@ -9,7 +9,7 @@
 #include "qobjectdefs.h"
 #include "qdatetime.h"
 #include "qbytearray.h"
-#include "qreadwritelock.h"
+#include "qmutex.h"
 #include "qhash.h"
 #include "qmap.h"
 #include "qstring.h"
@@ -57,8 +57,10 @@
 #endif
 
 #include <bitset>
+#include <memory>
 #include <new>
 #include <cstring>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
@@ -82,6 +84,141 @@ struct QMetaTypeDeleter
     }
 };
 
+// A hash table that is read without locking, while the writers are
+// serialized by a lock that the caller holds. Like RCU, the writers never
+// change what a reader may be looking at: a node is immutable once it is
+// published, a removed node is only marked as such, and a table replaced by
+// a bigger one stays allocated. All of them are freed with the hash. As the
+// tables grow geometrically, the retired ones take less memory than the
+// current one; only nodes that are removed and inserted again accumulate.
+template <typename Key, typename T>
+class QReadMostlyHash
+{
+    struct Node
+    {
+        Node(const Key &key, size_t hash, const T &value)
+            : key(key), hash(hash), value(value) {}
+        const Key key;
+        const size_t hash;
+        const T value;
+        QAtomicInt removed;
+    };
+    struct Table
+    {
+        explicit Table(qsizetype capacity)
+            : capacity(capacity), buckets(new QAtomicPointer<Node>[capacity]) {}
+        const qsizetype capacity;   // a power of two
+        const std::unique_ptr<QAtomicPointer<Node>[]> buckets;
+    };
+
+public:
+    static size_t hash(const Key &key) { return qHash(key, QHashSeed::globalSeed()); }
+
+    // Returns the value of key, which stays valid as long as the hash, or
+    // nullptr. Can be called without holding the lock.
+    const T *find(const Key &key) const
+    {
+        const Table *table = m_table.loadAcquire();
+        if (!table)
+            return nullptr;
+        const Node *node = bucketFor(*table, key, hash(key)).loadAcquire();
+        if (!node || node->removed.loadAcquire())
+            return nullptr;
+        return &node->value;
+    }
+
+    // Returns false if key is already in the hash
+    bool insert(const Key &key, const T &value)
+    {
+        const size_t h = hash(key);
+        Table *table = m_table.loadRelaxed();
+        if (table) {
+            const Node *node = bucketFor(*table, key, h).loadRelaxed();
+            if (node && !node->removed.loadRelaxed())
+                return false;
+        }
+        // keep the load factor at most 3/4, so that the probing is short
+        if (!table || (m_used + 1) * 4 > table->capacity * 3)
+            table = rehash();
+        QAtomicPointer<Node> &bucket = bucketFor(*table, key, h);
+        if (!bucket.loadRelaxed())
+            ++m_used;
+        m_nodes.push_back(std::make_unique<Node>(key, h, value));
+        bucket.storeRelease(m_nodes.back().get());
+        return true;
+    }
+
+    template <typename Predicate>
+    void removeIf(Predicate pred)
+    {
+        forEachNode([&pred](Node *node) {
+            if (pred(node->key, node->value))
+                node->removed.storeRelease(1);
+        });
+    }
+
+    void remove(const Key &key)
+    {
+        if (Table *table = m_table.loadRelaxed()) {
+            if (Node *node = bucketFor(*table, key, hash(key)).loadRelaxed())
+                node->removed.storeRelease(1);
+        }
+    }
+
+    template <typename Function>
+    void forEach(Function f) const
+    {
+        forEachNode([&f](const Node *node) { f(node->key, node->value); });
+    }
+
+private:
+    // Returns the bucket of key, or the empty one where it would be inserted
+    static QAtomicPointer<Node> &bucketFor(const Table &table, const Key &key, size_t hash)
+    {
+        const size_t mask = size_t(table.capacity) - 1;
+        for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+            QAtomicPointer<Node> &bucket = table.buckets[i];
+            const Node *node = bucket.loadAcquire();
+            if (!node || (node->hash == hash && node->key == key))
+                return bucket;
+        }
+    }
+
+    template <typename Function>
+    void forEachNode(Function f) const
+    {
+        const Table *table = m_table.loadRelaxed();
+        for (qsizetype i = 0; table && i < table->capacity; ++i) {
+            Node *node = table->buckets[i].loadRelaxed();
+            if (node && !node->removed.loadRelaxed())
+                f(node);
+        }
+    }
+
+    // Publishes a table with room for the nodes that aren't removed
+    Table *rehash()
+    {
+        qsizetype count = 0;
+        forEachNode([&count](const Node *) { ++count; });
+        qsizetype capacity = 16;
+        while ((count + 1) * 2 > capacity)
+            capacity *= 2;
+        m_tables.push_back(std::make_unique<Table>(capacity));
+        Table *table = m_tables.back().get();
+        forEachNode([table](Node *node) {
+            bucketFor(*table, node->key, node->hash).storeRelaxed(node);
+        });
+        m_used = count;
+        m_table.storeRelease(table);
+        return table;
+    }
+
+    QAtomicPointer<Table> m_table;
+    std::vector<std::unique_ptr<Table>> m_tables;   // the current one and the retired ones
+    std::vector<std::unique_ptr<Node>> m_nodes;     // including the removed ones
+    qsizetype m_used = 0;                           // the buckets that hold a node
+};
+
 struct QMetaTypeCustomRegistry
 {
 
@@ -98,19 +235,61 @@ struct QMetaTypeCustomRegistry
     }
 #endif
 
-    QReadWriteLock lock;
-    QList<const QtPrivate::QMetaTypeInterface *> registry;
-    QHash<QByteArray, const QtPrivate::QMetaTypeInterface *> aliases;
+    // Only the writers lock, the lookups of the types by id and by name don't
+    QMutex lock;
+    QReadMostlyHash<QByteArray, const QtPrivate::QMetaTypeInterface *> aliases;
+    // number of ids that were handed out, registered or not anymore
+    int registrySize = 0;
     // index of first empty (unregistered) type in registry, if any.
     int firstEmpty = 0;
 
+    // The registry is split in chunks that never move, of 64, 128, 256...
+    // entries, which are enough for all the ids up to INT_MAX.
+    static constexpr int FirstChunkSize = 64;
+    static constexpr int ChunkCount = 26;
+    QAtomicPointer<QAtomicPointer<const QtPrivate::QMetaTypeInterface>> chunks[ChunkCount] = {};
+
+    ~QMetaTypeCustomRegistry()
+    {
+        for (auto &chunk : chunks)
+            delete[] chunk.loadRelaxed();
+    }
+
+    static int chunkOf(int index)
+    {
+        return 31 - qCountLeadingZeroBits(quint32(index / FirstChunkSize + 1));
+    }
+
+    const QtPrivate::QMetaTypeInterface *at(int index) const
+    {
+        if (index < 0)
+            return nullptr;
+        const int chunk = chunkOf(index);
+        const auto entries = chunks[chunk].loadAcquire();
+        if (!entries)
+            return nullptr;
+        return entries[index - ((1 << chunk) - 1) * FirstChunkSize].loadAcquire();
+    }
+
+    // must be called with the lock held
+    void set(int index, const QtPrivate::QMetaTypeInterface *ti)
+    {
+        const int chunk = chunkOf(index);
+        auto entries = chunks[chunk].loadRelaxed();
+        if (!entries) {
+            entries = new QAtomicPointer<const QtPrivate::QMetaTypeInterface>[FirstChunkSize << chunk];
+            chunks[chunk].storeRelease(entries);
+        }
+        entries[index - ((1 << chunk) - 1) * FirstChunkSize].storeRelease(ti);
+    }
+
     int registerCustomType(const QtPrivate::QMetaTypeInterface *cti)
     {
         // we got here because cti->typeId is 0, so this is a custom meta type
         // (not read-only)
         auto ti = const_cast<QtPrivate::QMetaTypeInterface *>(cti);
         {
-            QWriteLocker l(&lock);
+            QMutexLocker l(&lock);
             if (int id = ti->typeId.loadRelaxed())
                 return id;
             QByteArray name =
@@ -118,22 +297,17 @@ struct QMetaTypeCustomRegistry
                     QMetaObject::normalizedType
 #endif
                     (ti->name);
-            if (auto ti2 = aliases.value(name)) {
-                const auto id = ti2->typeId.loadRelaxed();
+            if (auto ti2 = aliases.find(name)) {
+                const auto id = (*ti2)->typeId.loadRelaxed();
                 ti->typeId.storeRelaxed(id);
                 return id;
             }
-            aliases[name] = ti;
-            int size = registry.size();
-            while (firstEmpty < size && registry[firstEmpty])
+            aliases.insert(name, ti);
+            while (firstEmpty < registrySize && at(firstEmpty))
                 ++firstEmpty;
-            if (firstEmpty < size) {
-                registry[firstEmpty] = ti;
-                ++firstEmpty;
-            } else {
-                registry.append(ti);
-                firstEmpty = registry.size();
-            }
+            set(firstEmpty, ti);
+            ++firstEmpty;
+            registrySize = std::max(registrySize, firstEmpty);
             ti->typeId.storeRelaxed(firstEmpty + QMetaType::User);
         }
         if (ti->legacyRegisterOp)
@@ -146,28 +320,23 @@ struct QMetaTypeCustomRegistry
         if (!id)
             return;
         Q_ASSERT(id > QMetaType::User);
-        QWriteLocker l(&lock);
+        QMutexLocker l(&lock);
         int idx = id - QMetaType::User - 1;
-        auto &ti = registry[idx];
+        const auto ti = at(idx);
 
         // We must unregister all names.
-        auto it = aliases.begin();
-        while (it != aliases.end()) {
-            if (it.value() == ti)
-                it = aliases.erase(it);
-            else
-                ++it;
-        }
+        aliases.removeIf([ti](const QByteArray &, const QtPrivate::QMetaTypeInterface *value) {
+            return value == ti;
+        });
 
-        ti = nullptr;
+        set(idx, nullptr);
 
         firstEmpty = std::min(firstEmpty, idx);
     }
 
-    const QtPrivate::QMetaTypeInterface *getCustomType(int id)
+    const QtPrivate::QMetaTypeInterface *getCustomType(int id) const
     {
-        QReadLocker l(&lock);
-        return registry.value(id - QMetaType::User - 1);
+        return at(id - QMetaType::User - 1);
     }
 };
 
@@ -185,25 +354,24 @@ const char *QtMetaTypePrivate::typedefNameForType(const QtPrivate::QMetaTypeInte
     QMetaTypeCustomRegistry *r = &*customTypeRegistry;
 
     QByteArrayView officialName(type_d->name);
-    QReadLocker l(&r->lock);
-    auto it = r->aliases.constBegin();
-    auto end = r->aliases.constEnd();
-    for ( ; it != end; ++it) {
-        if (it.value() != type_d)
-            continue;
-        if (it.key() == officialName)
-            continue;               // skip the official name
-        name = it.key().constData();
-        ++it;
-        break;
-    }
-
+    QMutexLocker l(&r->lock);
 #ifndef QT_NO_DEBUG
     QByteArrayList otherNames;
-    for ( ; it != end; ++it) {
-        if (it.value() == type_d && it.key() != officialName)
-            otherNames << it.key();
-    }
+#endif
+    r->aliases.forEach([&](const QByteArray &alias, const QtPrivate::QMetaTypeInterface *value) {
+        if (value != type_d)
+            return;
+        if (alias == officialName)
+            return;                 // skip the official name
+        if (!name)
+            name = alias.constData();
+#ifndef QT_NO_DEBUG
+        else
+            otherNames << alias;
+#endif
+    });
+
+#ifndef QT_NO_DEBUG
     l.unlock();
     if (!otherNames.isEmpty())
         qWarning("QMetaType: type %s has more than one typedef alias: %s, %s",
@@ -1652,45 +1820,34 @@ template<typename T, typename Key>
 class QMetaTypeFunctionRegistry
 {
 public:
-    ~QMetaTypeFunctionRegistry()
-    {
-        const QWriteLocker locker(&lock);
-        map.clear();
-    }
-
     bool contains(Key k) const
     {
-        const QReadLocker locker(&lock);
-        return map.contains(k);
+        return map.find(k) != nullptr;
     }
 
     bool insertIfNotContains(Key k, const T &f)
     {
-        const QWriteLocker locker(&lock);
-        const qsizetype oldSize = map.size();
-        auto &e = map[k];
-        if (map.size() == oldSize) // already present
-            return false;
-        e = f;
-        return true;
+        const QMutexLocker locker(&lock);
+        return map.insert(k, f);
     }
 
+    // the function stays valid until the registry is destroyed, even if
+    // it's removed
     const T *function(Key k) const
     {
-        const QReadLocker locker(&lock);
-        auto it = map.find(k);
-        return it == map.end() ? nullptr : std::addressof(*it);
+        return map.find(k);
     }
 
     void remove(int from, int to)
     {
         const Key k(from, to);
-        const QWriteLocker locker(&lock);
+        const QMutexLocker locker(&lock);
         map.remove(k);
     }
 private:
-    mutable QReadWriteLock lock;
-    QHash<Key, T> map;
+    // only the writers lock
+    QMutex lock;
+    QReadMostlyHash<Key, T> map;
 };
 
 typedef QMetaTypeFunctionRegistry<QMetaType::ConverterFunction,QPair<int,int> >
@@ -2693,12 +2850,8 @@ static int qMetaTypeCustomType_unlocked(const char *typeName, int length)
 {
     if (customTypeRegistry.exists()) {
         auto reg = &*customTypeRegistry;
-#if QT_CONFIG(thread)
-        Q_ASSERT(!reg->lock.tryLockForWrite());
-#endif
-        if (auto ti = reg->aliases.value(QByteArray::fromRawData(typeName, length), nullptr)) {
-            return ti->typeId.loadRelaxed();
-        }
+        if (auto ti = reg->aliases.find(QByteArray::fromRawData(typeName, length)))
+            return (*ti)->typeId.loadRelaxed();
     }
     return QMetaType::UnknownType;
 }
@@ -2716,11 +2869,8 @@ void QMetaType::registerNormalizedTypedef(const NS(QByteArray) & normalizedTypeN
     if (!metaType.isValid())
         return;
     if (auto reg = customTypeRegistry()) {
-        QWriteLocker lock(&reg->lock);
-        auto &al = reg->aliases[normalizedTypeName];
-        if (al)
-            return;
-        al = metaType.d_ptr;
+        QMutexLocker lock(&reg->lock);
+        reg->aliases.insert(normalizedTypeName, metaType.d_ptr);
     }
 }
 
@@ -2756,7 +2906,6 @@ static inline int qMetaTypeTypeImpl(const char *typeName, int length)
         return QMetaType::UnknownType;
     int type = qMetaTypeStaticType(typeName, length);
     if (type == QMetaType::UnknownType) {
-        QReadLocker locker(&customTypeRegistry()->lock);
         type = qMetaTypeCustomType_unlocked(typeName, length);
 #ifndef QT_NO_QOBJECT
         if ((type == QMetaType::UnknownType) && tryNormalizedType) {
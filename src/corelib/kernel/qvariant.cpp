@@ -231,6 +231,84 @@ static bool isValidMetaTypeForVariant(const QtPrivate::QMetaTypeInterface *iface
     return true;
 }
 
+// Keeps the blocks of the shared storage that were freed last, so that the
+// values too large to be stored in QVariant itself that are created and
+// destroyed in quick succession, like the ones returned by the data() of a
+// model, don't each need a call to the memory allocator. Each thread has its
+// own cache, which only holds the smaller blocks.
+class QVariantBlockCache
+{
+public:
+    static constexpr size_t Granularity = 16;
+    static constexpr size_t MaxBlockSize = 128;
+    static constexpr int MaxBlocksPerSize = 32;
+
+    // Returns the size of the block that a value of the given size and
+    // alignment is stored in
+    static size_t blockSize(size_t size, size_t align)
+    {
+        size += sizeof(QVariant::PrivateShared);
+        if (align > sizeof(QVariant::PrivateShared)) {
+            // The alignment is larger than the alignment we can guarantee for the pointer
+            // directly following PrivateShared, so we need to allocate some additional
+            // memory to be able to fit the object into the available memory with suitable
+            // alignment.
+            size += align - sizeof(QVariant::PrivateShared);
+        }
+        if (size <= MaxBlockSize)
+            size = (size + Granularity - 1) & ~(Granularity - 1);
+        return size;
+    }
+
+    static QVariantBlockCache *instance();
+
+    constexpr QVariantBlockCache() = default;
+    ~QVariantBlockCache();
+    Q_DISABLE_COPY_MOVE(QVariantBlockCache)
+
+    void *take(size_t size)
+    {
+        if (size > MaxBlockSize)
+            return nullptr;
+        const size_t i = size / Granularity - 1;
+        return counts[i] ? blocks[i][--counts[i]] : nullptr;
+    }
+
+    bool put(void *block, size_t size)
+    {
+        if (size > MaxBlockSize)
+            return false;
+        const size_t i = size / Granularity - 1;
+        if (counts[i] == MaxBlocksPerSize)
+            return false;
+        blocks[i][counts[i]++] = block;
+        return true;
+    }
+
+private:
+    static constexpr size_t SizeCount = MaxBlockSize / Granularity;
+    void *blocks[SizeCount][MaxBlocksPerSize] = {};
+    int counts[SizeCount] = {};
+};
+
+Q_CONSTINIT static thread_local QVariantBlockCache blockCache;
+// the destructors of other thread-local objects may destroy variants after it
+Q_CONSTINIT static thread_local bool blockCacheDestroyed = false;
+
+QVariantBlockCache::~QVariantBlockCache()
+{
+    blockCacheDestroyed = true;
+    for (size_t i = 0; i < SizeCount; ++i) {
+        for (int n = 0; n < counts[i]; ++n)
+            operator delete(blocks[i][n]);
+    }
+}
+
+QVariantBlockCache *QVariantBlockCache::instance()
+{
+    return blockCacheDestroyed ? nullptr : &blockCache;
+}
+
 // the type of d has already been set, but other field are not set
 static void customConstruct(const QtPrivate::QMetaTypeInterface *iface, QVariant::Private *d,
                             const void *copy)
@@ -270,7 +348,7 @@ static void customClear(QVariant::Private *d)
         QtMetaTypePrivate::destruct(iface, d->data.data);
     } else {
         QtMetaTypePrivate::destruct(iface, d->data.shared->data());
-        QVariant::PrivateShared::free(d->data.shared);
+        QVariant::PrivateShared::free(d->data.shared, iface->size, iface->alignment);
     }
 }
 
@@ -291,6 +369,30 @@ static QVariant::Private clonePrivate(const QVariant::Private &other)
 
 } // anonymous used to hide QVariant handlers
 
+QVariant::PrivateShared *QVariant::PrivateShared::create(size_t size, size_t align)
+{
+    size = QVariantBlockCache::blockSize(size, align);
+    void *data = nullptr;
+    if (QVariantBlockCache *cache = QVariantBlockCache::instance())
+        data = cache->take(size);
+    if (!data)
+        data = operator new(size);
+    auto *ps = new (data) QVariant::PrivateShared();
+    ps->offset = int(((quintptr(ps) + sizeof(PrivateShared) + align - 1) & ~(align - 1)) - quintptr(ps));
+    return ps;
+}
+
+void QVariant::PrivateShared::free(PrivateShared *p, size_t size, size_t align)
+{
+    p->~PrivateShared();
+    size = QVariantBlockCache::blockSize(size, align);
+    if (QVariantBlockCache *cache = QVariantBlockCache::instance()) {
+        if (cache->put(p, size))
+            return;
+    }
+    operator delete(p);
+}
+
 /*!
     \class QVariant
     \inmodule QtCore
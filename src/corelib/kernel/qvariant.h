@@ -79,7 +79,7 @@ public:
         inline PrivateShared() : ref(1) { }
     public:
         static PrivateShared *create(size_t size, size_t align);
-        static void free(PrivateShared *p);
+        static void free(PrivateShared *p, size_t size, size_t align);
 
         alignas(8) QAtomicInt ref;
         int offset;
@@ -23,39 +23,19 @@ template <typename F> static QVariant::PrivateShared *
 customConstructShared(size_t size, size_t align, F &&construct)
 {
     struct Deleter {
+        size_t size;
+        size_t align;
         void operator()(QVariant::PrivateShared *p) const
-        { QVariant::PrivateShared::free(p); }
+        { QVariant::PrivateShared::free(p, size, align); }
     };
 
     // this is exception-safe
-    std::unique_ptr<QVariant::PrivateShared, Deleter> ptr;
+    std::unique_ptr<QVariant::PrivateShared, Deleter> ptr(nullptr, Deleter{ size, align });
     ptr.reset(QVariant::PrivateShared::create(size, align));
     construct(ptr->data());
     return ptr.release();
 }
 
-inline QVariant::PrivateShared *QVariant::PrivateShared::create(size_t size, size_t align)
-{
-    size += sizeof(PrivateShared);
-    if (align > sizeof(PrivateShared)) {
-        // The alignment is larger than the alignment we can guarantee for the pointer
-        // directly following PrivateShared, so we need to allocate some additional
-        // memory to be able to fit the object into the available memory with suitable
-        // alignment.
-        size += align - sizeof(PrivateShared);
-    }
-    void *data = operator new(size);
-    auto *ps = new (data) QVariant::PrivateShared();
-    ps->offset = int(((quintptr(ps) + sizeof(PrivateShared) + align - 1) & ~(align - 1)) - quintptr(ps));
-    return ps;
-}
-
-inline void QVariant::PrivateShared::free(PrivateShared *p)
-{
-    p->~PrivateShared();
-    operator delete(p);
-}
-
 inline QVariant::Private::Private(const QtPrivate::QMetaTypeInterface *iface) noexcept
     : is_shared(false), is_null(false), packedType(quintptr(iface) >> 2)
 {
@@ -19,6 +19,10 @@
 #include <QtCore/QBuffer>
 #include <QtCore/QUrl>
 #include <QtCore/QDebug>
+#if QT_CONFIG(thread)
+#include <QtCore/QSemaphore>
+#include <QtCore/QThreadPool>
+#endif
 
 #include <algorithm>
 #include <functional>
@@ -137,7 +141,16 @@ void QMimeDatabasePrivate::loadProviders()
         };
         const auto it = std::find_if(currentProviders.begin(), currentProviders.end(), isInternal);
         if (it == currentProviders.end()) {
-            m_providers.push_back(Providers::value_type(new QMimeXMLProvider(this, QMimeXMLProvider::InternalDatabase)));
+            // The cache generated at build time spares parsing the XML
+            std::unique_ptr<QMimeProviderBase> provider;
+            if (qEnvironmentVariableIsEmpty("QT_NO_MIME_CACHE")) {
+                provider.reset(new QMimeBinaryProvider(this, QMimeBinaryProvider::InternalDatabase));
+                if (!provider->isValid())
+                    provider.reset();
+            }
+            if (!provider)
+                provider.reset(new QMimeXMLProvider(this, QMimeXMLProvider::InternalDatabase));
+            m_providers.push_back(std::move(provider));
         } else {
             m_providers.push_back(std::move(*it));
         }
@@ -389,37 +402,9 @@ QMimeType QMimeDatabasePrivate::mimeTypeForFileNameAndData(const QString &fileNa
             if (openedByUs)
                 device->close();
 
-            int magicAccuracy = 0;
-            QMimeType candidateByData(findByData(data, &magicAccuracy));
-
-            // Disambiguate conflicting extensions (if magic matching found something)
-            if (candidateByData.isValid() && magicAccuracy > 0) {
-                const QString sniffedMime = candidateByData.name();
-                // If the sniffedMime matches a highest-weight glob match, use it
-                if (candidatesByName.m_matchingMimeTypes.contains(sniffedMime)) {
-                    return candidateByData;
-                }
-                for (const QString &m : std::as_const(candidatesByName.m_allMatchingMimeTypes)) {
-                    if (inherits(m, sniffedMime)) {
-                        // We have magic + pattern pointing to this, so it's a pretty good match
-                        return mimeTypeForName(m);
-                    }
-                }
-                if (candidatesByName.m_allMatchingMimeTypes.isEmpty()) {
-                    // No glob, use magic
-                    return candidateByData;
-                }
-            }
-        }
-
-        if (candidatesByName.m_allMatchingMimeTypes.size() > 1) {
-            candidatesByName.m_matchingMimeTypes.sort(); // make it deterministic
-            const QMimeType mime = mimeTypeForName(candidatesByName.m_matchingMimeTypes.at(0));
-            if (mime.isValid())
-                return mime;
+            return mimeTypeForGlobsAndData(candidatesByName, &data);
         }
-
-        return mimeTypeForName(defaultMimeType());
+        return mimeTypeForGlobsAndData(candidatesByName, nullptr);
     };
 
     if (device)
@@ -429,6 +414,44 @@ QMimeType QMimeDatabasePrivate::mimeTypeForFileNameAndData(const QString &fileNa
     return matchOnContent(&fallbackFile);
 }
 
+// Pass 2 of mimeTypeForFileNameAndData(), with the data if it could be read
+QMimeType QMimeDatabasePrivate::mimeTypeForGlobsAndData(QMimeGlobMatchResult &candidatesByName,
+                                                        const QByteArray *data)
+{
+    if (data) {
+        int magicAccuracy = 0;
+        QMimeType candidateByData(findByData(*data, &magicAccuracy));
+
+        // Disambiguate conflicting extensions (if magic matching found something)
+        if (candidateByData.isValid() && magicAccuracy > 0) {
+            const QString sniffedMime = candidateByData.name();
+            // If the sniffedMime matches a highest-weight glob match, use it
+            if (candidatesByName.m_matchingMimeTypes.contains(sniffedMime)) {
+                return candidateByData;
+            }
+            for (const QString &m : std::as_const(candidatesByName.m_allMatchingMimeTypes)) {
+                if (inherits(m, sniffedMime)) {
+                    // We have magic + pattern pointing to this, so it's a pretty good match
+                    return mimeTypeForName(m);
+                }
+            }
+            if (candidatesByName.m_allMatchingMimeTypes.isEmpty()) {
+                // No glob, use magic
+                return candidateByData;
+            }
+        }
+    }
+
+    if (candidatesByName.m_allMatchingMimeTypes.size() > 1) {
+        candidatesByName.m_matchingMimeTypes.sort(); // make it deterministic
+        const QMimeType mime = mimeTypeForName(candidatesByName.m_matchingMimeTypes.at(0));
+        if (mime.isValid())
+            return mime;
+    }
+
+    return mimeTypeForName(defaultMimeType());
+}
+
 QMimeType QMimeDatabasePrivate::mimeTypeForFileExtension(const QString &fileName)
 {
     const QStringList matches = mimeTypeForFileName(fileName);
@@ -456,9 +479,9 @@ QMimeType QMimeDatabasePrivate::mimeTypeForData(QIODevice *device)
     return mimeTypeForName(defaultMimeType());
 }
 
-QMimeType QMimeDatabasePrivate::mimeTypeForFile(const QString &fileName,
-                                                const QFileInfo &fileInfo,
-                                                QMimeDatabase::MatchMode mode)
+// Returns the name of the MIME type for files that are not regular files,
+// or an empty string
+static QString inodeMimeTypeName(const QString &fileName, const QFileInfo &fileInfo)
 {
     if (false) {
 #ifdef Q_OS_UNIX
@@ -469,20 +492,29 @@ QMimeType QMimeDatabasePrivate::mimeTypeForFile(const QString &fileName,
         QT_STATBUF statBuffer;
         if (QT_STAT(nativeFilePath.constData(), &statBuffer) == 0) {
             if (S_ISDIR(statBuffer.st_mode))
-                return mimeTypeForName(directoryMimeType());
+                return directoryMimeType();
             if (S_ISCHR(statBuffer.st_mode))
-                return mimeTypeForName(QStringLiteral("inode/chardevice"));
+                return QStringLiteral("inode/chardevice");
             if (S_ISBLK(statBuffer.st_mode))
-                return mimeTypeForName(QStringLiteral("inode/blockdevice"));
+                return QStringLiteral("inode/blockdevice");
             if (S_ISFIFO(statBuffer.st_mode))
-                return mimeTypeForName(QStringLiteral("inode/fifo"));
+                return QStringLiteral("inode/fifo");
             if (S_ISSOCK(statBuffer.st_mode))
-                return mimeTypeForName(QStringLiteral("inode/socket"));
+                return QStringLiteral("inode/socket");
         }
 #endif
     } else if (fileInfo.isDir()) {
-        return mimeTypeForName(directoryMimeType());
+        return directoryMimeType();
     }
+    return QString();
+}
+
+QMimeType QMimeDatabasePrivate::mimeTypeForFile(const QString &fileName,
+                                                const QFileInfo &fileInfo,
+                                                QMimeDatabase::MatchMode mode)
+{
+    if (const QString inodeType = inodeMimeTypeName(fileName, fileInfo); !inodeType.isEmpty())
+        return mimeTypeForName(inodeType);
 
     switch (mode) {
     case QMimeDatabase::MatchDefault:
@@ -498,6 +530,83 @@ QMimeType QMimeDatabasePrivate::mimeTypeForFile(const QString &fileName,
     return mimeTypeForFileNameAndData(fileName, nullptr);
 }
 
+// Same as mimeTypeForFile(), but called without the mutex locked, so that
+// the file can be read while another thread looks up the data of its own
+QMimeType QMimeDatabasePrivate::mimeTypeForFileUnlocked(const QString &fileName,
+                                                        QMimeDatabase::MatchMode mode)
+{
+    const QFileInfo fileInfo(fileName);
+    if (const QString inodeType = inodeMimeTypeName(fileName, fileInfo); !inodeType.isEmpty()) {
+        QMutexLocker locker(&mutex);
+        return mimeTypeForName(inodeType);
+    }
+
+    QMimeGlobMatchResult candidatesByName;
+    if (mode == QMimeDatabase::MatchDefault) {
+        // Pass 1 of mimeTypeForFileNameAndData()
+        QMutexLocker locker(&mutex);
+        candidatesByName = findByFileName(fileName);
+        if (candidatesByName.m_allMatchingMimeTypes.size() == 1) {
+            const QMimeType mime = mimeTypeForName(candidatesByName.m_matchingMimeTypes.at(0));
+            if (mime.isValid())
+                return mime;
+            candidatesByName = {};
+        }
+    }
+
+    QFile file(fileName);
+    const bool opened = file.open(QIODevice::ReadOnly);
+    const QByteArray data = opened ? file.read(16384) : QByteArray();
+    file.close();
+
+    QMutexLocker locker(&mutex);
+    if (mode == QMimeDatabase::MatchContent) {
+        if (!opened)
+            return mimeTypeForName(defaultMimeType());
+        int accuracy = 0;
+        return findByData(data, &accuracy);
+    }
+    return mimeTypeForGlobsAndData(candidatesByName, opened ? &data : nullptr);
+}
+
+QList<QMimeType> QMimeDatabasePrivate::mimeTypesForFiles(const QStringList &fileNames,
+                                                         QMimeDatabase::MatchMode mode)
+{
+    QList<QMimeType> result(fileNames.size());
+    QMimeType *mimeTypes = result.data();
+
+    if (mode == QMimeDatabase::MatchExtension) {
+        QMutexLocker locker(&mutex);
+        for (qsizetype i = 0; i < fileNames.size(); ++i)
+            mimeTypes[i] = mimeTypeForFileExtension(fileNames.at(i));
+        return result;
+    }
+
+    QAtomicInteger<qsizetype> next = 0;
+    const auto lookUpFiles = [&] {
+        for (qsizetype i = next.fetchAndAddRelaxed(1); i < fileNames.size();
+             i = next.fetchAndAddRelaxed(1)) {
+            mimeTypes[i] = mimeTypeForFileUnlocked(fileNames.at(i), mode);
+        }
+    };
+
+#if QT_CONFIG(thread)
+    // Only start helpers on threads that are free, as the calling thread may
+    // itself be one of the pool
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const qsizetype maxHelpers = qMin(qsizetype(pool->maxThreadCount()), fileNames.size()) - 1;
+    QSemaphore finished;
+    int helpers = 0;
+    while (helpers < maxHelpers && pool->tryStart([&] { lookUpFiles(); finished.release(); }))
+        ++helpers;
+    lookUpFiles();
+    finished.acquire(helpers);
+#else
+    lookUpFiles();
+#endif
+    return result;
+}
+
 QList<QMimeType> QMimeDatabasePrivate::allMimeTypes()
 {
     QList<QMimeType> result;
@@ -649,6 +758,25 @@ QMimeType QMimeDatabase::mimeTypeForFile(const QString &fileName, MatchMode mode
     }
 }
 
+/*!
+    \since 6.6
+
+    Returns the MIME types for the files named \a fileNames using \a mode,
+    in the same order.
+
+    Each file is matched as by mimeTypeForFile(), but the files are read on
+    several threads of the global QThreadPool, which is faster than calling
+    mimeTypeForFile() in a loop when the contents of many files have to be
+    checked.
+
+    \sa mimeTypeForFile(), QThreadPool::globalInstance()
+*/
+QList<QMimeType> QMimeDatabase::mimeTypesForFiles(const QStringList &fileNames,
+                                                  MatchMode mode) const
+{
+    return d->mimeTypesForFiles(fileNames, mode);
+}
+
 /*!
     Returns the MIME types for the file name \a fileName.
 
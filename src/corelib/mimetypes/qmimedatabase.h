@@ -37,6 +37,8 @@ public:
 
     QMimeType mimeTypeForFile(const QString &fileName, MatchMode mode = MatchDefault) const;
     QMimeType mimeTypeForFile(const QFileInfo &fileInfo, MatchMode mode = MatchDefault) const;
+    QList<QMimeType> mimeTypesForFiles(const QStringList &fileNames,
+                                       MatchMode mode = MatchDefault) const;
     QList<QMimeType> mimeTypesForFileName(const QString &fileName) const;
 
     QMimeType mimeTypeForData(const QByteArray &data) const;
@@ -65,6 +65,9 @@ public:
     QStringList mimeTypeForFileName(const QString &fileName);
     QMimeGlobMatchResult findByFileName(const QString &fileName);
 
+    // Takes care of locking the mutex, but not while reading the files
+    QList<QMimeType> mimeTypesForFiles(const QStringList &fileNames, QMimeDatabase::MatchMode mode);
+
     // API for QMimeType. Takes care of locking the mutex.
     void loadMimeTypePrivate(QMimeTypePrivate &mimePrivate);
     void loadGenericIcon(QMimeTypePrivate &mimePrivate);
@@ -79,6 +82,8 @@ private:
     bool shouldCheck();
     void loadProviders();
     QString fallbackParent(const QString &mimeTypeName) const;
+    QMimeType mimeTypeForGlobsAndData(QMimeGlobMatchResult &candidatesByName, const QByteArray *data);
+    QMimeType mimeTypeForFileUnlocked(const QString &fileName, QMimeDatabase::MatchMode mode);
 
     const QString m_defaultMimeType;
     mutable Providers m_providers;
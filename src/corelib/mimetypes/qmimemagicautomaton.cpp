@@ -0,0 +1,156 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#define QT_NO_CAST_FROM_ASCII
+
+#include "qmimemagicautomaton_p.h"
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \internal
+    \class QMimeMagicAutomaton
+    \inmodule QtCore
+
+    \brief The QMimeMagicAutomaton class finds the values of many magic rules
+    in one pass over the data.
+
+    Most magic rules compare a sequence of bytes against the data at a few
+    offsets. Checking them one by one is slow when nothing matches, as every
+    rule has to be tried at every offset of its range. The automaton combines
+    these sequences into an Aho-Corasick automaton, which finds all of them
+    while reading the data once, up to the furthest offset a pattern can be
+    found at. The providers then only need to check the other conditions of
+    the rules whose pattern was found.
+
+    \sa QMimeMagicRule, QMimeMagicRuleMatcher
+*/
+
+int QMimeMagicAutomaton::addPattern(QByteArrayView value, int startPos, int endPos)
+{
+    Q_ASSERT(!value.isEmpty());
+    m_patterns.append({ startPos, endPos, int(value.size()) });
+    m_values.append(value.toByteArray());
+    return int(m_patterns.size() - 1);
+}
+
+void QMimeMagicAutomaton::build()
+{
+    // Build the trie of the patterns
+    QList<QList<Transition>> edges(1);
+    QList<QList<int>> outputs(1);
+    const auto edge = [&edges](int node, uchar byte) {
+        for (const Transition &t : std::as_const(edges[node])) {
+            if (t.byte == byte)
+                return t.target;
+        }
+        return -1;
+    };
+    for (qsizetype pattern = 0; pattern < m_values.size(); ++pattern) {
+        int node = 0;
+        for (char c : std::as_const(m_values[pattern])) {
+            int target = edge(node, uchar(c));
+            if (target < 0) {
+                target = int(edges.size());
+                edges[node].append({ uchar(c), target });
+                edges.emplace_back();
+                outputs.emplace_back();
+            }
+            node = target;
+        }
+        outputs[node].append(int(pattern));
+        m_scanLength = qMax(m_scanLength, qsizetype(m_patterns.at(pattern).endPos)
+                                                  + m_patterns.at(pattern).length);
+    }
+    m_values.clear();
+
+    // Compute the failure links breadth-first, so that the links of the
+    // shorter prefixes are known
+    m_nodes.resize(edges.size());
+    QList<int> queue;
+    queue.reserve(edges.size());
+    for (const Transition &t : std::as_const(edges[0]))
+        queue.append(t.target);
+    for (qsizetype i = 0; i < queue.size(); ++i) {
+        const int node = queue.at(i);
+        for (const Transition &t : std::as_const(edges[node])) {
+            int failure = m_nodes.at(node).failure;
+            int target = edge(failure, t.byte);
+            while (target < 0 && failure != 0) {
+                failure = m_nodes.at(failure).failure;
+                target = edge(failure, t.byte);
+            }
+            Node &child = m_nodes[t.target];
+            child.failure = qMax(target, 0);
+            child.outputLink = outputs.at(child.failure).isEmpty()
+                    ? m_nodes.at(child.failure).outputLink : child.failure;
+            queue.append(t.target);
+        }
+    }
+
+    // Store the transitions and outputs of all nodes contiguously
+    std::fill(std::begin(m_rootTransitions), std::end(m_rootTransitions), 0);
+    for (const Transition &t : std::as_const(edges[0]))
+        m_rootTransitions[t.byte] = t.target;
+    for (qsizetype i = 0; i < edges.size(); ++i) {
+        Node &node = m_nodes[i];
+        node.firstTransition = int(m_transitions.size());
+        node.transitionCount = int(edges.at(i).size());
+        m_transitions.append(edges.at(i));
+        node.firstOutput = int(m_outputs.size());
+        node.outputCount = int(outputs.at(i).size());
+        m_outputs.append(outputs.at(i));
+    }
+}
+
+void QMimeMagicAutomaton::clear()
+{
+    m_patterns.clear();
+    m_values.clear();
+    m_nodes.clear();
+    m_transitions.clear();
+    m_outputs.clear();
+    m_scanLength = 0;
+}
+
+inline int QMimeMagicAutomaton::next(int state, uchar byte) const
+{
+    while (state != 0) {
+        const Node &node = m_nodes.at(state);
+        // There are very few transitions from any node but the root
+        const Transition *t = m_transitions.constData() + node.firstTransition;
+        for (const Transition *end = t + node.transitionCount; t != end; ++t) {
+            if (t->byte == byte)
+                return t->target;
+        }
+        state = node.failure;
+    }
+    return m_rootTransitions[byte];
+}
+
+void QMimeMagicAutomaton::match(QByteArrayView data, bool *matched) const
+{
+    if (m_nodes.isEmpty())
+        return;
+    const qsizetype end = qMin(data.size(), m_scanLength);
+    int state = 0;
+    for (qsizetype i = 0; i < end; ++i) {
+        state = next(state, uchar(data[i]));
+        const Node &node = m_nodes.at(state);
+        for (int n = node.outputCount ? state : node.outputLink; n >= 0;
+             n = m_nodes.at(n).outputLink) {
+            const Node &outputNode = m_nodes.at(n);
+            for (int o = 0; o < outputNode.outputCount; ++o) {
+                const int pattern = m_outputs.at(outputNode.firstOutput + o);
+                const Pattern &p = m_patterns.at(pattern);
+                const qsizetype start = i + 1 - p.length;
+                if (start >= p.startPos && start <= p.endPos)
+                    matched[pattern] = true;
+            }
+        }
+    }
+}
+
+QT_END_NAMESPACE
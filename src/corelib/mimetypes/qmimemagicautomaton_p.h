@@ -0,0 +1,86 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QMIMEMAGICAUTOMATON_P_H
+#define QMIMEMAGICAUTOMATON_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+
+QT_REQUIRE_CONFIG(mimetype);
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qbytearrayview.h>
+#include <QtCore/qlist.h>
+
+QT_BEGIN_NAMESPACE
+
+class QMimeMagicAutomaton
+{
+public:
+    // Adds a pattern that matches when value is found at an offset between
+    // startPos and endPos, and returns its index for match()
+    int addPattern(QByteArrayView value, int startPos, int endPos);
+    void build();
+    void clear();
+
+    // The patterns added for the magic rules of one MIME type
+    struct PatternRange
+    {
+        int first = 0;
+        int count = 0;
+        bool complete = true;   // false if some of the rules have no pattern
+    };
+
+    qsizetype patternCount() const { return m_patterns.size(); }
+
+    // Sets matched[i] to true for each pattern i that is found in data, in a
+    // single pass over it. matched must have patternCount() elements.
+    void match(QByteArrayView data, bool *matched) const;
+
+private:
+    struct Pattern
+    {
+        int startPos;
+        int endPos;
+        int length;
+    };
+    struct Node
+    {
+        int failure = 0;
+        int outputLink = -1;        // closest node along the failure links with outputs
+        int firstTransition = 0;
+        int transitionCount = 0;
+        int firstOutput = 0;
+        int outputCount = 0;
+    };
+    struct Transition
+    {
+        uchar byte;
+        int target;
+    };
+
+    int next(int state, uchar byte) const;
+
+    QList<Pattern> m_patterns;
+    QList<QByteArray> m_values;     // only until build()
+    QList<Node> m_nodes;
+    QList<Transition> m_transitions; // of each node, sorted by byte
+    QList<int> m_outputs;           // patterns ending at each node
+    int m_rootTransitions[256];
+    qsizetype m_scanLength = 0;
+};
+
+QT_END_NAMESPACE
+
+#endif // QMIMEMAGICAUTOMATON_P_H
@@ -135,6 +135,16 @@ bool QMimeMagicRule::matchNumber(const QByteArray &data) const
     return false;
 }
 
+template <typename T>
+QByteArray QMimeMagicRule::numberLiteral() const
+{
+    if (T(m_numberMask) != T(-1))
+        return QByteArray();
+    QByteArray result(sizeof(T), Qt::Uninitialized);
+    qToUnaligned(T(m_number), result.data());
+    return result;
+}
+
 static inline QByteArray makePattern(const QByteArray &value)
 {
     QByteArray pattern(value.size(), Qt::Uninitialized);
@@ -303,6 +313,32 @@ QByteArray QMimeMagicRule::mask() const
     return result;
 }
 
+// Returns the bytes that the data must contain at one of the offsets for the
+// rule to match, or an empty array if the rule only compares some of the bits.
+// Used by QMimeMagicAutomaton.
+QByteArray QMimeMagicRule::literal() const
+{
+    if (!isValid())
+        return QByteArray();
+    switch (m_type) {
+    case String:
+        return m_mask.count(char(-1)) == m_mask.size() ? m_pattern : QByteArray();
+    case Byte:
+        return numberLiteral<quint8>();
+    case Host16:
+    case Big16:
+    case Little16:
+        return numberLiteral<quint16>();
+    case Host32:
+    case Big32:
+    case Little32:
+        return numberLiteral<quint32>();
+    default:
+        break;
+    }
+    return QByteArray();
+}
+
 bool QMimeMagicRule::matches(const QByteArray &data) const
 {
     const bool ok = m_matchFunction && (this->*m_matchFunction)(data);
@@ -57,6 +57,7 @@ public:
     bool isValid() const { return m_matchFunction != nullptr; }
 
     bool matches(const QByteArray &data) const;
+    QByteArray literal() const;
 
     QList<QMimeMagicRule> m_subMatches;
 
@@ -86,6 +87,8 @@ private:
     bool matchString(const QByteArray &data) const;
     template <typename T>
     bool matchNumber(const QByteArray &data) const;
+    template <typename T>
+    QByteArray numberLiteral() const;
 };
 Q_DECLARE_SHARED(QMimeMagicRule)
 
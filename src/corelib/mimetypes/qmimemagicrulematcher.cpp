@@ -45,11 +45,6 @@ void QMimeMagicRuleMatcher::addRules(const QList<QMimeMagicRule> &rules)
     m_list.append(rules);
 }
 
-QList<QMimeMagicRule> QMimeMagicRuleMatcher::magicRules() const
-{
-    return m_list;
-}
-
 // Check for a match on contents of a file
 bool QMimeMagicRuleMatcher::matches(const QByteArray &data) const
 {
@@ -41,7 +41,7 @@ public:
 
     void addRule(const QMimeMagicRule &rule);
     void addRules(const QList<QMimeMagicRule> &rules);
-    QList<QMimeMagicRule> magicRules() const;
+    const QList<QMimeMagicRule> &magicRules() const { return m_list; }
 
     bool matches(const QByteArray &data) const;
 
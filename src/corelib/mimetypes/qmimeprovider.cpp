@@ -18,6 +18,7 @@
 #include <QDebug>
 #include <QDateTime>
 #include <QtEndian>
+#include <QVarLengthArray>
 
 #if QT_CONFIG(mimetype_database)
 #  if defined(Q_CC_MSVC_ONLY)
@@ -30,6 +31,9 @@ __attribute__((section(".qtmimedatabase"), aligned(4096)))
 #  endif
 
 #  include "qmimeprovider_database.cpp"
+// mime.cache and the list of types, as update-mime-database generates them
+// from the database, if it was available at build time
+#  include "qmimeprovider_cache.cpp"
 
 #  ifdef MIME_DATABASE_IS_ZSTD
 #    if !QT_CONFIG(zstd)
@@ -57,6 +61,53 @@ static inline void appendIfNew(QStringList &list, const QString &str)
         list.push_back(str);
 }
 
+#if QT_CONFIG(mimetype_database)
+static QString internalMimeFileName()
+{
+    return QStringLiteral("<internal MIME data>");
+}
+
+// Returns the XML of the internal database, uncompressed
+static QByteArray internalMimeDatabase()
+{
+    static_assert(sizeof(mimetype_database), "Bundled MIME database is empty");
+    static_assert(sizeof(mimetype_database) <= MimeTypeDatabaseOriginalSize,
+                      "Compressed MIME database is larger than the original size");
+    static_assert(MimeTypeDatabaseOriginalSize <= 16*1024*1024,
+                      "Bundled MIME database is too big");
+
+#ifdef MIME_DATABASE_IS_ZSTD
+    // uncompress with libzstd
+    QByteArray uncompressed(MimeTypeDatabaseOriginalSize, Qt::Uninitialized);
+    const size_t size = ZSTD_decompress(uncompressed.data(), uncompressed.size(),
+                                        mimetype_database, sizeof(mimetype_database));
+    Q_ASSERT(!ZSTD_isError(size));
+    uncompressed.truncate(size);
+    return uncompressed;
+#elif defined(MIME_DATABASE_IS_GZIP)
+    QByteArray uncompressed(MimeTypeDatabaseOriginalSize, Qt::Uninitialized);
+    z_stream zs = {};
+    zs.next_in = const_cast<Bytef *>(mimetype_database);
+    zs.avail_in = sizeof(mimetype_database);
+    zs.next_out = reinterpret_cast<Bytef *>(uncompressed.data());
+    zs.avail_out = uncompressed.size();
+
+    int res = inflateInit2(&zs, MAX_WBITS | 32);
+    Q_ASSERT(res == Z_OK);
+    res = inflate(&zs, Z_FINISH);
+    Q_ASSERT(res == Z_STREAM_END);
+    res = inflateEnd(&zs);
+    Q_ASSERT(res == Z_OK);
+
+    uncompressed.truncate(zs.total_out);
+    return uncompressed;
+#else
+    return QByteArray::fromRawData(reinterpret_cast<const char *>(mimetype_database),
+                                   MimeTypeDatabaseOriginalSize);
+#endif
+}
+#endif // QT_CONFIG(mimetype_database)
+
 QMimeProviderBase::QMimeProviderBase(QMimeDatabasePrivate *db, const QString &directory)
     : m_db(db), m_directory(directory)
 {
@@ -69,9 +120,27 @@ QMimeBinaryProvider::QMimeBinaryProvider(QMimeDatabasePrivate *db, const QString
     ensureLoaded();
 }
 
+#if QT_CONFIG(mimetype_database)
+// Only valid if the cache could be generated at build time
+QMimeBinaryProvider::QMimeBinaryProvider(QMimeDatabasePrivate *db, InternalDatabaseEnum)
+    : QMimeProviderBase(db, internalMimeFileName()), m_mimetypeListLoaded(false)
+{
+    ensureLoaded();
+}
+#else // !QT_CONFIG(mimetype_database)
+// never called in release mode, but some debug builds may need
+// this to be defined.
+QMimeBinaryProvider::QMimeBinaryProvider(QMimeDatabasePrivate *db, InternalDatabaseEnum)
+    : QMimeProviderBase(db, QString())
+{
+    Q_UNREACHABLE();
+}
+#endif // QT_CONFIG(mimetype_database)
+
 struct QMimeBinaryProvider::CacheFile
 {
     CacheFile(const QString &fileName);
+    CacheFile(const uchar *embeddedData);
     ~CacheFile();
 
     bool isValid() const { return m_valid; }
@@ -90,8 +159,10 @@ struct QMimeBinaryProvider::CacheFile
     bool load();
     bool reload();
 
+    bool isEmbedded() const { return !file.isOpen() && data; }
+
     QFile file;
-    uchar *data;
+    uchar *data = nullptr;
     QDateTime m_mtime;
     bool m_valid;
 };
@@ -102,6 +173,15 @@ QMimeBinaryProvider::CacheFile::CacheFile(const QString &fileName)
     load();
 }
 
+// The data is never written to, it is only accessed through the getters
+QMimeBinaryProvider::CacheFile::CacheFile(const uchar *embeddedData)
+    : data(const_cast<uchar *>(embeddedData)), m_valid(false)
+{
+    const int major = getUint16(0);
+    const int minor = getUint16(2);
+    m_valid = (major == 1 && minor >= 1 && minor <= 2);
+}
+
 QMimeBinaryProvider::CacheFile::~CacheFile()
 {
 }
@@ -139,7 +219,11 @@ bool QMimeBinaryProvider::isValid()
 
 bool QMimeBinaryProvider::isInternalDatabase() const
 {
+#if QT_CONFIG(mimetype_database)
+    return m_directory == internalMimeFileName();
+#else
     return false;
+#endif
 }
 
 // Position of the "list offsets" values, at the beginning of the mime.cache file
@@ -157,6 +241,8 @@ enum {
 
 bool QMimeBinaryProvider::checkCacheChanged()
 {
+    if (m_cacheFile->isEmbedded())
+        return false;
     QFileInfo fileInfo(m_cacheFile->file);
     if (fileInfo.lastModified(QTimeZone::UTC) > m_cacheFile->m_mtime) {
         // Deletion can't happen by just running update-mime-database.
@@ -169,15 +255,26 @@ bool QMimeBinaryProvider::checkCacheChanged()
 
 void QMimeBinaryProvider::ensureLoaded()
 {
+    if (isInternalDatabase()) {
+#ifdef MIME_DATABASE_HAS_CACHE
+        if (!m_cacheFile)
+            m_cacheFile = std::make_unique<CacheFile>(mimetype_cache);
+        if (!m_cacheFile->isValid())
+            m_cacheFile.reset();
+#endif
+        return;
+    }
     if (!m_cacheFile) {
         const QString cacheFileName = m_directory + "/mime.cache"_L1;
         m_cacheFile = std::make_unique<CacheFile>(cacheFileName);
         m_mimetypeListLoaded = false;
         m_mimetypeExtra.clear();
+        m_magicAutomatonBuilt = false;
     } else {
         if (checkCacheChanged()) {
             m_mimetypeListLoaded = false;
             m_mimetypeExtra.clear();
+            m_magicAutomatonBuilt = false;
         } else {
             return; // nothing to do
         }
@@ -346,18 +443,79 @@ bool QMimeBinaryProvider::matchMagicRule(QMimeBinaryProvider::CacheFile *cacheFi
     return false;
 }
 
-void QMimeBinaryProvider::findByMagic(const QByteArray &data, int *accuracyPtr, QMimeType &candidate)
+void QMimeBinaryProvider::buildMagicAutomaton()
 {
+    m_magicAutomaton.clear();
+    m_magicPatternRanges.clear();
+    m_magicPatternMatchlets.clear();
+    m_magicAutomatonBuilt = true;
+
     const int magicListOffset = m_cacheFile->getUint32(PosMagicListOffset);
     const int numMatches = m_cacheFile->getUint32(magicListOffset);
-    //const int maxExtent = cacheFile->getUint32(magicListOffset + 4);
     const int firstMatchOffset = m_cacheFile->getUint32(magicListOffset + 8);
+    m_magicPatternRanges.reserve(numMatches);
 
     for (int i = 0; i < numMatches; ++i) {
         const int off = firstMatchOffset + i * 16;
         const int numMatchlets = m_cacheFile->getUint32(off + 8);
         const int firstMatchletOffset = m_cacheFile->getUint32(off + 12);
-        if (matchMagicRule(m_cacheFile.get(), numMatchlets, firstMatchletOffset, data)) {
+        QMimeMagicAutomaton::PatternRange range;
+        range.first = int(m_magicAutomaton.patternCount());
+        for (int matchlet = 0; matchlet < numMatchlets; ++matchlet) {
+            const int matchletOffset = firstMatchletOffset + matchlet * 32;
+            const int rangeStart = m_cacheFile->getUint32(matchletOffset);
+            const int rangeLength = m_cacheFile->getUint32(matchletOffset + 4);
+            const int valueLength = m_cacheFile->getUint32(matchletOffset + 12);
+            const int valueOffset = m_cacheFile->getUint32(matchletOffset + 16);
+            const int maskOffset = m_cacheFile->getUint32(matchletOffset + 20);
+            if (maskOffset || valueLength <= 0) {
+                range.complete = false;
+                continue;
+            }
+            const QByteArrayView value(m_cacheFile->getCharStar(valueOffset), valueLength);
+            m_magicAutomaton.addPattern(value, rangeStart, rangeStart + rangeLength - 1);
+            m_magicPatternMatchlets.append(matchletOffset);
+            ++range.count;
+        }
+        m_magicPatternRanges.append(range);
+    }
+    m_magicAutomaton.build();
+}
+
+void QMimeBinaryProvider::findByMagic(const QByteArray &data, int *accuracyPtr, QMimeType &candidate)
+{
+    if (!m_magicAutomatonBuilt)
+        buildMagicAutomaton();
+
+    // Find the values of the matchlets without a mask in one go, so that only
+    // the entries with one of them, or with other matchlets, need checking
+    QVarLengthArray<bool, 1024> patternMatched(m_magicAutomaton.patternCount(), false);
+    m_magicAutomaton.match(data, patternMatched.data());
+
+    const int magicListOffset = m_cacheFile->getUint32(PosMagicListOffset);
+    //const int maxExtent = cacheFile->getUint32(magicListOffset + 4);
+    const int firstMatchOffset = m_cacheFile->getUint32(magicListOffset + 8);
+
+    for (qsizetype i = 0; i < m_magicPatternRanges.size(); ++i) {
+        const QMimeMagicAutomaton::PatternRange &range = m_magicPatternRanges.at(i);
+        const int off = firstMatchOffset + int(i) * 16;
+        bool matched = false;
+        if (!range.complete) {
+            const int numMatchlets = m_cacheFile->getUint32(off + 8);
+            const int firstMatchletOffset = m_cacheFile->getUint32(off + 12);
+            matched = matchMagicRule(m_cacheFile.get(), numMatchlets, firstMatchletOffset, data);
+        } else {
+            for (int pattern = range.first; !matched && pattern < range.first + range.count; ++pattern) {
+                if (!patternMatched[pattern])
+                    continue;
+                const int matchletOffset = m_magicPatternMatchlets.at(pattern);
+                const int numChildren = m_cacheFile->getUint32(matchletOffset + 24);
+                const int firstChildOffset = m_cacheFile->getUint32(matchletOffset + 28);
+                matched = numChildren == 0 // No submatch? Then we are done.
+                        || matchMagicRule(m_cacheFile.get(), numChildren, firstChildOffset, data);
+            }
+        }
+        if (matched) {
             const int mimeTypeOffset = m_cacheFile->getUint32(off + 4);
             const char *mimeType = m_cacheFile->getCharStar(mimeTypeOffset);
             *accuracyPtr = m_cacheFile->getUint32(off);
@@ -451,6 +609,15 @@ void QMimeBinaryProvider::loadMimeTypeList()
     if (!m_mimetypeListLoaded) {
         m_mimetypeListLoaded = true;
         m_mimetypeNames.clear();
+#ifdef MIME_DATABASE_HAS_CACHE
+        if (isInternalDatabase()) {
+            for (const auto name : QLatin1StringView(mimetype_cache_types).tokenize(u'\n')) {
+                if (!name.isEmpty())
+                    m_mimetypeNames.insert(name.toString());
+            }
+            return;
+        }
+#endif
         // Unfortunately mime.cache doesn't have a full list of all mimetypes.
         // So we have to parse the plain-text files called "types".
         QFile file(m_directory + QStringLiteral("/types"));
@@ -480,6 +647,71 @@ void QMimeBinaryProvider::addAllMimeTypes(QList<QMimeType> &result)
     }
 }
 
+#ifndef QT_NO_XMLSTREAMREADER
+// Reads the comments and glob patterns from the children of the <mime-type>
+// element that \a xml is positioned at
+void QMimeBinaryProvider::readMimeTypeExtra(QXmlStreamReader &xml, MimeTypeExtra &extra)
+{
+    QString mainPattern;
+    while (xml.readNextStartElement()) {
+        const auto tag = xml.name();
+        if (tag == "comment"_L1) {
+            QString lang = xml.attributes().value("xml:lang"_L1).toString();
+            const QString text = xml.readElementText();
+            if (lang.isEmpty()) {
+                lang = "default"_L1; // no locale attribute provided, treat it as default.
+            }
+            extra.localeComments.insert(lang, text);
+            continue; // we called readElementText, so we're at the EndElement already.
+        } else if (tag == "glob-deleteall"_L1) { // as written out by shared-mime-info >= 0.70
+            extra.globPatterns.clear();
+            mainPattern.clear();
+        } else if (tag == "glob"_L1) { // as written out by shared-mime-info >= 0.70
+            const QString pattern = xml.attributes().value("pattern"_L1).toString();
+            if (mainPattern.isEmpty() && pattern.startsWith(u'*')) {
+                mainPattern = pattern;
+            }
+            appendIfNew(extra.globPatterns, pattern);
+        }
+        xml.skipCurrentElement();
+    }
+    Q_ASSERT(xml.name() == "mime-type"_L1);
+
+    // Let's assume that shared-mime-info is at least version 0.70
+    // Otherwise we would need 1) a version check, and 2) code for parsing patterns from the globs file.
+    if (!mainPattern.isEmpty() &&
+            (extra.globPatterns.isEmpty() || extra.globPatterns.constFirst() != mainPattern)) {
+        // ensure it's first in the list of patterns
+        extra.globPatterns.removeAll(mainPattern);
+        extra.globPatterns.prepend(mainPattern);
+    }
+}
+
+// The comments of the internal database are only in its XML, which is
+// parsed in one go the first time that one of them is needed
+void QMimeBinaryProvider::loadInternalMimeTypeExtras()
+{
+#if QT_CONFIG(mimetype_database)
+    if (m_internalExtrasLoaded)
+        return;
+    m_internalExtrasLoaded = true;
+
+    const QByteArray data = internalMimeDatabase();
+    QXmlStreamReader xml(data);
+    if (!xml.readNextStartElement() || xml.name() != "mime-info"_L1)
+        return;
+    while (xml.readNextStartElement()) {
+        if (xml.name() != "mime-type"_L1) {
+            xml.skipCurrentElement();
+            continue;
+        }
+        const QString name = xml.attributes().value("type"_L1).toString();
+        readMimeTypeExtra(xml, m_mimetypeExtra[name]);
+    }
+#endif
+}
+#endif // QT_NO_XMLSTREAMREADER
+
 bool QMimeBinaryProvider::loadMimeTypePrivate(QMimeTypePrivate &data)
 {
 #ifdef QT_NO_XMLSTREAMREADER
@@ -490,8 +722,14 @@ bool QMimeBinaryProvider::loadMimeTypePrivate(QMimeTypePrivate &data)
     if (data.loaded)
         return true;
 
+    if (isInternalDatabase())
+        loadInternalMimeTypeExtras();
+
     auto it = m_mimetypeExtra.constFind(data.name);
     if (it == m_mimetypeExtra.constEnd()) {
+        if (isInternalDatabase())
+            return false;
+
         // load comment and globPatterns
 
         // shared-mime-info since 1.3 lowercases the xml files
@@ -506,7 +744,6 @@ bool QMimeBinaryProvider::loadMimeTypePrivate(QMimeTypePrivate &data)
         auto insertIt = m_mimetypeExtra.insert(data.name, MimeTypeExtra{});
         it = insertIt;
         MimeTypeExtra &extra = insertIt.value();
-        QString mainPattern;
 
         QXmlStreamReader xml(&qfile);
         if (xml.readNextStartElement()) {
@@ -519,38 +756,7 @@ bool QMimeBinaryProvider::loadMimeTypePrivate(QMimeTypePrivate &data)
             if (name.compare(data.name, Qt::CaseInsensitive))
                 qWarning() << "Got name" << name << "in file" << mimeFile << "expected" << data.name;
 
-            while (xml.readNextStartElement()) {
-                const auto tag = xml.name();
-                if (tag == "comment"_L1) {
-                    QString lang = xml.attributes().value("xml:lang"_L1).toString();
-                    const QString text = xml.readElementText();
-                    if (lang.isEmpty()) {
-                        lang = "default"_L1; // no locale attribute provided, treat it as default.
-                    }
-                    extra.localeComments.insert(lang, text);
-                    continue; // we called readElementText, so we're at the EndElement already.
-                } else if (tag == "glob-deleteall"_L1) { // as written out by shared-mime-info >= 0.70
-                    extra.globPatterns.clear();
-                    mainPattern.clear();
-                } else if (tag == "glob"_L1) { // as written out by shared-mime-info >= 0.70
-                    const QString pattern = xml.attributes().value("pattern"_L1).toString();
-                    if (mainPattern.isEmpty() && pattern.startsWith(u'*')) {
-                        mainPattern = pattern;
-                    }
-                    appendIfNew(extra.globPatterns, pattern);
-                }
-                xml.skipCurrentElement();
-            }
-            Q_ASSERT(xml.name() == "mime-type"_L1);
-        }
-
-        // Let's assume that shared-mime-info is at least version 0.70
-        // Otherwise we would need 1) a version check, and 2) code for parsing patterns from the globs file.
-        if (!mainPattern.isEmpty() &&
-                (extra.globPatterns.isEmpty() || extra.globPatterns.constFirst() != mainPattern)) {
-            // ensure it's first in the list of patterns
-            extra.globPatterns.removeAll(mainPattern);
-            extra.globPatterns.prepend(mainPattern);
+            readMimeTypeExtra(xml, extra);
         }
     }
     const MimeTypeExtra &e = it.value();
@@ -607,48 +813,11 @@ void QMimeBinaryProvider::loadGenericIcon(QMimeTypePrivate &data)
 ////
 
 #if QT_CONFIG(mimetype_database)
-static QString internalMimeFileName()
-{
-    return QStringLiteral("<internal MIME data>");
-}
-
 QMimeXMLProvider::QMimeXMLProvider(QMimeDatabasePrivate *db, InternalDatabaseEnum)
     : QMimeProviderBase(db, internalMimeFileName())
 {
-    static_assert(sizeof(mimetype_database), "Bundled MIME database is empty");
-    static_assert(sizeof(mimetype_database) <= MimeTypeDatabaseOriginalSize,
-                      "Compressed MIME database is larger than the original size");
-    static_assert(MimeTypeDatabaseOriginalSize <= 16*1024*1024,
-                      "Bundled MIME database is too big");
-    const char *data = reinterpret_cast<const char *>(mimetype_database);
-    qsizetype size = MimeTypeDatabaseOriginalSize;
-
-#ifdef MIME_DATABASE_IS_ZSTD
-    // uncompress with libzstd
-    std::unique_ptr<char []> uncompressed(new char[size]);
-    size = ZSTD_decompress(uncompressed.get(), size, mimetype_database, sizeof(mimetype_database));
-    Q_ASSERT(!ZSTD_isError(size));
-    data = uncompressed.get();
-#elif defined(MIME_DATABASE_IS_GZIP)
-    std::unique_ptr<char []> uncompressed(new char[size]);
-    z_stream zs = {};
-    zs.next_in = const_cast<Bytef *>(mimetype_database);
-    zs.avail_in = sizeof(mimetype_database);
-    zs.next_out = reinterpret_cast<Bytef *>(uncompressed.get());
-    zs.avail_out = size;
-
-    int res = inflateInit2(&zs, MAX_WBITS | 32);
-    Q_ASSERT(res == Z_OK);
-    res = inflate(&zs, Z_FINISH);
-    Q_ASSERT(res == Z_STREAM_END);
-    res = inflateEnd(&zs);
-    Q_ASSERT(res == Z_OK);
-
-    data = uncompressed.get();
-    size = zs.total_out;
-#endif
-
-    load(data, size);
+    const QByteArray data = internalMimeDatabase();
+    load(data.constData(), data.size());
 }
 #else // !QT_CONFIG(mimetype_database)
 // never called in release mode, but some debug builds may need
@@ -696,18 +865,75 @@ void QMimeXMLProvider::addFileNameMatches(const QString &fileName, QMimeGlobMatc
     m_mimeTypeGlobs.matchingGlobs(fileName, result);
 }
 
+void QMimeXMLProvider::buildMagicAutomaton()
+{
+    m_magicAutomaton.clear();
+    m_magicPatternRanges.clear();
+    m_magicPatternRules.clear();
+    m_magicAutomatonBuilt = true;
+    m_magicPatternRanges.reserve(m_magicMatchers.size());
+
+    for (const QMimeMagicRuleMatcher &matcher : std::as_const(m_magicMatchers)) {
+        QMimeMagicAutomaton::PatternRange range;
+        range.first = int(m_magicAutomaton.patternCount());
+        const QList<QMimeMagicRule> &rules = matcher.magicRules();
+        for (qsizetype i = 0; i < rules.size(); ++i) {
+            const QMimeMagicRule &rule = rules.at(i);
+            const QByteArray literal = rule.literal();
+            if (literal.isEmpty()) {
+                range.complete = false;
+                continue;
+            }
+            m_magicAutomaton.addPattern(literal, rule.startPos(), rule.endPos());
+            m_magicPatternRules.append(int(i));
+            ++range.count;
+        }
+        m_magicPatternRanges.append(range);
+    }
+    m_magicAutomaton.build();
+}
+
+bool QMimeXMLProvider::magicMatcherMatches(qsizetype index, const QByteArray &data,
+                                           const bool *patternMatched) const
+{
+    const QMimeMagicRuleMatcher &matcher = m_magicMatchers.at(index);
+    const QMimeMagicAutomaton::PatternRange &range = m_magicPatternRanges.at(index);
+    if (!range.complete)
+        return matcher.matches(data);
+
+    for (int pattern = range.first; pattern < range.first + range.count; ++pattern) {
+        if (!patternMatched[pattern])
+            continue;
+        const QMimeMagicRule &rule = matcher.magicRules().at(m_magicPatternRules.at(pattern));
+        if (rule.m_subMatches.isEmpty())
+            return true;
+        for (const QMimeMagicRule &subRule : rule.m_subMatches) {
+            if (subRule.matches(data))
+                return true;
+        }
+    }
+    return false;
+}
+
 void QMimeXMLProvider::findByMagic(const QByteArray &data, int *accuracyPtr, QMimeType &candidate)
 {
+    if (!m_magicAutomatonBuilt)
+        buildMagicAutomaton();
+
+    // Find the values of the rules without a mask in one go, so that only the
+    // matchers with one of them, or with other rules, need checking
+    QVarLengthArray<bool, 1024> patternMatched(m_magicAutomaton.patternCount(), false);
+    m_magicAutomaton.match(data, patternMatched.data());
+
     QString candidateName;
     bool foundOne = false;
-    for (const QMimeMagicRuleMatcher &matcher : std::as_const(m_magicMatchers)) {
-        if (matcher.matches(data)) {
-            const int priority = matcher.priority();
-            if (priority > *accuracyPtr) {
-                *accuracyPtr = priority;
-                candidateName = matcher.mimetype();
-                foundOne = true;
-            }
+    for (qsizetype i = 0; i < m_magicMatchers.size(); ++i) {
+        const QMimeMagicRuleMatcher &matcher = m_magicMatchers.at(i);
+        const int priority = matcher.priority();
+        if (priority > *accuracyPtr && magicMatcherMatches(i, data, patternMatched.constData())) {
+            *accuracyPtr = priority;
+            candidateName = matcher.mimetype();
+            foundOne = true;
         }
     }
     if (foundOne)
@@ -733,6 +959,7 @@ void QMimeXMLProvider::ensureLoaded()
     m_parents.clear();
     m_mimeTypeGlobs.clear();
     m_magicMatchers.clear();
+    m_magicAutomatonBuilt = false;
     m_mimeTypesWithDeletedGlobs.clear();
 
     //qDebug() << "Loading" << m_allFiles;
@@ -859,6 +1086,7 @@ void QMimeXMLProvider::addAllMimeTypes(QList<QMimeType> &result)
 void QMimeXMLProvider::addMagicMatcher(const QMimeMagicRuleMatcher &matcher)
 {
     m_magicMatchers.append(matcher);
+    m_magicAutomatonBuilt = false;
 }
 
 QT_END_NAMESPACE
@@ -21,6 +21,7 @@
 QT_REQUIRE_CONFIG(mimetype);
 
 #include "qmimeglobpattern_p.h"
+#include "qmimemagicautomaton_p.h"
 #include <QtCore/qdatetime.h>
 #include <QtCore/qset.h>
 #include <QtCore/qmap.h>
@@ -28,6 +29,7 @@ QT_REQUIRE_CONFIG(mimetype);
 QT_BEGIN_NAMESPACE
 
 class QMimeMagicRuleMatcher;
+class QXmlStreamReader;
 
 class QMimeProviderBase
 {
@@ -85,11 +87,14 @@ public:
 };
 
 /*
-   Parses the files 'mime.cache' and 'types' on demand
+   Parses the files 'mime.cache' and 'types' on demand, or the copies of them
+   that were generated from the internal database at build time
  */
 class QMimeBinaryProvider final : public QMimeProviderBase
 {
 public:
+    enum InternalDatabaseEnum { InternalDatabase };
+    QMimeBinaryProvider(QMimeDatabasePrivate *db, InternalDatabaseEnum);
     QMimeBinaryProvider(QMimeDatabasePrivate *db, const QString &directory);
     virtual ~QMimeBinaryProvider();
 
@@ -110,16 +115,22 @@ public:
 
 private:
     struct CacheFile;
+    struct MimeTypeExtra;
 
     void matchGlobList(QMimeGlobMatchResult &result, CacheFile *cacheFile, int offset, const QString &fileName);
     bool matchSuffixTree(QMimeGlobMatchResult &result, CacheFile *cacheFile, int numEntries,
                          int firstOffset, const QString &fileName, qsizetype charPos,
                          bool caseSensitiveCheck);
     bool matchMagicRule(CacheFile *cacheFile, int numMatchlets, int firstOffset, const QByteArray &data);
+    void buildMagicAutomaton();
     bool isMimeTypeGlobsExcluded(const char *name);
     QLatin1StringView iconForMime(CacheFile *cacheFile, int posListOffset, const QByteArray &inputMime);
     void loadMimeTypeList();
     bool checkCacheChanged();
+#ifndef QT_NO_XMLSTREAMREADER
+    void readMimeTypeExtra(QXmlStreamReader &xml, MimeTypeExtra &extra);
+    void loadInternalMimeTypeExtras();
+#endif
 
     std::unique_ptr<CacheFile> m_cacheFile;
     QStringList m_cacheFileNames;
@@ -132,6 +143,13 @@ private:
         QStringList globPatterns;
     };
     QMap<QString, MimeTypeExtra> m_mimetypeExtra;
+    bool m_internalExtrasLoaded = false;
+
+    // For each magic entry of the cache file, and the matchlet of each pattern
+    QMimeMagicAutomaton m_magicAutomaton;
+    QList<QMimeMagicAutomaton::PatternRange> m_magicPatternRanges;
+    QList<int> m_magicPatternMatchlets;
+    bool m_magicAutomatonBuilt = false;
 };
 
 /*
@@ -174,6 +192,8 @@ public:
 private:
     void load(const QString &fileName);
     void load(const char *data, qsizetype len);
+    void buildMagicAutomaton();
+    bool magicMatcherMatches(qsizetype index, const QByteArray &data, const bool *patternMatched) const;
 
     typedef QHash<QString, QMimeType> NameMimeTypeMap;
     NameMimeTypeMap m_nameMimeTypeMap;
@@ -187,6 +207,12 @@ private:
 
     QList<QMimeMagicRuleMatcher> m_magicMatchers;
     QStringList m_allFiles;
+
+    // For each matcher, and the index of the rule of each pattern
+    QMimeMagicAutomaton m_magicAutomaton;
+    QList<QMimeMagicAutomaton::PatternRange> m_magicPatternRanges;
+    QList<int> m_magicPatternRules;
+    bool m_magicAutomatonBuilt = false;
 };
 
 QT_END_NAMESPACE
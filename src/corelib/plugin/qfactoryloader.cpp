@@ -28,6 +28,7 @@
 
 #if QT_CONFIG(library)
 #  include "qlibrary_p.h"
+#  include "qpluginmetadatacache_p.h"
 #endif
 
 #include <qtcore_tracepoints_p.h>
@@ -232,6 +233,9 @@ inline void QFactoryLoaderPrivate::updateSinglePath(const QString &path)
             libraryList += library.release();
         }
     };
+
+    if (QPluginMetaDataCache *cache = QPluginMetaDataCache::instance())
+        cache->save();
 }
 
 void QFactoryLoader::update()
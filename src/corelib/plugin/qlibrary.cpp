@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 #include "qlibrary.h"
 #include "qlibrary_p.h"
+#include "qpluginmetadatacache_p.h"
 
 #include <q20algorithm.h>
 #include <qbytearraymatcher.h>
@@ -210,7 +211,8 @@ static QLibraryScanResult qt_find_pattern(const char *s, qsizetype s_len, QStrin
                 information could not be read.
   Returns  true if version information is present and successfully read.
 */
-static QLibraryScanResult findPatternUnloaded(const QString &library, QLibraryPrivate *lib)
+static QLibraryScanResult findPatternUnloaded(const QString &library, QLibraryPrivate *lib,
+                                              QByteArray *rawMetaData = nullptr)
 {
     QFile file(library);
     if (!file.open(QIODevice::ReadOnly)) {
@@ -264,6 +266,8 @@ static QLibraryScanResult findPatternUnloaded(const QString &library, QLibraryPr
             qCDebug(qt_lcDebugPlugins, "Found metadata in lib %ls, metadata=\n%s\n",
                     qUtf16Printable(library),
                     QJsonDocument(lib->metaData.toJson()).toJson().constData());
+            if (rawMetaData)
+                *rawMetaData = QByteArray(filedata + r.pos, r.length);
             return r;
         }
     } else {
@@ -726,9 +730,18 @@ void QLibraryPrivate::updatePluginState()
     }
 #endif
 
-    if (!pHnd.loadRelaxed()) {
+    QPluginMetaDataCache *cache = pHnd.loadRelaxed() ? nullptr : QPluginMetaDataCache::instance();
+    const QByteArray cachedMetaData = cache ? cache->metaData(fileName) : QByteArray();
+    if (!cachedMetaData.isNull() && metaData.parse(cachedMetaData)) {
+        // the file didn't change since a process read its metadata
+        qCDebug(qt_lcDebugPlugins, "Found metadata of lib %ls in %ls",
+                qUtf16Printable(fileName), qUtf16Printable(cache->fileName()));
+        success = true;
+    } else if (!pHnd.loadRelaxed()) {
         // scan for the plugin metadata without loading
-        QLibraryScanResult result = findPatternUnloaded(fileName, this);
+        QByteArray rawMetaData;
+        QLibraryScanResult result = findPatternUnloaded(fileName, this,
+                                                        cache ? &rawMetaData : nullptr);
 #if defined(Q_OF_MACH_O)
         if (result.length && result.isEncrypted) {
             // We found the .qtmetadata section, but since the library is encrypted
@@ -743,6 +756,8 @@ void QLibraryPrivate::updatePluginState()
 #endif
         {
             success = result.length != 0;
+            if (success && cache)
+                cache->insert(fileName, rawMetaData);
         }
     } else {
         // library is already loaded (probably via QLibrary)
@@ -63,6 +63,13 @@ using namespace Qt::StringLiterals;
     every instance has called unload(). Right before the unloading
     happens, the root component will also be deleted.
 
+    Before loading a plugin, Qt reads its metadata from the file to check
+    that it is compatible. The metadata is stored in a cache file in
+    QStandardPaths::GenericCacheLocation, so that files that have not
+    changed are not read again when the next application looks for plugins.
+    The environment variable \c QT_PLUGIN_METADATA_CACHE can be set to the
+    path of another cache file, or to an empty value to disable the cache.
+
     See \l{How to Create Qt Plugins} for more information about
     how to make your application extensible through plugins.
 
@@ -0,0 +1,168 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qpluginmetadatacache_p.h"
+
+#include "qcborarray.h"
+#include "qcborvalue.h"
+#include "qdatetime.h"
+#include "qdir.h"
+#include "qfile.h"
+#include "qfileinfo.h"
+#include "qplugin.h"
+#if QT_CONFIG(temporaryfile)
+#  include "qsavefile.h"
+#endif
+#include "qstandardpaths.h"
+#include "qtimezone.h"
+
+#include "private/qlibrary_p.h"
+
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+// The cache file is a CBOR array of the version followed by one array for
+// each plugin: [path, size, modification time, raw metadata]
+static constexpr int CacheVersion = 1;
+
+namespace {
+struct QPluginMetaDataCacheHolder
+{
+    std::unique_ptr<QPluginMetaDataCache> cache;
+
+    QPluginMetaDataCacheHolder()
+    {
+        QString fileName;
+        if (qEnvironmentVariableIsSet("QT_PLUGIN_METADATA_CACHE")) {
+            // an empty value disables the cache
+            fileName = qEnvironmentVariable("QT_PLUGIN_METADATA_CACHE");
+        } else {
+#ifndef QT_NO_STANDARDPATHS
+            const QString dir = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
+            if (!dir.isEmpty())
+                fileName = dir + "/qt" QT_STRINGIFY(QT_VERSION_MAJOR) "/plugin-metadata.cache"_L1;
+#endif
+        }
+        if (!fileName.isEmpty())
+            cache = std::make_unique<QPluginMetaDataCache>(fileName);
+    }
+};
+}
+
+Q_GLOBAL_STATIC(QPluginMetaDataCacheHolder, qt_plugin_metadata_cache)
+
+QPluginMetaDataCache::QPluginMetaDataCache(const QString &fileName)
+    : m_fileName(fileName)
+{
+}
+
+QPluginMetaDataCache *QPluginMetaDataCache::instance()
+{
+    if (qt_plugin_metadata_cache.isDestroyed())
+        return nullptr;
+    return qt_plugin_metadata_cache->cache.get();
+}
+
+bool QPluginMetaDataCache::stat(const QString &fileName, qint64 *size, qint64 *modificationTime)
+{
+    const QFileInfo info(fileName);
+    if (!info.exists())
+        return false;
+    *size = info.size();
+    *modificationTime = info.lastModified(QTimeZone::UTC).toMSecsSinceEpoch();
+    return true;
+}
+
+void QPluginMetaDataCache::load()
+{
+    if (m_loaded)
+        return;
+    m_loaded = true;
+
+    QFile file(m_fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+    const QCborArray array = QCborValue::fromCbor(file.readAll()).toArray();
+    if (array.first().toInteger() != CacheVersion)
+        return;
+    for (qsizetype i = 1; i < array.size(); ++i) {
+        const QCborArray entry = array.at(i).toArray();
+        const QString path = entry.at(0).toString();
+        const QByteArray metaData = entry.at(3).toByteArray();
+        if (path.isEmpty() || metaData.size() < qsizetype(sizeof(QPluginMetaData::Header)))
+            continue;
+        m_entries.insert(path, { entry.at(1).toInteger(), entry.at(2).toInteger(), metaData });
+    }
+    qCDebug(qt_lcDebugPlugins, "Read the metadata of %lld plugins from %ls",
+            qlonglong(m_entries.size()), qUtf16Printable(m_fileName));
+}
+
+QByteArray QPluginMetaDataCache::metaData(const QString &library)
+{
+    qint64 size, modificationTime;
+    if (!stat(library, &size, &modificationTime))
+        return QByteArray();
+
+    QMutexLocker locker(&m_mutex);
+    load();
+    const auto it = m_entries.constFind(library);
+    if (it == m_entries.cend() || it->size != size || it->modificationTime != modificationTime)
+        return QByteArray();
+    return it->metaData;
+}
+
+void QPluginMetaDataCache::insert(const QString &library, const QByteArray &metaData)
+{
+    qint64 size, modificationTime;
+    if (!stat(library, &size, &modificationTime))
+        return;
+
+    QMutexLocker locker(&m_mutex);
+    load();
+    m_entries.insert(library, { size, modificationTime, metaData });
+    m_changed = true;
+}
+
+bool QPluginMetaDataCache::save()
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_changed)
+        return true;
+    m_changed = false;
+
+    QCborArray array;
+    array.append(CacheVersion);
+    for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it) {
+        // drop the plugins that were removed or changed
+        qint64 size, modificationTime;
+        if (!stat(it.key(), &size, &modificationTime) || size != it->size
+            || modificationTime != it->modificationTime) {
+            continue;
+        }
+        array.append(QCborArray{ it.key(), it->size, it->modificationTime, it->metaData });
+    }
+
+    QDir().mkpath(QFileInfo(m_fileName).absolutePath());
+#if QT_CONFIG(temporaryfile)
+    QSaveFile file(m_fileName);
+    file.setDirectWriteFallback(true);
+#else
+    QFile file(m_fileName);
+#endif
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCDebug(qt_lcDebugPlugins, "Cannot write the plugin metadata cache %ls: %ls",
+                qUtf16Printable(m_fileName), qUtf16Printable(file.errorString()));
+        return false;
+    }
+    file.write(QCborValue(std::move(array)).toCbor());
+#if QT_CONFIG(temporaryfile)
+    return file.commit();
+#else
+    return file.error() == QFile::NoError;
+#endif
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,71 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QPLUGINMETADATACACHE_P_H
+#define QPLUGINMETADATACACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of the QLibrary and QFactoryLoader classes.  This header file may change
+// from version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qbytearray.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qstring.h>
+
+QT_REQUIRE_CONFIG(library);
+
+QT_BEGIN_NAMESPACE
+
+// Keeps the metadata of plugins across process starts, so that the plugin
+// files don't have to be read again as long as their size and modification
+// time are the same
+class Q_CORE_EXPORT QPluginMetaDataCache
+{
+public:
+    explicit QPluginMetaDataCache(const QString &fileName);
+    Q_DISABLE_COPY_MOVE(QPluginMetaDataCache)
+
+    // nullptr if disabled with QT_PLUGIN_METADATA_CACHE
+    static QPluginMetaDataCache *instance();
+
+    QString fileName() const { return m_fileName; }
+
+    // Returns the raw metadata (the QPluginMetaData::Header followed by the
+    // CBOR data) of the plugin file named library, or a null QByteArray if
+    // it's unknown or the file changed
+    QByteArray metaData(const QString &library);
+    void insert(const QString &library, const QByteArray &metaData);
+
+    // Writes the cache file if anything was inserted since it was read
+    bool save();
+
+private:
+    struct Entry
+    {
+        qint64 size;
+        qint64 modificationTime;    // in ms since the epoch
+        QByteArray metaData;
+    };
+
+    static bool stat(const QString &fileName, qint64 *size, qint64 *modificationTime);
+    void load();
+
+    QMutex m_mutex;
+    const QString m_fileName;
+    QHash<QString, Entry> m_entries;
+    bool m_loaded = false;
+    bool m_changed = false;
+};
+
+QT_END_NAMESPACE
+
+#endif // QPLUGINMETADATACACHE_P_H
@@ -541,6 +541,29 @@ bool QTextStreamPrivate::scan(const QChar **ptr, int *length, int maxlen, TokenD
         }
         chPtr += startOffset;
 
+        if (delimiter == EndOfLine) {
+            // Look for the newline with a vectorized search instead of
+            // inspecting one character at a time.
+            qsizetype n = endOffset - startOffset;
+            if (maxlen)
+                n = qMin(n, qsizetype(maxlen - totalSize));
+            if (n > 0) {
+                const qsizetype i = QStringView(chPtr, n).indexOf(u'\n');
+                if (i >= 0) {
+                    if (i > 0)
+                        lastChar = chPtr[i - 1];
+                    foundToken = true;
+                    delimSize = (lastChar == u'\r') ? 2 : 1;
+                    consumeDelimiter = true;
+                    n = i + 1;
+                }
+                lastChar = chPtr[n - 1];
+                totalSize += int(n);
+                startOffset += int(n);
+            }
+            continue;
+        }
+
         for (; !foundToken && startOffset < endOffset && (!maxlen || totalSize < maxlen); ++startOffset) {
             const QChar ch = *chPtr++;
             ++totalSize;
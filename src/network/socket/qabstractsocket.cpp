@@ -460,6 +460,9 @@
 #ifndef QABSTRACTSOCKET_BUFFERSIZE
 #define QABSTRACTSOCKET_BUFFERSIZE 32768
 #endif
+#ifndef QABSTRACTSOCKET_MAXWRITECHUNKS
+#define QABSTRACTSOCKET_MAXWRITECHUNKS 64
+#endif
 #define QT_TRANSFER_TIMEOUT 120000
 
 QT_BEGIN_NAMESPACE
@@ -731,7 +734,7 @@ void QAbstractSocketPrivate::connectionNotification()
 
 /*! \internal
 
-    Writes one pending data block in the write buffer to the socket.
+    Writes pending data blocks in the write buffer to the socket.
 
     It is usually invoked by canWriteNotification after one or more
     calls to write().
@@ -759,11 +762,26 @@ bool QAbstractSocketPrivate::writeToSocket()
         return false;
     }
 
-    qint64 nextSize = writeBuffer.nextDataBlockSize();
-    const char *ptr = writeBuffer.readPointer();
+    // Gather the leading chunks of the write buffer, so that the engine
+    // can send them with a single system call.
+    QVarLengthArray<QByteArrayView, QABSTRACTSOCKET_MAXWRITECHUNKS> chunks;
+    for (qint64 pos = 0; chunks.size() < QABSTRACTSOCKET_MAXWRITECHUNKS; ) {
+        qint64 size;
+        const char *ptr = writeBuffer.readPointerAtPosition(pos, size);
+        if (!ptr)
+            break;
+        chunks.append(QByteArrayView(ptr, size));
+        pos += size;
+    }
 
-    // Attempt to write it all in one chunk.
-    qint64 written = nextSize ? socketEngine->write(ptr, nextSize) : Q_INT64_C(0);
+    // Attempt to write it all in one go.
+    qint64 written;
+    if (chunks.size() > 1)
+        written = socketEngine->writeVectored(chunks.constData(), chunks.size());
+    else if (chunks.size() == 1)
+        written = socketEngine->write(chunks.first().data(), chunks.first().size());
+    else
+        written = 0;
     if (written < 0) {
 #if defined (QABSTRACTSOCKET_DEBUG)
         qDebug() << "QAbstractSocketPrivate::writeToSocket() write error, aborting."
@@ -2478,6 +2496,47 @@ qint64 QAbstractSocket::writeData(const char *data, qint64 size)
     return written;
 }
 
+/*! \internal
+
+    Unbuffered TCP sockets with nothing queued hand all buffers to the
+    socket engine in one vectored write and buffer whatever was not
+    written. Every other case appends the buffers to the write buffer
+    through writeData(), to be sent together by writeToSocket().
+*/
+qint64 QAbstractSocketPrivate::writeVectored(const QByteArrayView *data, qsizetype count)
+{
+    if (isBuffered || socketType != QAbstractSocket::TcpSocket || !socketEngine
+        || !writeBuffer.isEmpty() || state == QAbstractSocket::UnconnectedState) {
+        return QIODevicePrivate::writeVectored(data, count);
+    }
+
+    qint64 written = socketEngine->writeVectored(data, count);
+    if (written < 0) {
+        setError(socketEngine->error(), socketEngine->errorString());
+        return written;
+    }
+
+    // Buffer what was not written yet
+    qint64 total = 0;
+    for (qsizetype i = 0; i < count; ++i) {
+        const qint64 size = data[i].size();
+        total += size;
+        if (written >= size) {
+            written -= size;
+        } else {
+            write(data[i].data() + written, size - written);
+            written = 0;
+        }
+    }
+    if (!writeBuffer.isEmpty())
+        socketEngine->setWriteNotificationEnabled(true);
+
+#if defined (QABSTRACTSOCKET_DEBUG)
+    qDebug("QAbstractSocketPrivate::writeVectored(%lld buffers) == %lli", qint64(count), total);
+#endif
+    return total; // actually written + what has been buffered
+}
+
 /*!
     \since 4.1
 
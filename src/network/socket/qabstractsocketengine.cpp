@@ -109,6 +109,32 @@ void QAbstractSocketEngine::setError(QAbstractSocket::SocketError error, const Q
     d->socketErrorString = errorString;
 }
 
+/*!
+    \internal
+
+    Writes \a count buffers starting at \a data to the socket, in order.
+    Returns the number of bytes written, or -1 if an error occurred.
+
+    The default implementation calls write() for each buffer and stops at
+    the first short write; engines that can gather several buffers into one
+    system call reimplement it.
+*/
+qint64 QAbstractSocketEngine::writeVectored(const QByteArrayView *data, qsizetype count)
+{
+    qint64 written = 0;
+    for (qsizetype i = 0; i < count; ++i) {
+        if (data[i].isEmpty())
+            continue;
+        const qint64 ret = write(data[i].data(), data[i].size());
+        if (ret < 0)
+            return written ? written : ret;
+        written += ret;
+        if (ret < data[i].size())
+            break;
+    }
+    return written;
+}
+
 void QAbstractSocketEngine::setReceiver(QAbstractSocketEngineReceiver *receiver)
 {
     d_func()->receiver = receiver;
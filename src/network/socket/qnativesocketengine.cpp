@@ -882,6 +882,19 @@ qint64 QNativeSocketEngine::write(const char *data, qint64 size)
     return d->nativeWrite(data, size);
 }
 
+/*!
+    Writes \a count buffers starting at \a data to the socket with a
+    single gathering system call. Returns the number of bytes written, or
+    -1 if an error occurred.
+*/
+qint64 QNativeSocketEngine::writeVectored(const QByteArrayView *data, qsizetype count)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::writeVectored(), -1);
+    Q_CHECK_STATE(QNativeSocketEngine::writeVectored(), QAbstractSocket::ConnectedState, -1);
+    return d->nativeWrite(data, count);
+}
+
 
 qint64 QNativeSocketEngine::bytesToWrite() const
 {
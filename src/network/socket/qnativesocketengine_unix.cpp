@@ -1299,6 +1299,61 @@ qint64 QNativeSocketEnginePrivate::nativeWrite(const char *data, qint64 len)
 
     return qint64(writtenBytes);
 }
+
+qint64 QNativeSocketEnginePrivate::nativeWrite(const QByteArrayView *data, qsizetype count)
+{
+    Q_Q(QNativeSocketEngine);
+
+#ifdef IOV_MAX
+    count = qMin(count, qsizetype(IOV_MAX));
+#endif
+    QVarLengthArray<struct iovec, 16> vec;
+    vec.reserve(count);
+    for (qsizetype i = 0; i < count; ++i) {
+        if (data[i].isEmpty())
+            continue;
+        struct iovec v;
+        v.iov_base = const_cast<char *>(data[i].data());
+        v.iov_len = size_t(data[i].size());
+        vec.append(v);
+    }
+    if (vec.isEmpty())
+        return 0;
+
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = vec.data();
+    msg.msg_iovlen = vec.size();
+
+    ssize_t writtenBytes = qt_safe_sendmsg(socketDescriptor, &msg, 0);
+
+    if (writtenBytes < 0) {
+        switch (errno) {
+        case EPIPE:
+        case ECONNRESET:
+            writtenBytes = -1;
+            setError(QAbstractSocket::RemoteHostClosedError, RemoteHostClosedErrorString);
+            q->close();
+            break;
+        case EAGAIN:
+            writtenBytes = 0;
+            break;
+        case EMSGSIZE:
+            setError(QAbstractSocket::DatagramTooLargeError, DatagramTooLargeErrorString);
+            break;
+        default:
+            break;
+        }
+    }
+
+#if defined (QNATIVESOCKETENGINE_DEBUG)
+    qDebug("QNativeSocketEnginePrivate::nativeWrite(%d buffers) == %i",
+           int(vec.size()), (int) writtenBytes);
+#endif
+
+    return qint64(writtenBytes);
+}
+
 /*
 */
 qint64 QNativeSocketEnginePrivate::nativeRead(char *data, qint64 maxSize)
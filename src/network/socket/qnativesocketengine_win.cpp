@@ -1384,6 +1384,53 @@ qint64 QNativeSocketEnginePrivate::nativeWrite(const char *data, qint64 len)
     return ret;
 }
 
+qint64 QNativeSocketEnginePrivate::nativeWrite(const QByteArrayView *data, qsizetype count)
+{
+    Q_Q(QNativeSocketEngine);
+
+    QVarLengthArray<WSABUF, 16> bufs;
+    bufs.reserve(count);
+    for (qsizetype i = 0; i < count; ++i) {
+        if (data[i].isEmpty())
+            continue;
+        WSABUF buf;
+        buf.buf = const_cast<char *>(data[i].data());
+        buf.len = ULONG(data[i].size());
+        bufs.append(buf);
+    }
+    if (bufs.isEmpty())
+        return 0;
+
+    DWORD bytesWritten = 0;
+    int socketRet = ::WSASend(socketDescriptor, bufs.data(), DWORD(bufs.size()), &bytesWritten,
+                              0, 0, 0);
+    qint64 ret = qint64(bytesWritten);
+
+    int err;
+    if (socketRet == SOCKET_ERROR
+        && (err = WSAGetLastError()) != WSAEWOULDBLOCK && err != WSAENOBUFS) {
+        // WSAENOBUFS is handled like a partial write: the caller retries with
+        // whatever is left in its buffer.
+        WS_ERROR_DEBUG(err);
+        switch (err) {
+        case WSAECONNRESET:
+        case WSAECONNABORTED:
+            ret = -1;
+            setError(QAbstractSocket::NetworkError, WriteErrorString);
+            q->close();
+            break;
+        default:
+            break;
+        }
+    }
+
+#if defined (QNATIVESOCKETENGINE_DEBUG)
+    qDebug("QNativeSocketEnginePrivate::nativeWrite(%d buffers) == %lli", int(bufs.size()), ret);
+#endif
+
+    return ret;
+}
+
 qint64 QNativeSocketEnginePrivate::nativeRead(char *data, qint64 maxLength)
 {
     qint64 ret = -1;
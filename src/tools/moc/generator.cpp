@@ -18,6 +18,9 @@
 #include <math.h>
 #include <stdio.h>
 
+#include <algorithm>
+#include <numeric>
+
 #include <private/qmetaobject_p.h> //for the flags.
 #include <private/qplugin_p.h> //for the flags.
 
@@ -200,6 +203,90 @@ bool Generator::registerableMetaType(const QByteArray &propertyType)
 
 /* returns \c true if name and qualifiedName refers to the same name.
  * If qualified name is "A::B::C", it returns \c true for "C", "B::C" or "A::B::C" */
+// Builds a perfect hash table of the distinct names, as described in
+// QMetaObjectPrivate: table gets the bucket count, slot count and seeds, and
+// slotOfName the slot of each name. Returns false if two names have the same hash.
+static bool buildNameHashTable(const QList<QByteArray> &names, QList<uint> *table,
+                               QList<int> *slotOfName)
+{
+    const qsizetype count = names.size();
+    QList<uint> hashes;
+    hashes.reserve(count);
+    for (const QByteArray &name : names)
+        hashes.append(QMetaObjectPrivate::nameHash(name.constData(), name.size()));
+    QList<uint> sortedHashes = hashes;
+    std::sort(sortedHashes.begin(), sortedHashes.end());
+    if (std::adjacent_find(sortedHashes.cbegin(), sortedHashes.cend()) != sortedHashes.cend())
+        return false;
+
+    // About four names per bucket and a load factor of at most 0.8
+    uint bucketCount = 1;
+    while (bucketCount * 4 < quint64(count))
+        bucketCount *= 2;
+    uint slotCount = 1;
+    while (slotCount * 4 < quint64(count) * 5)
+        slotCount *= 2;
+
+    QList<QList<int>> buckets(bucketCount);
+    for (int i = 0; i < count; ++i)
+        buckets[QMetaObjectPrivate::nameHashMix(hashes.at(i), 0) & (bucketCount - 1)].append(i);
+    // The biggest buckets are placed first, while most slots are free
+    QList<int> order(bucketCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&buckets](int a, int b) {
+        return buckets.at(a).size() > buckets.at(b).size();
+    });
+
+    constexpr uint MaxSeed = 1 << 16;
+    for (; slotCount <= (1 << 20); slotCount *= 2) {
+        QList<uint> seeds(bucketCount, 0);
+        QList<bool> used(slotCount, false);
+        slotOfName->fill(-1, count);
+        bool placed = true;
+        for (int b : std::as_const(order)) {
+            const QList<int> &bucket = buckets.at(b);
+            uint seed = 1;
+            for (; !bucket.isEmpty() && seed < MaxSeed; ++seed) {
+                qsizetype n = 0;
+                for (; n < bucket.size(); ++n) {
+                    const int slot = QMetaObjectPrivate::nameHashMix(hashes.at(bucket.at(n)), seed)
+                            & (slotCount - 1);
+                    if (used.at(slot))
+                        break;
+                    used[slot] = true;
+                    (*slotOfName)[bucket.at(n)] = slot;
+                }
+                if (n == bucket.size())
+                    break;
+                while (n--)
+                    used[slotOfName->at(bucket.at(n))] = false;
+            }
+            if (seed == MaxSeed) {
+                placed = false;
+                break;
+            }
+            seeds[b] = seed;
+        }
+        if (placed) {
+            *table = { bucketCount, slotCount };
+            table->append(seeds);
+            return true;
+        }
+    }
+    return false;
+}
+
+static void printUIntList(FILE *out, const QList<uint> &list)
+{
+    for (qsizetype i = 0; i < list.size(); ++i) {
+        if (i % 8 == 0)
+            fprintf(out, "   ");
+        fprintf(out, " %4u,", list.at(i));
+        if (i % 8 == 7 || i == list.size() - 1)
+            fputc('\n', out);
+    }
+}
+
 static bool qualifiedNameEquals(const QByteArray &qualifiedName, const QByteArray &name)
 {
     if (qualifiedName == name)
@@ -382,6 +469,13 @@ void Generator::generateCode()
     fprintf(out, "    %4d, %4d, // constructors\n", isConstructible ? int(cdef->constructorList.size()) : 0,
             isConstructible ? index : 0);
 
+    if (isConstructible)
+        index += cdef->constructorList.size() * QMetaObjectPrivate::IntsPerMethod;
+
+    QList<uint> methodNameHashTable;
+    QList<uint> propertyNameHashTable;
+    const bool hasNameHashTables = buildNameHashTables(&methodNameHashTable, &propertyNameHashTable);
+
     int flags = 0;
     if (cdef->hasQGadget || cdef->hasQNamespace) {
         // Ideally, all the classes could have that flag. But this broke classes generated
@@ -390,6 +484,7 @@ void Generator::generateCode()
     }
     fprintf(out, "    %4d,       // flags\n", flags);
     fprintf(out, "    %4d,       // signalCount\n", int(cdef->signalList.size()));
+    fprintf(out, "    %4d,       // nameHashData\n", hasNameHashTables ? index : 0);
 
 
 //
@@ -449,6 +544,16 @@ void Generator::generateCode()
     if (isConstructible)
         generateFunctions(cdef->constructorList, "constructor", MethodConstructor, paramsIndex, initialMetaTypeOffset);
 
+//
+// Build the hash tables of the method and property names
+//
+    if (hasNameHashTables) {
+        fprintf(out, "\n // method names: buckets, slots, seeds, offsets, indexes\n");
+        printUIntList(out, methodNameHashTable);
+        fprintf(out, "\n // property names: buckets, slots, seeds, indexes + 1\n");
+        printUIntList(out, propertyNameHashTable);
+    }
+
 //
 // Terminate data array
 //
@@ -698,6 +803,66 @@ void Generator::generateCode()
 }
 
 
+bool Generator::buildNameHashTables(QList<uint> *methodTable, QList<uint> *propertyTable)
+{
+    const QList<FunctionDef> methods = cdef->signalList + cdef->slotList + cdef->methodList;
+    if (methods.isEmpty() && cdef->propertyList.isEmpty())
+        return false;
+
+    // Overloads share a slot, in which the methods are listed in ascending order
+    QList<QByteArray> names;
+    QList<int> nameOfMethod;
+    QHash<QByteArray, int> nameIndexes;
+    for (const FunctionDef &f : methods) {
+        auto it = nameIndexes.constFind(f.name);
+        if (it == nameIndexes.cend()) {
+            it = nameIndexes.insert(f.name, int(names.size()));
+            names.append(f.name);
+        }
+        nameOfMethod.append(*it);
+    }
+    QList<int> slotOfName;
+    *methodTable = { 0, 0 };
+    if (!names.isEmpty()) {
+        if (!buildNameHashTable(names, methodTable, &slotOfName))
+            return false;
+        const uint slotCount = methodTable->at(1);
+        QList<uint> offsets(slotCount + 1, 0);
+        for (int name : std::as_const(nameOfMethod))
+            ++offsets[slotOfName.at(name) + 1];
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+        QList<uint> indexes(methods.size());
+        QList<uint> next = offsets;
+        for (int i = 0; i < methods.size(); ++i)
+            indexes[next[slotOfName.at(nameOfMethod.at(i))]++] = i;
+        methodTable->append(offsets);
+        methodTable->append(indexes);
+    }
+
+    // Like the linear search, the first of several properties with the same name wins
+    names.clear();
+    QList<int> propertyIndexes;
+    nameIndexes.clear();
+    for (int i = 0; i < cdef->propertyList.size(); ++i) {
+        const QByteArray &name = cdef->propertyList.at(i).name;
+        if (nameIndexes.contains(name))
+            continue;
+        nameIndexes.insert(name, int(names.size()));
+        names.append(name);
+        propertyIndexes.append(i);
+    }
+    *propertyTable = { 0, 0 };
+    if (!names.isEmpty()) {
+        if (!buildNameHashTable(names, propertyTable, &slotOfName))
+            return false;
+        QList<uint> indexes(propertyTable->at(1), 0);
+        for (int i = 0; i < names.size(); ++i)
+            indexes[slotOfName.at(i)] = propertyIndexes.at(i) + 1;
+        propertyTable->append(indexes);
+    }
+    return true;
+}
+
 void Generator::registerClassInfoStrings()
 {
     for (int i = 0; i < cdef->classInfoList.size(); ++i) {
@@ -0,0 +1,92 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFile>
+
+#include <private/qbinarylogging_p.h>
+#include <private/qlogging_p.h>
+
+#include <stdio.h>
+
+QT_USE_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+int main(int argc, char **argv)
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationVersion(QT_VERSION_STR ""_L1);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+            "Formats the messages of a binary log, written by an application run with the "
+            "QT_LOGGING_BINARY environment variable set, like the default message handler "
+            "would have."_L1);
+    parser.addHelpOption();
+    parser.addVersionOption();
+    const QCommandLineOption patternOption(
+            u"pattern"_s,
+            u"Format the messages with <pattern>, as QT_MESSAGE_PATTERN does."_s,
+            u"pattern"_s);
+    parser.addOption(patternOption);
+    const QCommandLineOption outputOption(
+            { u"o"_s, u"output"_s }, u"Write the messages to <file> instead of stdout."_s,
+            u"file"_s);
+    parser.addOption(outputOption);
+    parser.addPositionalArgument(u"log"_s, u"The binary log file."_s);
+    parser.process(app);
+
+    const QStringList files = parser.positionalArguments();
+    if (files.size() != 1)
+        parser.showHelp(EXIT_FAILURE);
+
+    QFile input(files.first());
+    if (!input.open(QIODevice::ReadOnly)) {
+        fprintf(stderr, "qtlogdecode: Cannot open %s: %s\n", qPrintable(input.fileName()),
+                qPrintable(input.errorString()));
+        return EXIT_FAILURE;
+    }
+
+    QFile output;
+    if (parser.isSet(outputOption)) {
+        output.setFileName(parser.value(outputOption));
+        if (!output.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            fprintf(stderr, "qtlogdecode: Cannot open %s: %s\n", qPrintable(output.fileName()),
+                    qPrintable(output.errorString()));
+            return EXIT_FAILURE;
+        }
+    } else if (!output.open(stdout, QIODevice::WriteOnly | QIODevice::Text)) {
+        return EXIT_FAILURE;
+    }
+
+    if (parser.isSet(patternOption))
+        qSetMessagePattern(parser.value(patternOption));
+
+    QBinaryLogging::Reader reader;
+    const bool ok = reader.read(&input);
+    for (const QBinaryLogging::Reader::Message &message : reader.messages()) {
+        const QMessageLogContext context(message.file.isNull() ? nullptr : message.file.constData(),
+                                         message.line,
+                                         message.function.isNull() ? nullptr : message.function.constData(),
+                                         message.category.isNull() ? nullptr : message.category.constData());
+        const qint64 msecs = message.nsecsSinceStart / (1000 * 1000);
+        const QMessageLogCapture capture = {
+            message.threadId, nullptr,
+            reader.startMSecsSinceEpoch() + msecs,
+            (reader.startNSecsSinceReference() + message.nsecsSinceStart) / (1000 * 1000),
+            msecs
+        };
+        QString text = QtPrivate::formatLogMessage(message.type, context, message.text, capture);
+        text += u'\n';
+        output.write(text.toLocal8Bit());
+    }
+
+    if (!ok) {
+        fprintf(stderr, "qtlogdecode: %s: %s\n", qPrintable(input.fileName()),
+                qPrintable(reader.errorString()));
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -10,6 +10,8 @@
 #include <QSet>
 #include <QRandomGenerator>
 
+#include <numeric>
+
 #include "../testhelper_functions.h"
 
 class tst_QtConcurrentMap : public QObject
@@ -31,6 +33,8 @@ private slots:
     void mappedReducedInitialValueWithMoveOnlyCallable();
     void mappedReducedDifferentTypeInitialValue();
     void mappedReduceOptionConvertableToResultType();
+    void chunkedMappedReduced();
+    void chunkedMappedReducedThreadPool();
     void assignResult();
     void functionOverloads();
     void noExceptFunctionOverloads();
@@ -1657,6 +1661,83 @@ int sleeper(int val)
     return val;
 }
 
+static qint64 sumChunk(QList<int>::const_iterator begin, QList<int>::const_iterator end)
+{
+    return std::accumulate(begin, end, qint64(0));
+}
+
+void tst_QtConcurrentMap::chunkedMappedReduced()
+{
+    QList<int> list(1000);
+    std::iota(list.begin(), list.end(), 1);
+    const qint64 sum = 1000 * 1001 / 2;
+    const auto add = [](qint64 &result, qint64 intermediate) { result += intermediate; };
+
+    for (qsizetype chunkSize : { 0, 1, 7, 1000, 5000 }) {
+        QCOMPARE(QtConcurrent::chunkedMappedReduced(list, sumChunk, add, chunkSize).result(), sum);
+        QCOMPARE(QtConcurrent::chunkedMappedReduced(list.cbegin(), list.cend(), sumChunk, add,
+                                                    chunkSize).result(), sum);
+        QCOMPARE(QtConcurrent::blockingChunkedMappedReduced(list, sumChunk, add, chunkSize), sum);
+        QCOMPARE(QtConcurrent::blockingChunkedMappedReduced(list.cbegin(), list.cend(), sumChunk,
+                                                            add, chunkSize), sum);
+    }
+
+    // the results are combined in the order of the sequence
+    QStringList words;
+    for (int i = 0; i < 100; ++i)
+        words.append(QString::number(i));
+    const auto join = [](QStringList::const_iterator begin, QStringList::const_iterator end) {
+        QString result;
+        for (auto it = begin; it != end; ++it)
+            result += *it + QLatin1Char(' ');
+        return result;
+    };
+    const auto append = [](QString &result, const QString &intermediate) {
+        result += intermediate;
+    };
+    const QString joined = join(words.cbegin(), words.cend());
+    for (qsizetype chunkSize : { 0, 1, 3, 99, 100 })
+        QCOMPARE(QtConcurrent::blockingChunkedMappedReduced(words, join, append, chunkSize), joined);
+
+    QCOMPARE(QtConcurrent::blockingChunkedMappedReduced(QList<int>(), sumChunk, add), qint64(0));
+}
+
+void tst_QtConcurrentMap::chunkedMappedReducedThreadPool()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+
+    std::vector<int> vector(10000);
+    std::iota(vector.begin(), vector.end(), 0);
+    const auto countEven = [](std::vector<int>::const_iterator begin,
+                              std::vector<int>::const_iterator end) {
+        return qsizetype(std::count_if(begin, end, [](int i) { return i % 2 == 0; }));
+    };
+    const auto add = [](qsizetype &result, qsizetype intermediate) { result += intermediate; };
+
+    QCOMPARE(QtConcurrent::chunkedMappedReduced(&pool, vector, countEven, add).result(),
+             qsizetype(5000));
+    QCOMPARE(QtConcurrent::chunkedMappedReduced(&pool, vector.cbegin(), vector.cend(), countEven,
+                                                add, 100).result(), qsizetype(5000));
+    QCOMPARE(QtConcurrent::blockingChunkedMappedReduced(&pool, vector, countEven, add, 1),
+             qsizetype(5000));
+    QCOMPARE(QtConcurrent::blockingChunkedMappedReduced(&pool, vector.cbegin(), vector.cend(),
+                                                        countEven, add), qsizetype(5000));
+
+    // the chunks are mapped in the threads of the pool
+    QMutex mutex;
+    QSet<QThread *> threads;
+    const auto countItems = [&](auto begin, auto end) {
+        QMutexLocker locker(&mutex);
+        threads.insert(QThread::currentThread());
+        return qsizetype(std::distance(begin, end));
+    };
+    QCOMPARE(QtConcurrent::blockingChunkedMappedReduced(&pool, vector, countItems, add, 10),
+             qsizetype(vector.size()));
+    QVERIFY(!threads.isEmpty());
+    QVERIFY(threads.size() <= pool.maxThreadCount());
+}
+
 void tst_QtConcurrentMap::assignResult()
 {
     const QList<int> startList = QList<int>() << 0 << 1 << 2;
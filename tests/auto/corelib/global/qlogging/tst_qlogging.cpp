@@ -11,6 +11,10 @@
 #include <QtTest/QTest>
 #include <QList>
 #include <QMap>
+#include <QTemporaryDir>
+
+#include <private/qbinarylogging_p.h>
+#include <private/qlogging_p.h>
 
 class tst_qmessagehandler : public QObject
 {
@@ -36,11 +40,14 @@ private slots:
 
     void qMessagePattern_data();
     void qMessagePattern();
+    void setMessagePattern_data();
     void setMessagePattern();
 
     void formatLogMessage_data();
     void formatLogMessage();
 
+    void binaryOutput();
+
 private:
     QString backtraceHelperPath();
 #if QT_CONFIG(process)
@@ -74,6 +81,7 @@ void tst_qmessagehandler::initTestCase()
 #if QT_CONFIG(process)
     m_baseEnvironment = QProcessEnvironment::systemEnvironment();
     m_baseEnvironment.remove("QT_MESSAGE_PATTERN");
+    m_baseEnvironment.remove("QT_LOGGING_ASYNC");
     m_baseEnvironment.insert("QT_FORCE_STDERR_LOGGING", "1");
 #endif // QT_CONFIG(process)
 }
@@ -867,6 +875,15 @@ void tst_qmessagehandler::qMessagePattern()
 #endif
 }
 
+void tst_qmessagehandler::setMessagePattern_data()
+{
+    QTest::addColumn<QByteArray>("async");
+
+    QTest::newRow("sync") << QByteArray();
+    QTest::newRow("async") << QByteArray("1");
+    QTest::newRow("async-drop") << QByteArray("drop");
+}
+
 void tst_qmessagehandler::setMessagePattern()
 {
 #if !QT_CONFIG(process)
@@ -875,6 +892,7 @@ void tst_qmessagehandler::setMessagePattern()
 #ifdef Q_OS_ANDROID
     QSKIP("This test crashes on Android");
 #endif
+    QFETCH(QByteArray, async);
 
     //
     // test qSetMessagePattern
@@ -884,7 +902,10 @@ void tst_qmessagehandler::setMessagePattern()
     const QString appExe(backtraceHelperPath());
 
     // make sure there is no QT_MESSAGE_PATTERN in the environment
-    process.setProcessEnvironment(m_baseEnvironment);
+    QProcessEnvironment environment = m_baseEnvironment;
+    if (!async.isEmpty())
+        environment.insert("QT_LOGGING_ASYNC", QString::fromLatin1(async));
+    process.setProcessEnvironment(environment);
 
     process.start(appExe);
     QVERIFY2(process.waitForStarted(), qPrintable(
@@ -970,6 +991,67 @@ void tst_qmessagehandler::formatLogMessage()
     QCOMPARE(r, result);
 }
 
+QT_WARNING_PUSH
+// QString::asprintf() takes char16_t strings for %ls and prints null as "(null)"
+QT_WARNING_DISABLE_GCC("-Wformat")
+QT_WARNING_DISABLE_GCC("-Wformat-overflow")
+void tst_qmessagehandler::binaryOutput()
+{
+    QTemporaryDir dir;
+    QVERIFY2(dir.isValid(), qPrintable(dir.errorString()));
+    const QString fileName = dir.filePath("log.qtbinlog");
+
+    qInstallMessageHandler(nullptr);
+    QVERIFY(QtPrivate::setBinaryMessageOutput(fileName));
+    const int value = -42;
+    const char *text = "text";
+    const char16_t *utf16 = u"utf16 \u00e9";
+    const void *pointer = &value;
+    qDebug("plain");
+    qDebug("%d %i %u %x %X %o %c", value, 7, 8u, 255, 255, 8, 'c');
+    qInfo("%5.2f|%-8s|%*d|%.3s", 3.14159, text, 6, value, "abcdef");
+    qWarning("%s %ls %p %%", text, utf16, pointer);
+    qWarning("%lld %llu %zu %ld", -(Q_INT64_C(1) << 40), ~Q_UINT64_C(0), size_t(12), -5L);
+    qCritical("%s", static_cast<const char *>(nullptr));
+    qDebug() << "stream" << 1 << 2.5;
+    const int line = __LINE__; qInfo("with context");
+    QVERIFY(QtPrivate::setBinaryMessageOutput(QString()));
+
+    const QStringList expected = {
+        QStringLiteral("plain"),
+        QString::asprintf("%d %i %u %x %X %o %c", value, 7, 8u, 255, 255, 8, 'c'),
+        QString::asprintf("%5.2f|%-8s|%*d|%.3s", 3.14159, text, 6, value, "abcdef"),
+        QString::asprintf("%s %ls %p %%", text, utf16, pointer),
+        QString::asprintf("%lld %llu %zu %ld", -(Q_INT64_C(1) << 40), ~Q_UINT64_C(0), size_t(12), -5L),
+        QString::asprintf("%s", static_cast<const char *>(nullptr)),
+        QStringLiteral("stream 1 2.5"),
+        QStringLiteral("with context"),
+    };
+    const QList<QtMsgType> types = {
+        QtDebugMsg, QtDebugMsg, QtInfoMsg, QtWarningMsg, QtWarningMsg, QtCriticalMsg,
+        QtDebugMsg, QtInfoMsg
+    };
+
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QBinaryLogging::Reader reader;
+    QVERIFY2(reader.read(&file), qPrintable(reader.errorString()));
+    QCOMPARE(reader.pid(), QCoreApplication::applicationPid());
+    const QList<QBinaryLogging::Reader::Message> &messages = reader.messages();
+    QCOMPARE(messages.size(), expected.size());
+    for (qsizetype i = 0; i < messages.size(); ++i) {
+        QCOMPARE(messages.at(i).text, expected.at(i));
+        QCOMPARE(messages.at(i).type, types.at(i));
+        QCOMPARE(messages.at(i).category, "default");
+        QCOMPARE(messages.at(i).file, __FILE__);
+        QCOMPARE(messages.at(i).function, Q_FUNC_INFO);
+        if (i > 0)
+            QVERIFY(messages.at(i).nsecsSinceStart >= messages.at(i - 1).nsecsSinceStart);
+    }
+    QCOMPARE(messages.last().line, line);
+}
+QT_WARNING_POP
+
 QString tst_qmessagehandler::backtraceHelperPath()
 {
 #ifdef Q_OS_ANDROID
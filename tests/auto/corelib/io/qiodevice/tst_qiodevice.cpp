@@ -28,8 +28,14 @@ private slots:
     void readLine2_data();
     void readLine2();
 
+    void readLineInto_data() { readLine2_data(); }
+    void readLineInto();
+
     void readAllKeepPosition();
     void writeInTextMode();
+    void writeVectored();
+    void writeVectoredFile_data();
+    void writeVectoredFile();
     void skip_data();
     void skip();
     void skipAfterPeek_data();
@@ -563,6 +569,37 @@ private:
 };
 
 // Test readAll() on position change for sequential device
+void tst_QIODevice::readLineInto()
+{
+    QFETCH(QByteArray, line);
+
+    QByteArray data = line + '\n' + "short\n" + "tail";
+    QBuffer buffer(&data);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    QByteArray result;
+    QVERIFY(buffer.readLineInto(&result));
+    QCOMPARE(result, line + '\n');
+    QCOMPARE(buffer.pos(), line.size() + 1);
+
+    // A shorter line must reuse the memory of the previous one
+    const char *storage = result.constData();
+    QVERIFY(buffer.readLineInto(&result));
+    QCOMPARE(result, QByteArray("short\n"));
+    QCOMPARE(result.constData(), storage);
+
+    QVERIFY(buffer.readLineInto(&result));
+    QCOMPARE(result, QByteArray("tail"));
+
+    QVERIFY(!buffer.readLineInto(&result));
+    QVERIFY(result.isEmpty());
+
+    // with a line length limit
+    QVERIFY(buffer.seek(0));
+    QVERIFY(buffer.readLineInto(&result, 4));
+    QCOMPARE(result, line.left(3));
+}
+
 void tst_QIODevice::readAllKeepPosition()
 {
     SequentialReadBuffer buffer("Hello world!");
@@ -623,6 +660,64 @@ void tst_QIODevice::writeInTextMode()
 #endif
 }
 
+void tst_QIODevice::writeVectored()
+{
+    QBuffer buffer;
+    QVERIFY(buffer.open(QBuffer::ReadWrite));
+    QCOMPARE(buffer.write({ "head", "", QByteArrayView("er|body") }), 11);
+    QCOMPARE(buffer.pos(), 11);
+
+    const QList<QByteArrayView> parts = { "|tail", "!" };
+    QCOMPARE(buffer.write(parts), 6);
+    QCOMPARE(buffer.data(), QByteArray("header|body|tail!"));
+
+    // Overwrite in the middle of a random-access device
+    QVERIFY(buffer.seek(7));
+    QCOMPARE(buffer.write({ "BO", "DY" }), 4);
+    QCOMPARE(buffer.data(), QByteArray("header|BODY|tail!"));
+    QCOMPARE(buffer.pos(), 11);
+
+    QBuffer readOnly;
+    QVERIFY(readOnly.open(QBuffer::ReadOnly));
+    QTest::ignoreMessage(QtWarningMsg, "QIODevice::write (QBuffer): ReadOnly device");
+    QCOMPARE(readOnly.write({ "a", "b" }), -1);
+}
+
+void tst_QIODevice::writeVectoredFile_data()
+{
+    QTest::addColumn<bool>("unbuffered");
+    QTest::addColumn<int>("pieceSize");
+
+    QTest::newRow("buffered-small") << false << 10;
+    QTest::newRow("buffered-large") << false << 20000;
+    QTest::newRow("unbuffered-small") << true << 10;
+    QTest::newRow("unbuffered-large") << true << 20000;
+}
+
+void tst_QIODevice::writeVectoredFile()
+{
+    QFETCH(bool, unbuffered);
+    QFETCH(int, pieceSize);
+
+    const QByteArray a(pieceSize, 'a');
+    const QByteArray b(pieceSize, 'b');
+    const QByteArray c(pieceSize, 'c');
+
+    QFile file(m_tempDir->path() + "/writeVectored.bin");
+    QIODevice::OpenMode mode = QIODevice::WriteOnly | QIODevice::Truncate;
+    if (unbuffered)
+        mode |= QIODevice::Unbuffered;
+    QVERIFY2(file.open(mode), qPrintable(file.errorString()));
+    QCOMPARE(file.write("x"), 1);
+    QCOMPARE(file.write({ a, b, c }), 3 * pieceSize);
+    QCOMPARE(file.pos(), 3 * pieceSize + 1);
+    QCOMPARE(file.write({ "y", "z" }), 2);
+    file.close();
+
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QCOMPARE(file.readAll(), 'x' + a + b + c + "yz");
+}
+
 void tst_QIODevice::skip_data()
 {
     QTest::addColumn<bool>("sequential");
@@ -7,6 +7,8 @@
 #include <QSignalSpy>
 
 #include <QtCore/QProcess>
+#include <QtCore/QProcessPipeline>
+#include <QtCore/QProcessPool>
 #include <QtCore/QDir>
 #include <QtCore/QElapsedTimer>
 #include <QtCore/QFile>
@@ -90,6 +92,10 @@ private slots:
     void setStandardOutputFileAndWaitForBytesWritten();
     void setStandardOutputProcess_data();
     void setStandardOutputProcess();
+    void pipeline();
+    void pipelineFanOut();
+    void pipelineCapture();
+    void processPool();
     void removeFileWhileProcessIsRunning();
     void fileWriterProcess();
     void switchReadChannels();
@@ -2057,6 +2063,162 @@ void tst_QProcess::setStandardOutputProcess()
         QCOMPARE(all, QByteArray("HHeelllloo,,  WWoorrlldd"));
 }
 
+void tst_QProcess::pipeline()
+{
+    QProcess source;
+    QProcess intermediate;
+    QProcess sink;
+    for (QProcess *process : { &source, &intermediate, &sink })
+        process->setProgram("testProcessEcho/testProcessEcho");
+
+    QProcessPipeline pipeline;
+    pipeline.appendStage(&source);
+    pipeline.appendStage(&intermediate);
+    pipeline.appendStage(&sink);
+    QCOMPARE(pipeline.stageCount(), 3);
+    QSignalSpy finishedSpy(&pipeline, &QProcessPipeline::finished);
+    QVERIFY(pipeline.start());
+    QVERIFY(pipeline.isRunning());
+
+    QByteArray data("Hello, World");
+    source.write(data);
+    source.closeWriteChannel();
+    QVERIFY(pipeline.waitForFinished());
+    QVERIFY(!pipeline.isRunning());
+    QCOMPARE(finishedSpy.size(), 1);
+    QCOMPARE(sink.exitStatus(), QProcess::NormalExit);
+    QCOMPARE(sink.readAll(), data);
+
+    // a running process can't be a stage
+    QTest::ignoreMessage(QtWarningMsg,
+                         "QProcessPipeline::start: A process of stage 0 is already running");
+    QProcess running;
+    running.start("testProcessEcho/testProcessEcho");
+    QVERIFY(running.waitForStarted());
+    QProcessPipeline invalid;
+    invalid.appendStage(&running);
+    QVERIFY(!invalid.start());
+    running.closeWriteChannel();
+    QVERIFY(running.waitForFinished());
+}
+
+void tst_QProcess::pipelineFanOut()
+{
+    QProcess source;
+    source.setProgram("testProcessEcho/testProcessEcho");
+    QProcess consumers[3];
+    QList<QProcess *> lastStage;
+    for (QProcess &consumer : consumers) {
+        consumer.setProgram("testProcessEcho/testProcessEcho");
+        lastStage.append(&consumer);
+    }
+
+    QProcessPipeline pipeline;
+    pipeline.appendStage(&source);
+    pipeline.appendStage(lastStage);
+    QVERIFY(pipeline.start());
+
+    // more than fits into the pipes, so that the forwarding has to wait for
+    // the consumers
+    QByteArray data;
+    for (int i = 0; i < 256 * 1024; ++i)
+        data.append(char('a' + i % 26));
+    source.write(data);
+    source.closeWriteChannel();
+
+    QByteArray received[3];
+    for (int i = 0; i < 3; ++i) {
+        connect(&consumers[i], &QProcess::readyReadStandardOutput, this, [&, i] {
+            received[i] += consumers[i].readAllStandardOutput();
+        });
+    }
+    QVERIFY(pipeline.waitForFinished());
+    for (int i = 0; i < 3; ++i) {
+        received[i] += consumers[i].readAllStandardOutput();
+        QCOMPARE(consumers[i].exitStatus(), QProcess::NormalExit);
+        QCOMPARE(received[i].size(), data.size());
+        QVERIFY(received[i] == data);
+    }
+}
+
+void tst_QProcess::pipelineCapture()
+{
+    QProcess source;
+    QProcess sink;
+    source.setProgram("testProcessEcho/testProcessEcho");
+    sink.setProgram("testProcessEcho/testProcessEcho");
+
+    QProcessPipeline pipeline;
+    pipeline.appendStage(&source);
+    pipeline.appendStage(&sink);
+    pipeline.setStageOutputCaptured(0, true);
+    QVERIFY(pipeline.isStageOutputCaptured(0));
+    QVERIFY(!pipeline.isStageOutputCaptured(1));
+    QByteArray captured;
+    connect(&pipeline, &QProcessPipeline::stageOutputReady, this, [&](qsizetype index) {
+        QCOMPARE(index, 0);
+        captured += pipeline.readStageOutput(index);
+    });
+    QVERIFY(pipeline.start());
+
+    QByteArray data("Hello, World");
+    source.write(data);
+    source.closeWriteChannel();
+    QVERIFY(pipeline.waitForFinished());
+    QCOMPARE(captured, data);
+    QCOMPARE(sink.readAll(), data);
+
+    // the stages can be run again
+    captured.clear();
+    QVERIFY(pipeline.start());
+    source.write("Again");
+    source.closeWriteChannel();
+    QVERIFY(pipeline.waitForFinished());
+    QCOMPARE(captured, QByteArray("Again"));
+    QCOMPARE(sink.readAll(), QByteArray("Again"));
+}
+
+void tst_QProcess::processPool()
+{
+    QProcessPool pool;
+    QCOMPARE(pool.spareCount(), 1);
+    QTest::ignoreMessage(QtWarningMsg, "QProcessPool::takeProcess: No program set");
+    QVERIFY(!pool.takeProcess());
+
+    pool.setProgram("testProcessEcho/testProcessEcho");
+    pool.setSpareCount(2);
+    QTRY_COMPARE(pool.availableCount(), 2);
+
+    std::unique_ptr<QProcess> process(pool.takeProcess());
+    QVERIFY(process);
+    QCOMPARE(process->parent(), nullptr);
+    QCOMPARE(pool.availableCount(), 1);
+    QVERIFY(process->waitForStarted());
+    process->write("Hello");
+    process->closeWriteChannel();
+    QVERIFY(process->waitForFinished());
+    QCOMPARE(process->readAll(), QByteArray("Hello"));
+    QTRY_COMPARE(pool.availableCount(), 2);
+
+    // a spare that exits is discarded
+    pool.clear();
+    QCOMPARE(pool.availableCount(), 0);
+    pool.setProgram("testExitCodes/testExitCodes");
+    pool.setArguments({ "0" });
+    QTest::qWait(100);
+    QTRY_COMPARE(pool.availableCount(), 0);
+
+    // without spares, each process is started on demand
+    pool.setProgram("testProcessEcho/testProcessEcho");
+    pool.setArguments({});
+    pool.setSpareCount(0);
+    process.reset(pool.takeProcess());
+    QVERIFY(process->waitForStarted());
+    process->closeWriteChannel();
+    QVERIFY(process->waitForFinished());
+    QCOMPARE(pool.availableCount(), 0);
+}
+
 void tst_QProcess::fileWriterProcess()
 {
     const QByteArray line = QByteArrayLiteral(" -- testing testing 1 2 3\n");
@@ -146,6 +146,10 @@ void tst_QResourceEngine::compressedResource()
     QCOMPARE(data.size(), expectedData.size());
     QCOMPARE(data, expectedData);
 
+    // decompressed data is cached
+    if (compressionAlgo != QResource::NoCompression)
+        QCOMPARE(QResource("zero.txt").uncompressedData().constData(), data.constData());
+
     // decompression through the engine
     data = f.readAll();
     QCOMPARE(data.size(), expectedData.size());
@@ -84,6 +84,7 @@ static void populateWithFormats()
 
     QTest::newRow("native") << QSettings::NativeFormat;
     QTest::newRow("ini") << QSettings::IniFormat;
+    QTest::newRow("binary") << QSettings::BinaryFormat;
     QTest::newRow("custom1") << QSettings::CustomFormat1;
     QTest::newRow("custom2") << QSettings::CustomFormat2;
 }
@@ -163,6 +164,7 @@ private slots:
     void testVariantTypes();
     void testMetaTypes_data();
     void testMetaTypes();
+    void binaryFormat();
 #endif
     void rainersSyncBugOnMac_data() { populateWithFormats(); }
     void rainersSyncBugOnMac();
@@ -1335,7 +1337,7 @@ void tst_QSettings::testVariantTypes()
     // We store key sequences as strings instead of binary variant blob, for improved
     // readability in the resulting format.
     QKeySequence seq(Qt::ControlModifier | Qt::Key_F1);
-    if (format >= QSettings::InvalidFormat)
+    if (format >= QSettings::InvalidFormat || format == QSettings::BinaryFormat)
         testValue("keySequence", seq, QKeySequence);
     else
         testValue("keySequence", seq.toString(QKeySequence::NativeText), QString);
@@ -3294,6 +3296,75 @@ void tst_QSettings::registerFormat()
     }
 }
 
+#ifdef QT_BUILD_INTERNAL
+void tst_QSettings::binaryFormat()
+{
+    const QString fileName = settingsPath("binary.qsettings");
+    {
+        QSettings settings(fileName, QSettings::BinaryFormat);
+        QCOMPARE(settings.format(), QSettings::BinaryFormat);
+        QVERIFY(settings.isWritable());
+        settings.setValue("topLevel", 42);
+        for (int i = 0; i < 100; ++i) {
+            settings.beginGroup(QString("group%1").arg(i));
+            settings.setValue("int", i);
+            settings.setValue("nested/string", QString("value %1").arg(i));
+            settings.endGroup();
+        }
+        settings.setValue("group7/list", QStringList{ "a", "b" });
+    }
+    QConfFile::clearCache();
+
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QByteArray original = file.readAll();
+    file.close();
+    QVERIFY(original.startsWith("QSB1"));
+
+    {
+        QSettings settings(fileName, QSettings::BinaryFormat);
+        QCOMPARE(settings.status(), QSettings::NoError);
+        // values keep their type
+        QCOMPARE(settings.value("topLevel"), QVariant(42));
+        QCOMPARE(settings.value("group7/int"), QVariant(7));
+        QCOMPARE(settings.value("group7/list"), QVariant(QStringList{ "a", "b" }));
+        QCOMPARE(settings.value("group99/nested/string"), QVariant("value 99"));
+        QCOMPARE(settings.childGroups().size(), 100);
+
+        // modify a single group, the other ones are written back unparsed
+        settings.setValue("group3/int", -3);
+        settings.remove("group4");
+        settings.sync();
+        QCOMPARE(settings.status(), QSettings::NoError);
+        QCOMPARE(settings.value("group3/int"), QVariant(-3));
+        QCOMPARE(settings.value("group50/int"), QVariant(50));
+    }
+    QConfFile::clearCache();
+
+    {
+        QSettings settings(fileName, QSettings::BinaryFormat);
+        QCOMPARE(settings.status(), QSettings::NoError);
+        QCOMPARE(settings.value("topLevel"), QVariant(42));
+        QCOMPARE(settings.value("group3/int"), QVariant(-3));
+        QVERIFY(!settings.contains("group4/int"));
+        QCOMPARE(settings.value("group5/nested/string"), QVariant("value 5"));
+        QCOMPARE(settings.childGroups().size(), 99);
+        QCOMPARE(settings.allKeys().size(), 1 + 99 * 2 + 1);
+    }
+    QConfFile::clearCache();
+
+    // a file in another format is a format error
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write("[General]\nfoo=bar\n");
+    file.close();
+    {
+        QSettings settings(fileName, QSettings::BinaryFormat);
+        QCOMPARE(settings.status(), QSettings::FormatError);
+        QVERIFY(!settings.contains("foo"));
+    }
+}
+#endif
+
 void tst_QSettings::setPath()
 {
 #define TEST_PATH(doSet, ext, format, scope, path) \
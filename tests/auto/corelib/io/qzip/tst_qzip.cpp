@@ -4,6 +4,8 @@
 #include <QTest>
 #include <QDebug>
 #include <QBuffer>
+#include <QTemporaryFile>
+#include <QThreadPool>
 
 #include <private/qzipwriter_p.h>
 #include <private/qzipreader_p.h>
@@ -17,6 +19,9 @@ private slots:
     void symlinks();
     void readTest();
     void createArchive();
+    void fileDevice_data();
+    void fileDevice();
+    void parallelCompression();
 };
 
 void tst_QZip::basicUnpack()
@@ -112,5 +117,116 @@ void tst_QZip::createArchive()
     QCOMPARE(zip2.fileData("My Filename"), fileContents);
 }
 
+static QByteArray compressibleData(int size)
+{
+    QByteArray data;
+    data.reserve(size);
+    for (int i = 0; data.size() < size; ++i)
+        data += "line " + QByteArray::number(i) + '\n';
+    data.truncate(size);
+    return data;
+}
+
+void tst_QZip::fileDevice_data()
+{
+    QTest::addColumn<QZipWriter::CompressionPolicy>("policy");
+    QTest::addColumn<int>("size");
+    QTest::addColumn<bool>("fromFile");
+
+    for (bool fromFile : { false, true }) {
+        const char *source = fromFile ? "file" : "buffer";
+        QTest::addRow("stored-small-%s", source) << QZipWriter::NeverCompress << 27 << fromFile;
+        QTest::addRow("stored-large-%s", source) << QZipWriter::NeverCompress << 200000 << fromFile;
+        QTest::addRow("deflated-small-%s", source) << QZipWriter::AlwaysCompress << 27 << fromFile;
+        QTest::addRow("deflated-large-%s", source) << QZipWriter::AlwaysCompress << 200000 << fromFile;
+        QTest::addRow("deflated-empty-%s", source) << QZipWriter::AlwaysCompress << 0 << fromFile;
+    }
+}
+
+void tst_QZip::fileDevice()
+{
+    QFETCH(QZipWriter::CompressionPolicy, policy);
+    QFETCH(int, size);
+    QFETCH(bool, fromFile);
+
+    const QByteArray contents = compressibleData(size);
+    QBuffer buffer;
+    {
+        QZipWriter zip(&buffer);
+        zip.setCompressionPolicy(policy);
+        zip.addFile("first", "something else");
+        zip.addFile("entry", contents);
+        zip.close();
+    }
+
+    QTemporaryFile file;
+    std::unique_ptr<QZipReader> reader;
+    if (fromFile) {
+        QVERIFY(file.open());
+        QCOMPARE(file.write(buffer.data()), buffer.data().size());
+        file.close();
+        reader = std::make_unique<QZipReader>(file.fileName());
+    } else {
+        buffer.open(QIODevice::ReadOnly);
+        reader = std::make_unique<QZipReader>(&buffer);
+    }
+
+    QVERIFY(!reader->fileDevice("missing"));
+    std::unique_ptr<QIODevice> entry = reader->fileDevice("entry");
+    QVERIFY(entry);
+    QVERIFY(entry->isSequential());
+    QVERIFY(entry->isReadable());
+    QCOMPARE(entry->bytesAvailable(), qint64(size));
+
+    // read in odd-sized pieces to exercise partial inflation
+    QByteArray result;
+    char chunk[1000];
+    qint64 readBytes;
+    while ((readBytes = entry->read(chunk, sizeof(chunk))) > 0)
+        result.append(chunk, readBytes);
+    QCOMPARE(result.size(), contents.size());
+    QCOMPARE(result, contents);
+    QVERIFY(entry->atEnd());
+    QCOMPARE(entry->bytesAvailable(), qint64(0));
+
+    QCOMPARE(reader->fileData("entry"), contents);
+    QCOMPARE(reader->fileDevice("first")->readAll(), QByteArray("something else"));
+}
+
+void tst_QZip::parallelCompression()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(3);
+
+    QList<QByteArray> contents;
+    for (int i = 0; i < 50; ++i)
+        contents.append(compressibleData(100 + i * 997));
+
+    QBuffer buffer;
+    {
+        QZipWriter zip(&buffer);
+        QCOMPARE(zip.threadPool(), nullptr);
+        zip.setThreadPool(&pool);
+        QCOMPARE(zip.threadPool(), &pool);
+        zip.addDirectory("dir");
+        for (int i = 0; i < contents.size(); ++i)
+            zip.addFile(QString("dir/file%1").arg(i), contents.at(i));
+        zip.close();
+        QCOMPARE(zip.status(), QZipWriter::NoError);
+    }
+
+    buffer.open(QIODevice::ReadOnly);
+    QZipReader reader(&buffer);
+    const QList<QZipReader::FileInfo> files = reader.fileInfoList();
+    QCOMPARE(files.size(), contents.size() + 1);
+    QVERIFY(files.at(0).isDir);
+    for (int i = 0; i < contents.size(); ++i) {
+        const QZipReader::FileInfo &info = files.at(i + 1);
+        QCOMPARE(info.filePath, QString("dir/file%1").arg(i));
+        QCOMPARE(info.size, contents.at(i).size());
+        QCOMPARE(reader.fileData(info.filePath), contents.at(i));
+    }
+}
+
 QTEST_MAIN(tst_QZip)
 #include "tst_qzip.moc"
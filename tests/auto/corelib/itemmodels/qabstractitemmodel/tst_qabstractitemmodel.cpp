@@ -97,6 +97,7 @@ private slots:
     void modelRoleDataSpan();
 
     void multiData();
+    void blockData();
 private:
     DynamicTreeModel *m_model;
 };
@@ -2504,5 +2505,75 @@ void tst_QAbstractItemModel::multiData()
     check();
 }
 
+// table model implementing data() only; check the layout of the span filled
+// by the default implementation of blockData()
+class NonBlockDataTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    int rowCount(const QModelIndex &parent) const override
+    {
+        return parent.isValid() ? 0 : 20;
+    }
+
+    int columnCount(const QModelIndex &parent) const override
+    {
+        return parent.isValid() ? 0 : 5;
+    }
+
+    QVariant data(const QModelIndex &index, int role) const override
+    {
+        Q_ASSERT(checkIndex(index, CheckIndexOption::IndexIsValid));
+
+        if (role == Qt::DisplayRole)
+            return QString::number(index.row()) + u',' + QString::number(index.column());
+        if (role == Qt::UserRole)
+            return index.row() * 10 + index.column();
+        return QVariant();
+    }
+};
+
+void tst_QAbstractItemModel::blockData()
+{
+    NonBlockDataTableModel model;
+    const QModelIndex topLeft = model.index(3, 1);
+    const QModelIndex bottomRight = model.index(7, 3);
+    const int rows = 5;
+    const int columns = 3;
+
+    const QList<int> roles = { Qt::UserRole, Qt::DisplayRole, Qt::DecorationRole };
+    std::vector<QModelRoleData> data;
+    for (int role : roles)
+        data.insert(data.end(), rows * columns, QModelRoleData(role));
+
+    const auto check = [&]() {
+        for (int role = 0; role < roles.size(); ++role) {
+            for (int row = 0; row < rows; ++row) {
+                for (int column = 0; column < columns; ++column) {
+                    const QModelIndex index = model.index(topLeft.row() + row,
+                                                          topLeft.column() + column);
+                    QCOMPARE(data[(role * rows + row) * columns + column].data(),
+                             index.data(roles.at(role)));
+                }
+            }
+        }
+    };
+
+    model.blockData(topLeft, bottomRight, data);
+    check();
+    QCOMPARE(data[0].data(), 31);
+    QCOMPARE(data[rows * columns].data(), QStringLiteral("3,1"));
+    QVERIFY(data[2 * rows * columns].data().isNull());
+
+    // with the data of the previous call
+    model.blockData(topLeft, bottomRight, data);
+    check();
+
+    QModelRoleData single[] = { QModelRoleData(Qt::UserRole) };
+    model.blockData(bottomRight, bottomRight, single);
+    QCOMPARE(single[0].data(), 73);
+}
+
 QTEST_MAIN(tst_QAbstractItemModel)
 #include "tst_qabstractitemmodel.moc"
@@ -53,6 +53,7 @@ private slots:
 
     void persistIndexOnLayoutChange();
     void createPersistentOnLayoutAboutToBeChanged();
+    void blockData();
 protected:
     void verifyIdentity(QAbstractItemModel *model, const QModelIndex &parent = QModelIndex());
 
@@ -513,5 +514,50 @@ void tst_QIdentityProxyModel::createPersistentOnLayoutAboutToBeChanged() // QTBU
     QCOMPARE(layoutChangedSpy.size(), 1);
 }
 
+// A subclass providing other data than the source model
+class UpperCaseIdentityProxyModel : public QIdentityProxyModel
+{
+    Q_OBJECT
+public:
+    QVariant data(const QModelIndex &index, int role) const override
+    {
+        const QVariant value = QIdentityProxyModel::data(index, role);
+        return role == Qt::DisplayRole ? QVariant(value.toString().toUpper()) : value;
+    }
+};
+
+void tst_QIdentityProxyModel::blockData()
+{
+    QStandardItemModel model(5, 3);
+    for (int row = 0; row < 5; ++row) {
+        for (int column = 0; column < 3; ++column) {
+            model.setData(model.index(row, column), QString("item %1 %2").arg(row).arg(column));
+            model.setData(model.index(row, column), row * 3 + column, Qt::UserRole);
+        }
+    }
+    QIdentityProxyModel proxy;
+    proxy.setSourceModel(&model);
+    UpperCaseIdentityProxyModel upperCaseProxy;
+    upperCaseProxy.setSourceModel(&model);
+
+    const QList<int> roles = { Qt::DisplayRole, Qt::UserRole, Qt::ToolTipRole };
+    for (QIdentityProxyModel *m : { &proxy, static_cast<QIdentityProxyModel *>(&upperCaseProxy) }) {
+        std::vector<QModelRoleData> data;
+        for (int role : roles)
+            data.insert(data.end(), 3 * 2, QModelRoleData(role));
+
+        m->blockData(m->index(1, 1), m->index(3, 2), data);
+        for (int role = 0; role < roles.size(); ++role) {
+            for (int row = 0; row < 3; ++row) {
+                for (int column = 0; column < 2; ++column) {
+                    QCOMPARE(data[(role * 3 + row) * 2 + column].data(),
+                             m->index(row + 1, column + 1).data(roles.at(role)));
+                }
+            }
+        }
+    }
+    QCOMPARE(upperCaseProxy.index(1, 1).data(), QStringLiteral("ITEM 1 1"));
+}
+
 QTEST_MAIN(tst_QIdentityProxyModel)
 #include "tst_qidentityproxymodel.moc"
@@ -12,6 +12,8 @@
 #include <QTableView>
 #include <QTreeView>
 #include <QTest>
+#include <QScopeGuard>
+#include <QThreadPool>
 #include <QStack>
 #include <QSignalSpy>
 #include <QAbstractItemModelTester>
@@ -5493,5 +5495,268 @@ void tst_QSortFilterProxyModel::createPersistentOnLayoutAboutToBeChanged() // QT
     QCOMPARE(layoutChangedSpy.size(), 1);
 }
 
+void tst_QSortFilterProxyModel::parallelSortFilter()
+{
+    // enough rows for the parallel mode to use several threads, with many
+    // equal ones to check that the sorting is stable
+    QStringList list;
+    for (int i = 0; i < 30000; ++i)
+        list << QString::number((i * 7919) % 3000);
+    QStringListModel model(list);
+
+    // use several threads even with a single core
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int maxThreadCount = pool->maxThreadCount();
+    pool->setMaxThreadCount(qMax(maxThreadCount, 4));
+    const auto restoreMaxThreadCount = qScopeGuard([&] {
+        pool->setMaxThreadCount(maxThreadCount);
+    });
+
+    QSortFilterProxyModel serial;
+    serial.setSourceModel(&model);
+    QSortFilterProxyModel parallel;
+    QVERIFY(!parallel.isParallelSortFilterEnabled());
+    parallel.setParallelSortFilterEnabled(true);
+    QVERIFY(parallel.isParallelSortFilterEnabled());
+    parallel.setSourceModel(&model);
+
+    const auto compareRows = [&] {
+        QCOMPARE(parallel.rowCount(), serial.rowCount());
+        for (int row = 0; row < serial.rowCount(); ++row) {
+            QCOMPARE(parallel.mapToSource(parallel.index(row, 0)).row(),
+                     serial.mapToSource(serial.index(row, 0)).row());
+        }
+    };
+
+    serial.sort(0);
+    parallel.sort(0);
+    compareRows();
+
+    serial.sort(0, Qt::DescendingOrder);
+    parallel.sort(0, Qt::DescendingOrder);
+    compareRows();
+
+    serial.setFilterRegularExpression("1.*2");
+    parallel.setFilterRegularExpression("1.*2");
+    QVERIFY(parallel.rowCount() < model.rowCount());
+    compareRows();
+
+    serial.setFilterRegularExpression("2");
+    parallel.setFilterRegularExpression("2");
+    compareRows();
+
+    serial.setFilterRegularExpression(QString());
+    parallel.setFilterRegularExpression(QString());
+    QCOMPARE(parallel.rowCount(), model.rowCount());
+    compareRows();
+
+    serial.setSortCaseSensitivity(Qt::CaseInsensitive);
+    parallel.setSortCaseSensitivity(Qt::CaseInsensitive);
+    serial.sort(-1);
+    parallel.sort(-1);
+    compareRows();
+}
+
+void tst_QSortFilterProxyModel::refineRowsFilter()
+{
+    QStringList list;
+    for (int i = 0; i < 1000; ++i)
+        list << QString::number((i * 7919) % 1000);
+    QStringListModel model(list);
+
+    QSortFilterProxyModel reference;
+    reference.setSourceModel(&model);
+    reference.sort(0);
+    struct Proxy : QSortFilterProxyModel
+    {
+        int maxValue = 1000;
+
+        bool filterAcceptsRow(int source_row, const QModelIndex &source_parent) const override
+        {
+            return sourceModel()->index(source_row, 0, source_parent).data().toInt() < maxValue
+                    && QSortFilterProxyModel::filterAcceptsRow(source_row, source_parent);
+        }
+
+        using QSortFilterProxyModel::refineRowsFilter;
+    } proxy;
+    proxy.setSourceModel(&model);
+    proxy.sort(0);
+
+    const auto compareRows = [&] {
+        QCOMPARE(proxy.rowCount(), reference.rowCount());
+        for (int row = 0; row < reference.rowCount(); ++row)
+            QCOMPARE(proxy.index(row, 0).data(), reference.index(row, 0).data());
+    };
+
+    QSignalSpy insertSpy(&proxy, &QAbstractItemModel::rowsInserted);
+    QSignalSpy removeSpy(&proxy, &QAbstractItemModel::rowsRemoved);
+
+    // A longer string only removes rows
+    QVERIFY(!proxy.isIncrementalFilteringEnabled());
+    proxy.setIncrementalFilteringEnabled(true);
+    QVERIFY(proxy.isIncrementalFilteringEnabled());
+    for (const QString &filter : QStringList{ "1", "12", "123" }) {
+        reference.setFilterFixedString(filter);
+        proxy.setFilterFixedString(filter);
+        compareRows();
+    }
+    QCOMPARE(insertSpy.size(), 0);
+    QVERIFY(removeSpy.size() > 0);
+
+    // A shorter string checks all rows again
+    reference.setFilterFixedString("2");
+    proxy.setFilterFixedString("2");
+    compareRows();
+    QVERIFY(insertSpy.size() > 0);
+
+    // A refinement only checks the rows that are shown
+    insertSpy.clear();
+    removeSpy.clear();
+    proxy.maxValue = 500;
+    proxy.refineRowsFilter();
+    QVERIFY(removeSpy.size() > 0);
+    QStringList expected;
+    for (int row = 0; row < reference.rowCount(); ++row) {
+        const QString value = reference.index(row, 0).data().toString();
+        if (value.toInt() < 500)
+            expected << value;
+    }
+    const int rowCount = proxy.rowCount();
+    QCOMPARE(rowCount, expected.size());
+    for (int row = 0; row < rowCount; ++row)
+        QCOMPARE(proxy.index(row, 0).data().toString(), expected.at(row));
+
+    // even if the filter accepts more rows now
+    proxy.maxValue = 1000;
+    proxy.refineRowsFilter();
+    QCOMPARE(proxy.rowCount(), rowCount);
+    QCOMPARE(insertSpy.size(), 0);
+    proxy.invalidate();
+    compareRows();
+}
+
+void tst_QSortFilterProxyModel::filterTimeSlice()
+{
+    QStringList list;
+    for (int i = 0; i < 20000; ++i)
+        list << QString::number((i * 7919) % 20000);
+    QStringListModel model(list);
+
+    QSortFilterProxyModel reference;
+    reference.setSourceModel(&model);
+    reference.sort(0);
+    QSortFilterProxyModel proxy;
+    QCOMPARE(proxy.filterTimeSlice(), 0);
+    proxy.setFilterTimeSlice(1);
+    QCOMPARE(proxy.filterTimeSlice(), 1);
+    proxy.setSourceModel(&model);
+    proxy.sort(0);
+
+    const auto compareRows = [&] {
+        QCOMPARE(proxy.rowCount(), reference.rowCount());
+        for (int row = 0; row < reference.rowCount(); ++row)
+            QCOMPARE(proxy.index(row, 0).data(), reference.index(row, 0).data());
+    };
+
+    // The rows are checked from the event loop
+    reference.setFilterFixedString("12");
+    proxy.setFilterFixedString("12");
+    QTRY_COMPARE(proxy.rowCount(), reference.rowCount());
+    compareRows();
+
+    reference.setFilterFixedString("3");
+    proxy.setFilterFixedString("3");
+    QTRY_COMPARE(proxy.rowCount(), reference.rowCount());
+    compareRows();
+
+    // A change of the source model checks the remaining rows first
+    reference.setFilterFixedString("45");
+    proxy.setFilterFixedString("45");
+    model.insertRows(0, 1);
+    model.setData(model.index(0, 0), "456");
+    compareRows();
+
+    // As does a new filter
+    reference.setFilterFixedString("7");
+    proxy.setFilterFixedString("8");
+    proxy.setFilterFixedString("7");
+    QTRY_COMPARE(proxy.rowCount(), reference.rowCount());
+    compareRows();
+
+    // Turning the time slices off checks the remaining rows at once
+    reference.setFilterFixedString("9");
+    proxy.setFilterFixedString("9");
+    proxy.setFilterTimeSlice(0);
+    compareRows();
+}
+
+void tst_QSortFilterProxyModel::blockData()
+{
+    QStandardItemModel model(100, 3);
+    for (int row = 0; row < 100; ++row) {
+        for (int column = 0; column < 3; ++column) {
+            model.setData(model.index(row, column), QString::number((row * 37 + column) % 100));
+            model.setData(model.index(row, column), row, Qt::UserRole);
+        }
+    }
+    QSortFilterProxyModel proxy;
+    proxy.setSourceModel(&model);
+
+    const QList<int> roles = { Qt::DisplayRole, Qt::UserRole, Qt::ToolTipRole };
+    const auto check = [&](int left, int right) {
+        const int rows = proxy.rowCount();
+        const int columns = right - left + 1;
+        std::vector<QModelRoleData> data;
+        for (int role : roles)
+            data.insert(data.end(), rows * columns, QModelRoleData(role));
+
+        proxy.blockData(proxy.index(0, left), proxy.index(rows - 1, right), data);
+        for (int role = 0; role < roles.size(); ++role) {
+            for (int row = 0; row < rows; ++row) {
+                for (int column = 0; column < columns; ++column) {
+                    QCOMPARE(data[(role * rows + row) * columns + column].data(),
+                             proxy.index(row, left + column).data(roles.at(role)));
+                }
+            }
+        }
+    };
+
+    check(0, 2);
+    proxy.sort(0);
+    check(0, 2);
+    proxy.setFilterRegularExpression("1");
+    check(0, 2);
+    proxy.sort(-1);
+    check(1, 2);
+
+    // columns that are not consecutive in the source model
+    struct ColumnFilterProxy : QSortFilterProxyModel
+    {
+        bool filterAcceptsColumn(int source_column, const QModelIndex &) const override
+        {
+            return source_column != 1;
+        }
+    } columnProxy;
+    columnProxy.setSourceModel(&model);
+    QCOMPARE(columnProxy.columnCount(), 2);
+    std::vector<QModelRoleData> data(2 * 10, QModelRoleData(Qt::DisplayRole));
+    columnProxy.blockData(columnProxy.index(0, 0), columnProxy.index(9, 1), data);
+    for (int row = 0; row < 10; ++row) {
+        QCOMPARE(data[row * 2].data(), model.index(row, 0).data());
+        QCOMPARE(data[row * 2 + 1].data(), model.index(row, 2).data());
+    }
+
+    // the parallel mode gets the data to sort by in blocks
+    QSortFilterProxyModel parallel;
+    parallel.setParallelSortFilterEnabled(true);
+    parallel.setSourceModel(&model);
+    parallel.setFilterRegularExpression("1");
+    parallel.sort(0, Qt::DescendingOrder);
+    proxy.sort(0, Qt::DescendingOrder);
+    QCOMPARE(parallel.rowCount(), proxy.rowCount());
+    for (int row = 0; row < proxy.rowCount(); ++row)
+        QCOMPARE(parallel.index(row, 0).data(Qt::UserRole), proxy.index(row, 0).data(Qt::UserRole));
+}
+
 QTEST_MAIN(tst_QSortFilterProxyModel)
 #include "tst_qsortfilterproxymodel.moc"
@@ -31,6 +31,10 @@ private slots:
     void sortHierarchy_data();
     void sortHierarchy();
     void createPersistentOnLayoutAboutToBeChanged();
+    void parallelSortFilter();
+    void refineRowsFilter();
+    void filterTimeSlice();
+    void blockData();
 
     void insertRows_data();
     void insertRows();
@@ -69,6 +69,7 @@ private slots:
     void itemData();
     void setItemData();
     void createPersistentOnLayoutAboutToBeChanged();
+    void blockData();
 };
 
 void tst_QStringListModel::moveRowsInvalid_data()
@@ -452,5 +453,44 @@ void tst_QStringListModel::createPersistentOnLayoutAboutToBeChanged() // QTBUG-9
     QCOMPARE(layoutChangedSpy.size(), 1);
 }
 
+// A subclass providing other data than the strings
+class UpperCaseStringListModel : public QStringListModel
+{
+    Q_OBJECT
+public:
+    using QStringListModel::QStringListModel;
+
+    QVariant data(const QModelIndex &index, int role) const override
+    {
+        return QStringListModel::data(index, role).toString().toUpper();
+    }
+};
+
+void tst_QStringListModel::blockData()
+{
+    const QStringList strings = { "a", "b", "c", "d", "e" };
+    QStringListModel model(strings);
+    UpperCaseStringListModel upperCaseModel(strings);
+
+    for (QStringListModel *m : { &model, static_cast<QStringListModel *>(&upperCaseModel) }) {
+        std::vector<QModelRoleData> data;
+        data.insert(data.end(), 3, QModelRoleData(Qt::DisplayRole));
+        data.insert(data.end(), 3, QModelRoleData(Qt::DecorationRole));
+        data.insert(data.end(), 3, QModelRoleData(Qt::EditRole));
+        // the span may contain the data of a previous call
+        data[4].setData(QStringLiteral("old"));
+
+        m->blockData(m->index(1, 0), m->index(3, 0), data);
+        for (int role = 0; role < 3; ++role) {
+            for (int row = 0; row < 3; ++row) {
+                const QModelRoleData &roleData = data[role * 3 + row];
+                QCOMPARE(roleData.data(), m->index(row + 1, 0).data(roleData.role()));
+            }
+        }
+    }
+    QCOMPARE(model.index(1, 0).data(), QStringLiteral("b"));
+    QCOMPARE(upperCaseModel.index(1, 0).data(), QStringLiteral("B"));
+}
+
 QTEST_MAIN(tst_QStringListModel)
 #include "tst_qstringlistmodel.moc"
@@ -331,6 +331,8 @@ private slots:
     void firstMethod();
 
     void indexOfMethodPMF();
+    void indexOfByName_data();
+    void indexOfByName();
 
     void signalOffset_data();
     void signalOffset();
@@ -2558,6 +2560,54 @@ void tst_QMetaObject::indexOfMethodPMF()
     INDEXOFMETHODPMF_HELPER(QtTestCustomObject, sig_custom, (const CustomString &))
 }
 
+void tst_QMetaObject::indexOfByName_data()
+{
+    QTest::addColumn<const QMetaObject *>("metaObject");
+    QTest::newRow("QObject") << &QObject::staticMetaObject;
+    QTest::newRow("Derived") << &Derived::staticMetaObject;
+    QTest::newRow("QtTestObject") << &QtTestObject::staticMetaObject;
+    QTest::newRow("QSortFilterProxyModel") << &QSortFilterProxyModel::staticMetaObject;
+    QTest::newRow("tst_QMetaObject") << &tst_QMetaObject::staticMetaObject;
+}
+
+// Checks the lookups by name, which use the hash tables generated by moc,
+// against linear searches with the public API
+void tst_QMetaObject::indexOfByName()
+{
+    QFETCH(const QMetaObject *, metaObject);
+
+    for (int i = 0; i < metaObject->methodCount(); ++i) {
+        const QMetaMethod method = metaObject->method(i);
+        const QByteArray signature = method.methodSignature();
+        int expected = metaObject->methodCount() - 1;
+        while (metaObject->method(expected).methodSignature() != signature)
+            --expected;
+        QCOMPARE(metaObject->indexOfMethod(signature), expected);
+        QCOMPARE(metaObject->indexOfSignal(signature),
+                 method.methodType() == QMetaMethod::Signal ? expected : -1);
+        // indexOfSlot() also finds the invokable methods
+        QCOMPARE(metaObject->indexOfSlot(signature),
+                 method.methodType() != QMetaMethod::Signal ? expected : -1);
+        QCOMPARE(QMetaObjectPrivate::firstMethod(metaObject, method.name()).name(), method.name());
+    }
+    QCOMPARE(metaObject->indexOfMethod("noSuchMethod()"), -1);
+    QCOMPARE(metaObject->indexOfSignal("noSuchSignal(int)"), -1);
+    QVERIFY(!QMetaObjectPrivate::firstMethod(metaObject, "noSuchMethod").isValid());
+
+    for (int i = 0; i < metaObject->propertyCount(); ++i) {
+        const QByteArray name = metaObject->property(i).name();
+        int expected = -1;
+        for (const QMetaObject *m = metaObject; m && expected < 0; m = m->superClass()) {
+            for (int j = m->propertyOffset(); j < m->propertyCount() && expected < 0; ++j) {
+                if (name == m->property(j).name())
+                    expected = j;
+            }
+        }
+        QCOMPARE(metaObject->indexOfProperty(name), expected);
+    }
+    QCOMPARE(metaObject->indexOfProperty("noSuchProperty"), -1);
+}
+
 namespace SignalTestHelper
 {
 // These functions use the public QMetaObject/QMetaMethod API to implement
@@ -0,0 +1,14 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "../tst_qmimedatabase.h"
+#include <QFile>
+
+#include "../tst_qmimedatabase.cpp"
+
+void tst_QMimeDatabase::initTestCaseInternal()
+{
+    // Without a freedesktop.org.xml in the data directories, the internal
+    // database is used, through the cache that was generated at build time
+    qputenv("XDG_DATA_DIRS", QFile::encodeName(m_temporaryDir.path()));
+}
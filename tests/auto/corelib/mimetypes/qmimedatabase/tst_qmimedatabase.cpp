@@ -654,6 +654,40 @@ void tst_QMimeDatabase::mimeTypeForFileNameAndData()
     QCOMPARE(buffer.pos(), qint64(0));
 }
 
+void tst_QMimeDatabase::mimeTypesForFiles_data()
+{
+    QTest::addColumn<QMimeDatabase::MatchMode>("mode");
+
+    QTest::newRow("default") << QMimeDatabase::MatchDefault;
+    QTest::newRow("extension") << QMimeDatabase::MatchExtension;
+    QTest::newRow("content") << QMimeDatabase::MatchContent;
+}
+
+void tst_QMimeDatabase::mimeTypesForFiles()
+{
+    QFETCH(QMimeDatabase::MatchMode, mode);
+
+    const QString directory = QFileInfo(QFINDTESTDATA("test.txt")).absolutePath();
+    QVERIFY(!directory.isEmpty());
+    QStringList fileNames;
+    const QStringList entries = QDir(directory).entryList(QDir::Files);
+    for (const QString &entry : entries)
+        fileNames.append(directory + QLatin1Char('/') + entry);
+    fileNames.append(directory);
+    fileNames.append(directory + QLatin1String("/doesnotexist.txt"));
+    fileNames.append(directory + QLatin1String("/doesnotexist"));
+
+    QMimeDatabase db;
+    const QList<QMimeType> mimeTypes = db.mimeTypesForFiles(fileNames, mode);
+    QCOMPARE(mimeTypes.size(), fileNames.size());
+    for (qsizetype i = 0; i < fileNames.size(); ++i) {
+        QVERIFY2(mimeTypes.at(i).isValid(), qPrintable(fileNames.at(i)));
+        QCOMPARE(mimeTypes.at(i).name(), db.mimeTypeForFile(fileNames.at(i), mode).name());
+    }
+
+    QVERIFY(db.mimeTypesForFiles(QStringList(), mode).isEmpty());
+}
+
 #ifdef Q_OS_UNIX
 void tst_QMimeDatabase::mimeTypeForUnixSpecials_data()
 {
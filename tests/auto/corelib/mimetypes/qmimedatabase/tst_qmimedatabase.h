@@ -38,6 +38,8 @@ private slots:
     void mimeTypeForData();
     void mimeTypeForFileNameAndData_data();
     void mimeTypeForFileNameAndData();
+    void mimeTypesForFiles_data();
+    void mimeTypesForFiles();
 #ifdef Q_OS_UNIX
     void mimeTypeForUnixSpecials_data();
     void mimeTypeForUnixSpecials();
@@ -5,7 +5,11 @@
 #include <QtCore/qdir.h>
 #include <QtCore/qfileinfo.h>
 #include <QtCore/qplugin.h>
+#include <QtCore/qtemporarydir.h>
 #include <private/qfactoryloader_p.h>
+#if QT_CONFIG(library)
+#include <private/qpluginmetadatacache_p.h>
+#endif
 #include "plugin1/plugininterface1.h"
 #include "plugin2/plugininterface2.h"
 
@@ -23,12 +27,15 @@ class tst_QFactoryLoader : public QObject
 #endif
 
     QString binFolder;
+    QTemporaryDir cacheDir;
 public slots:
     void initTestCase();
 
 private slots:
     void usingTwoFactoriesFromSameDir();
     void extraSearchPath();
+    void metaDataCache();
+    void metaDataCacheFile();
 };
 
 static const char binFolderC[] = "bin";
@@ -40,6 +47,10 @@ void tst_QFactoryLoader::initTestCase()
     binFolder = QFINDTESTDATA(binFolderC);
     QVERIFY2(!binFolder.isEmpty(), "Unable to locate 'bin' folder");
 #endif
+
+    // Read before any plugin is looked at
+    QVERIFY(cacheDir.isValid());
+    qputenv("QT_PLUGIN_METADATA_CACHE", QFile::encodeName(cacheDir.filePath("plugins.cache")));
 }
 
 void tst_QFactoryLoader::usingTwoFactoriesFromSameDir()
@@ -109,5 +120,64 @@ void tst_QFactoryLoader::extraSearchPath()
 #endif
 }
 
+void tst_QFactoryLoader::metaDataCache()
+{
+#if !QT_CONFIG(library) || defined(Q_OS_ANDROID)
+    QSKIP("Test not applicable in this configuration.");
+#else
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QFileInfoList plugins = QDir(binFolder).entryInfoList(QDir::Files);
+    QVERIFY(!plugins.isEmpty());
+    const QString plugin = dir.filePath("plugin");
+    QVERIFY(QFile::copy(plugins.first().absoluteFilePath(), plugin));
+    const QString cacheFile = dir.filePath("cache/plugins.cache");
+    const QByteArray metaData(sizeof(QPluginMetaData::Header) + 1, 'x');
+
+    {
+        QPluginMetaDataCache cache(cacheFile);
+        QVERIFY(cache.metaData(plugin).isNull());
+        cache.insert(plugin, metaData);
+        QCOMPARE(cache.metaData(plugin), metaData);
+        QVERIFY(cache.save());
+    }
+    QVERIFY(QFile::exists(cacheFile));
+    {
+        QPluginMetaDataCache cache(cacheFile);
+        QCOMPARE(cache.metaData(plugin), metaData);
+    }
+
+    // a changed file is not found
+    {
+        QFile file(plugin);
+        QVERIFY(file.open(QIODevice::Append));
+        QCOMPARE(file.write("x"), 1);
+    }
+    {
+        QPluginMetaDataCache cache(cacheFile);
+        QVERIFY(cache.metaData(plugin).isNull());
+    }
+#endif
+}
+
+void tst_QFactoryLoader::metaDataCacheFile()
+{
+#if !QT_CONFIG(library) || defined(Q_OS_ANDROID)
+    QSKIP("Test not applicable in this configuration.");
+#else
+    // The plugins that were scanned by the previous tests were stored in the
+    // cache set in initTestCase()
+    QPluginMetaDataCache *instance = QPluginMetaDataCache::instance();
+    QVERIFY(instance);
+    QCOMPARE(instance->fileName(), cacheDir.filePath("plugins.cache"));
+
+    QPluginMetaDataCache cache(instance->fileName());
+    const QFileInfoList plugins = QDir(binFolder).entryInfoList(QDir::Files);
+    QVERIFY(!plugins.isEmpty());
+    for (const QFileInfo &plugin : plugins)
+        QVERIFY2(!cache.metaData(plugin.canonicalFilePath()).isNull(), qPrintable(plugin.filePath()));
+#endif
+}
+
 QTEST_MAIN(tst_QFactoryLoader)
 #include "tst_qfactoryloader.moc"
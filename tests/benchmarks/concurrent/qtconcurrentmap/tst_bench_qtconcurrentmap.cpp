@@ -0,0 +1,87 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+
+#include <qthreadpool.h>
+#include <qtconcurrentmap.h>
+
+#include <numeric>
+
+class tst_QtConcurrentMap : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void sumOfSquares_data();
+    void sumOfSquares();
+};
+
+enum class SumMode { Sequential, MappedReduced, ChunkedMappedReduced };
+
+static qint64 square(int value)
+{
+    return qint64(value) * value;
+}
+
+static void add(qint64 &result, qint64 intermediate)
+{
+    result += intermediate;
+}
+
+static qint64 sumOfSquaresOfChunk(QList<int>::const_iterator begin,
+                                  QList<int>::const_iterator end)
+{
+    qint64 sum = 0;
+    for (auto it = begin; it != end; ++it)
+        sum += square(*it);
+    return sum;
+}
+
+void tst_QtConcurrentMap::sumOfSquares_data()
+{
+    QTest::addColumn<SumMode>("mode");
+    QTest::addColumn<int>("threadCount");
+
+    QTest::newRow("sequential") << SumMode::Sequential << 1;
+    for (int threadCount : { 1, 2, 4, 8 }) {
+        QTest::addRow("mappedReduced-%d", threadCount) << SumMode::MappedReduced << threadCount;
+        QTest::addRow("chunkedMappedReduced-%d", threadCount)
+                << SumMode::ChunkedMappedReduced << threadCount;
+    }
+}
+
+void tst_QtConcurrentMap::sumOfSquares()
+{
+    QFETCH(SumMode, mode);
+    QFETCH(int, threadCount);
+
+    constexpr int ItemCount = 1000000;
+    QList<int> values(ItemCount);
+    std::iota(values.begin(), values.end(), -ItemCount / 2);
+    const qint64 expected = sumOfSquaresOfChunk(values.cbegin(), values.cend());
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threadCount);
+
+    qint64 sum = 0;
+    QBENCHMARK {
+        switch (mode) {
+        case SumMode::Sequential:
+            sum = sumOfSquaresOfChunk(values.cbegin(), values.cend());
+            break;
+        case SumMode::MappedReduced:
+            sum = QtConcurrent::blockingMappedReduced<qint64>(&pool, values, square, add);
+            break;
+        case SumMode::ChunkedMappedReduced:
+            sum = QtConcurrent::blockingChunkedMappedReduced(&pool, values, sumOfSquaresOfChunk,
+                                                             add);
+            break;
+        }
+    }
+    QCOMPARE(sum, expected);
+}
+
+QTEST_MAIN(tst_QtConcurrentMap)
+
+#include "tst_bench_qtconcurrentmap.moc"
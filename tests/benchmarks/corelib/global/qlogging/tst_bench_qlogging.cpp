@@ -0,0 +1,138 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+#include <QTemporaryDir>
+#include <QTemporaryFile>
+#include <QThread>
+#include <QLoggingCategory>
+
+#include <private/qlogging_p.h>
+
+#include <memory>
+#include <vector>
+
+#ifdef Q_OS_UNIX
+#  include <unistd.h>
+#endif
+
+Q_LOGGING_CATEGORY(lcBench, "bench.logging")
+
+class tst_QLogging : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void threads_data();
+    void threads();
+    void binary_data();
+    void binary();
+
+private:
+    QTemporaryFile output;
+    int savedStderr = -1;
+};
+
+// Messages logged per iteration, split over the threads
+static constexpr int MessageCount = 32 * 1024;
+
+void tst_QLogging::initTestCase()
+{
+#ifdef Q_OS_UNIX
+    // write the messages to a file instead of the terminal
+    QVERIFY(output.open());
+    fflush(stderr);
+    savedStderr = dup(STDERR_FILENO);
+    QVERIFY(savedStderr != -1);
+    QVERIFY(dup2(output.handle(), STDERR_FILENO) != -1);
+#else
+    QSKIP("Redirecting stderr is only implemented for Unix");
+#endif
+    qputenv("QT_FORCE_STDERR_LOGGING", "1");
+}
+
+void tst_QLogging::cleanupTestCase()
+{
+#ifdef Q_OS_UNIX
+    if (savedStderr != -1) {
+        fflush(stderr);
+        dup2(savedStderr, STDERR_FILENO);
+        close(savedStderr);
+    }
+#endif
+}
+
+void tst_QLogging::threads_data()
+{
+    QTest::addColumn<bool>("async");
+    QTest::addColumn<int>("threadCount");
+
+    for (int threadCount : {1, 2, 4, 8, 16, 32}) {
+        QTest::addRow("sync-%d", threadCount) << false << threadCount;
+        QTest::addRow("async-%d", threadCount) << true << threadCount;
+    }
+}
+
+void tst_QLogging::threads()
+{
+    QFETCH(bool, async);
+    QFETCH(int, threadCount);
+
+    // QTest installs its own message handler; measure the default one
+    const QtMessageHandler testHandler = qInstallMessageHandler(nullptr);
+    QtPrivate::setAsyncMessageOutput(async);
+
+    const int messagesPerThread = MessageCount / threadCount;
+    QBENCHMARK {
+        std::vector<std::unique_ptr<QThread>> threads;
+        for (int i = 0; i < threadCount; ++i) {
+            threads.emplace_back(QThread::create([messagesPerThread] {
+                for (int j = 0; j < messagesPerThread; ++j)
+                    qCDebug(lcBench, "message %d from a thread", j);
+            }));
+        }
+        for (const auto &thread : threads)
+            thread->start();
+        for (const auto &thread : threads)
+            thread->wait();
+    }
+
+    // don't let the writing of the last messages leak into the next row
+    QtPrivate::setAsyncMessageOutput(false);
+    qInstallMessageHandler(testHandler);
+}
+
+void tst_QLogging::binary_data()
+{
+    QTest::addColumn<bool>("binary");
+
+    QTest::newRow("text") << false;
+    QTest::newRow("binary") << true;
+}
+
+void tst_QLogging::binary()
+{
+    QFETCH(bool, binary);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QtMessageHandler testHandler = qInstallMessageHandler(nullptr);
+    if (binary)
+        QVERIFY(QtPrivate::setBinaryMessageOutput(dir.filePath("bench.qtbinlog")));
+
+    const double ratio = 0.75;
+    const char *name = "bench";
+    QBENCHMARK {
+        for (int i = 0; i < MessageCount; ++i)
+            qCInfo(lcBench, "%s: message %d at %p, ratio %.2f", name, i, &ratio, ratio);
+    }
+
+    QtPrivate::setBinaryMessageOutput(QString());
+    qInstallMessageHandler(testHandler);
+}
+
+QTEST_MAIN(tst_QLogging)
+
+#include "tst_bench_qlogging.moc"
@@ -15,10 +15,15 @@ private slots:
     void read_old_data() { read_data(); }
     void peekAndRead();
     void peekAndRead_data() { read_data(); }
+    void readLine_data() { lines_data(); }
+    void readLine();
+    void readLineInto_data() { lines_data(); }
+    void readLineInto();
     //void read_new();
     //void read_new_data() { read_data(); }
 private:
     void read_data();
+    void lines_data();
 };
 
 
@@ -93,6 +98,60 @@ void tst_QIODevice::peekAndRead()
     }
 }
 
+void tst_QIODevice::lines_data()
+{
+    QTest::addColumn<int>("lineLength");
+    QTest::newRow("16") << 16;
+    QTest::newRow("80") << 80;
+    QTest::newRow("1000") << 1000;
+}
+
+static QString createLinesFile(int lineLength)
+{
+    const QString name = "lines" + QString::number(lineLength);
+    QFile file(name);
+    file.open(QIODevice::WriteOnly);
+    const QByteArray line = QByteArray(lineLength - 1, 'x') + '\n';
+    for (int written = 0; written < 10 * 1024 * 1024; written += lineLength)
+        file.write(line);
+    return name;
+}
+
+void tst_QIODevice::readLine()
+{
+    QFETCH(int, lineLength);
+    const QString name = createLinesFile(lineLength);
+
+    QBENCHMARK {
+        QFile file(name);
+        file.open(QIODevice::ReadOnly);
+        qint64 total = 0;
+        while (!file.atEnd())
+            total += file.readLine().size();
+        QVERIFY(total > 0);
+    }
+
+    QFile::remove(name);
+}
+
+void tst_QIODevice::readLineInto()
+{
+    QFETCH(int, lineLength);
+    const QString name = createLinesFile(lineLength);
+
+    QBENCHMARK {
+        QFile file(name);
+        file.open(QIODevice::ReadOnly);
+        qint64 total = 0;
+        QByteArray line;
+        while (file.readLineInto(&line))
+            total += line.size();
+        QVERIFY(total > 0);
+    }
+
+    QFile::remove(name);
+}
+
 QTEST_MAIN(tst_QIODevice)
 
 #include "tst_bench_qiodevice.moc"
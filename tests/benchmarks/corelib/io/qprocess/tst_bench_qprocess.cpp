@@ -4,7 +4,13 @@
 #include <QTest>
 #include <QSignalSpy>
 #include <QtCore/QProcess>
+#include <QtCore/QProcessPipeline>
+#include <QtCore/QProcessPool>
 #include <QtCore/QElapsedTimer>
+#include <QtCore/QEventLoop>
+#include <QtCore/QStandardPaths>
+
+#include <memory>
 
 class tst_QProcess : public QObject
 {
@@ -13,6 +19,12 @@ class tst_QProcess : public QObject
 private slots:
 
     void echoTest_performance();
+    void startLatency_data();
+    void startLatency();
+    void fanOut_data();
+    void fanOut();
+    void takeProcess_data();
+    void takeProcess();
 };
 
 #ifdef Q_OS_WIN
@@ -66,5 +78,175 @@ void tst_QProcess::echoTest_performance()
     QVERIFY(process.waitForFinished());
 }
 
+void tst_QProcess::startLatency_data()
+{
+    QTest::addColumn<int>("residentMB");
+    QTest::addColumn<bool>("modifier");
+
+    // starting a child can take longer the more memory the parent has mapped
+    for (int residentMB : {0, 256, 1024}) {
+        QTest::addRow("%dMB", residentMB) << residentMB << false;
+#ifdef Q_OS_UNIX
+        // a child process modifier needs the child to run our code before exec
+        QTest::addRow("%dMB-modifier", residentMB) << residentMB << true;
+#endif
+    }
+}
+
+void tst_QProcess::startLatency()
+{
+    QFETCH(int, residentMB);
+    QFETCH(bool, modifier);
+
+    const QString program = QFINDTESTDATA("../testProcessLoopback/testProcessLoopback" EXE);
+    QVERIFY(!program.isEmpty());
+
+    // touch every page so that it is resident and has to be mapped in a fork
+    const size_t size = size_t(residentMB) * 1024 * 1024;
+    std::unique_ptr<char[]> memory(new char[size]);
+    for (size_t i = 0; i < size; i += 4096)
+        memory[i] = char(i);
+
+    QProcess process;
+    process.setProgram(program);
+#ifdef Q_OS_UNIX
+    if (modifier)
+        process.setChildProcessModifier([] {});
+#else
+    Q_UNUSED(modifier);
+#endif
+
+    QBENCHMARK {
+        process.start();
+        QVERIFY(process.waitForStarted());
+        process.closeWriteChannel();
+        QVERIFY(process.waitForFinished());
+    }
+}
+
+void tst_QProcess::fanOut_data()
+{
+    QTest::addColumn<bool>("pipeline");
+    QTest::addColumn<int>("consumers");
+
+    for (int consumers : {1, 3}) {
+        // reading the output and writing it to each consumer
+        QTest::addRow("copy-%d", consumers) << false << consumers;
+        QTest::addRow("pipeline-%d", consumers) << true << consumers;
+    }
+}
+
+void tst_QProcess::fanOut()
+{
+    QFETCH(bool, pipeline);
+    QFETCH(int, consumers);
+
+    const QString program = QFINDTESTDATA("../testProcessLoopback/testProcessLoopback" EXE);
+    QVERIFY(!program.isEmpty());
+
+    QByteArray data(16 * 1024 * 1024, Qt::Uninitialized);
+    for (qsizetype i = 0; i < data.size(); ++i)
+        data[i] = char('a' + i % 26);
+
+    QBENCHMARK {
+        QProcess source;
+        source.setProgram(program);
+        std::vector<std::unique_ptr<QProcess>> sinks;
+        QList<QProcess *> lastStage;
+        qint64 received = 0;
+        for (int i = 0; i < consumers; ++i) {
+            sinks.emplace_back(new QProcess);
+            QProcess *sink = sinks.back().get();
+            sink->setProgram(program);
+            connect(sink, &QProcess::readyReadStandardOutput, sink, [sink, &received] {
+                received += sink->readAllStandardOutput().size();
+            });
+            lastStage.append(sink);
+        }
+
+        QEventLoop loop;
+        int running = consumers;
+        for (QProcess *sink : std::as_const(lastStage)) {
+            connect(sink, &QProcess::finished, &loop, [&] {
+                if (--running == 0)
+                    loop.quit();
+            });
+        }
+
+        QProcessPipeline processPipeline;
+        if (pipeline) {
+            processPipeline.appendStage(&source);
+            processPipeline.appendStage(lastStage);
+            QVERIFY(processPipeline.start());
+        } else {
+            connect(&source, &QProcess::readyReadStandardOutput, &source, [&] {
+                const QByteArray output = source.readAllStandardOutput();
+                for (QProcess *sink : std::as_const(lastStage))
+                    sink->write(output);
+            });
+            connect(&source, &QProcess::finished, &source, [&] {
+                for (QProcess *sink : std::as_const(lastStage))
+                    sink->closeWriteChannel();
+            });
+            source.start();
+            for (QProcess *sink : std::as_const(lastStage))
+                sink->start();
+        }
+
+        source.write(data);
+        source.closeWriteChannel();
+        loop.exec();
+        QCOMPARE(received, data.size() * consumers);
+    }
+}
+
+void tst_QProcess::takeProcess_data()
+{
+    QTest::addColumn<bool>("pool");
+
+    QTest::newRow("start") << false;
+    QTest::newRow("pool") << true;
+}
+
+void tst_QProcess::takeProcess()
+{
+    QFETCH(bool, pool);
+
+    const QString program = QFINDTESTDATA("../testProcessLoopback/testProcessLoopback" EXE);
+    QVERIFY(!program.isEmpty());
+
+    QProcessPool processPool;
+    processPool.setProgram(program);
+
+    // The time until a process answers; the pool starts the replacements in
+    // between, which isn't measured, like in an application that is idle at
+    // that time.
+    const QByteArray request(1024, 'a');
+    const int iterations = 50;
+    qint64 total = 0;
+    for (int i = 0; i < iterations; ++i) {
+        QTRY_COMPARE(processPool.availableCount(), processPool.spareCount());
+        QTest::qWait(10);
+
+        QElapsedTimer timer;
+        timer.start();
+        std::unique_ptr<QProcess> process;
+        if (pool) {
+            process.reset(processPool.takeProcess());
+        } else {
+            process.reset(new QProcess);
+            process->start(program);
+        }
+        process->write(request);
+        while (process->bytesAvailable() < request.size())
+            QVERIFY(process->waitForReadyRead());
+        total += timer.nsecsElapsed();
+
+        process->closeWriteChannel();
+        QVERIFY(process->waitForFinished());
+    }
+    QTest::setBenchmarkResult(qreal(total) / iterations, QTest::WalltimeNanoseconds);
+}
+
 QTEST_MAIN(tst_QProcess)
 #include "tst_bench_qprocess.moc"
@@ -0,0 +1,114 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+#include <QFile>
+#include <QSettings>
+#include <QTemporaryDir>
+#include <qtest.h>
+
+class tst_QSettings : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void open_data();
+    void open();
+    void readAll_data() { open_data(); }
+    void readAll();
+    void syncOneKey_data() { open_data(); }
+    void syncOneKey();
+
+private:
+    QString createSettings(QSettings::Format format, int keyCount);
+    // QSettings caches the files it has read, so every open uses a new name
+    QString rename(const QString &fileName);
+
+    QTemporaryDir dir;
+    int renameCount = 0;
+};
+
+void tst_QSettings::initTestCase()
+{
+    QVERIFY(dir.isValid());
+}
+
+QString tst_QSettings::createSettings(QSettings::Format format, int keyCount)
+{
+    const QString fileName = dir.filePath(QString("settings_%1_%2")
+                                          .arg(int(format)).arg(keyCount));
+    QSettings settings(fileName, format);
+    // 100 keys per group, as written by a typical application
+    for (int i = 0; i < keyCount; ++i) {
+        settings.setValue(QString("group%1/key%2").arg(i / 100).arg(i % 100),
+                          QString("some value %1").arg(i));
+    }
+    return fileName;
+}
+
+QString tst_QSettings::rename(const QString &fileName)
+{
+    const QString newName = dir.filePath(QString::number(++renameCount));
+    QFile::rename(fileName, newName);
+    return newName;
+}
+
+void tst_QSettings::open_data()
+{
+    QTest::addColumn<QSettings::Format>("format");
+    QTest::addColumn<int>("keyCount");
+
+    for (int keyCount : { 1000, 20000 }) {
+        QTest::addRow("ini-%d", keyCount) << QSettings::IniFormat << keyCount;
+        QTest::addRow("binary-%d", keyCount) << QSettings::BinaryFormat << keyCount;
+    }
+}
+
+// startup: open the settings and look up a single key
+void tst_QSettings::open()
+{
+    QFETCH(QSettings::Format, format);
+    QFETCH(int, keyCount);
+    QString fileName = createSettings(format, keyCount);
+
+    QBENCHMARK {
+        fileName = rename(fileName);
+        QSettings settings(fileName, format);
+        QVERIFY(settings.contains("group1/key1"));
+    }
+    QFile::remove(fileName);
+}
+
+void tst_QSettings::readAll()
+{
+    QFETCH(QSettings::Format, format);
+    QFETCH(int, keyCount);
+    QString fileName = createSettings(format, keyCount);
+
+    QBENCHMARK {
+        fileName = rename(fileName);
+        QSettings settings(fileName, format);
+        const QStringList keys = settings.allKeys();
+        QCOMPARE(keys.size(), keyCount);
+        for (const QString &key : keys)
+            settings.value(key);
+    }
+    QFile::remove(fileName);
+}
+
+void tst_QSettings::syncOneKey()
+{
+    QFETCH(QSettings::Format, format);
+    QFETCH(int, keyCount);
+    QSettings settings(createSettings(format, keyCount), format);
+
+    int i = 0;
+    QBENCHMARK {
+        settings.setValue("group1/key1", ++i);
+        settings.sync();
+    }
+    QCOMPARE(settings.status(), QSettings::NoError);
+    QFile::remove(settings.fileName());
+}
+
+QTEST_MAIN(tst_QSettings)
+
+#include "tst_bench_qsettings.moc"
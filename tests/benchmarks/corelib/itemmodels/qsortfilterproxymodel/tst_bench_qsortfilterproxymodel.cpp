@@ -7,6 +7,9 @@
 #include <QStringListModel>
 #include <QTest>
 
+#include <algorithm>
+#include <vector>
+
 static void resizeNumberList(QStringList &numberList, int size)
 {
     if (!numberList.empty())
@@ -32,6 +35,14 @@ private slots:
     void clearFilter_data();
     void clearFilter();
     void setSourceModel();
+    void sort_data();
+    void sort();
+    void filter_data();
+    void filter();
+    void refineFilter_data();
+    void refineFilter();
+    void fetchData_data();
+    void fetchData();
 
 private:
     QStringList m_numberList; ///< Cache the strings for efficiency.
@@ -107,6 +118,166 @@ void tst_QSortFilterProxyModel::setSourceModel()
     }
 }
 
+void tst_QSortFilterProxyModel::sort_data()
+{
+    QTest::addColumn<int>("itemCount");
+    QTest::addColumn<bool>("parallel");
+
+    for (int thousandItemCount : { 10, 100, 1000, 2000 }) {
+        const auto itemCount = thousandItemCount * 1000;
+        QTest::addRow("%dK", thousandItemCount) << itemCount << false;
+        QTest::addRow("%dK parallel", thousandItemCount) << itemCount << true;
+    }
+}
+
+void tst_QSortFilterProxyModel::sort()
+{
+    QFETCH(const int, itemCount);
+    QFETCH(const bool, parallel);
+    resizeNumberList(m_numberList, itemCount);
+    QStringListModel model(std::as_const(m_numberList));
+
+    QSortFilterProxyModel proxy;
+    proxy.setParallelSortFilterEnabled(parallel);
+    proxy.setSourceModel(&model);
+    QCOMPARE(proxy.rowCount(), itemCount);
+
+    QBENCHMARK_ONCE {
+        proxy.sort(0, Qt::DescendingOrder);
+    }
+    QCOMPARE(proxy.index(0, 0).data().toString(),
+             *std::max_element(m_numberList.cbegin(), m_numberList.cend()));
+}
+
+void tst_QSortFilterProxyModel::filter_data()
+{
+    sort_data();
+}
+
+void tst_QSortFilterProxyModel::filter()
+{
+    QFETCH(const int, itemCount);
+    QFETCH(const bool, parallel);
+    resizeNumberList(m_numberList, itemCount);
+    QStringListModel model(std::as_const(m_numberList));
+
+    QSortFilterProxyModel proxy;
+    proxy.setParallelSortFilterEnabled(parallel);
+    proxy.setSourceModel(&model);
+    QCOMPARE(proxy.rowCount(), itemCount);
+
+    QBENCHMARK_ONCE {
+        proxy.setFilterRegularExpression(QStringLiteral("7.*3"));
+    }
+    QVERIFY(proxy.rowCount() < itemCount);
+}
+
+void tst_QSortFilterProxyModel::refineFilter_data()
+{
+    QTest::addColumn<int>("itemCount");
+    QTest::addColumn<bool>("incremental");
+    QTest::addColumn<int>("timeSlice");
+
+    for (int thousandItemCount : { 100, 1000, 2000 }) {
+        const auto itemCount = thousandItemCount * 1000;
+        QTest::addRow("%dK", thousandItemCount) << itemCount << false << 0;
+        QTest::addRow("%dK incremental", thousandItemCount) << itemCount << true << 0;
+        // only the part before returning to the event loop is measured
+        QTest::addRow("%dK time slice", thousandItemCount) << itemCount << false << 10;
+    }
+}
+
+void tst_QSortFilterProxyModel::refineFilter()
+{
+    QFETCH(const int, itemCount);
+    QFETCH(const bool, incremental);
+    QFETCH(const int, timeSlice);
+    resizeNumberList(m_numberList, itemCount);
+    QStringListModel model(std::as_const(m_numberList));
+
+    QSortFilterProxyModel proxy;
+    proxy.setIncrementalFilteringEnabled(incremental);
+    proxy.setSourceModel(&model);
+    proxy.setFilterFixedString(QStringLiteral("1"));
+    const int rowCount = proxy.rowCount();
+    proxy.setFilterTimeSlice(timeSlice);
+
+    // as when typing one more character
+    QBENCHMARK_ONCE {
+        proxy.setFilterFixedString(QStringLiteral("12"));
+    }
+    QTRY_VERIFY_WITH_TIMEOUT(proxy.rowCount() < rowCount / 2, 60000);
+}
+
+enum class FetchMode { Data, MultiData, BlockData };
+
+void tst_QSortFilterProxyModel::fetchData_data()
+{
+    QTest::addColumn<FetchMode>("mode");
+    QTest::addColumn<bool>("sorted");
+
+    QTest::newRow("data") << FetchMode::Data << false;
+    QTest::newRow("multiData") << FetchMode::MultiData << false;
+    QTest::newRow("blockData") << FetchMode::BlockData << false;
+    QTest::newRow("data sorted") << FetchMode::Data << true;
+    QTest::newRow("multiData sorted") << FetchMode::MultiData << true;
+    QTest::newRow("blockData sorted") << FetchMode::BlockData << true;
+}
+
+void tst_QSortFilterProxyModel::fetchData()
+{
+    QFETCH(const FetchMode, mode);
+    QFETCH(const bool, sorted);
+    constexpr int ItemCount = 100000;
+    constexpr int PageRowCount = 100;
+    resizeNumberList(m_numberList, ItemCount);
+    QStringListModel model(std::as_const(m_numberList));
+
+    QSortFilterProxyModel proxy;
+    proxy.setSourceModel(&model);
+    if (sorted)
+        proxy.sort(0);
+
+    // the roles of a delegate, reading all the rows a page at a time
+    const int roles[] = { Qt::DisplayRole, Qt::DecorationRole, Qt::EditRole, Qt::ToolTipRole,
+                          Qt::StatusTipRole, Qt::WhatsThisRole, Qt::FontRole,
+                          Qt::TextAlignmentRole, Qt::BackgroundRole, Qt::ForegroundRole,
+                          Qt::CheckStateRole };
+    std::vector<QModelRoleData> itemData;
+    for (int role : roles)
+        itemData.emplace_back(role);
+    std::vector<QModelRoleData> pageData;
+    for (int role : roles)
+        pageData.insert(pageData.end(), PageRowCount, QModelRoleData(role));
+    QVariant value;
+
+    QBENCHMARK {
+        for (int top = 0; top < ItemCount; top += PageRowCount) {
+            switch (mode) {
+            case FetchMode::Data:
+                for (int row = top; row < top + PageRowCount; ++row) {
+                    const QModelIndex index = proxy.index(row, 0);
+                    for (int role : roles)
+                        value = proxy.data(index, role);
+                }
+                break;
+            case FetchMode::MultiData:
+                for (int row = top; row < top + PageRowCount; ++row)
+                    proxy.multiData(proxy.index(row, 0), itemData);
+                break;
+            case FetchMode::BlockData:
+                proxy.blockData(proxy.index(top, 0), proxy.index(top + PageRowCount - 1, 0),
+                                pageData);
+                break;
+            }
+        }
+    }
+    if (mode == FetchMode::BlockData) {
+        QCOMPARE(pageData.front().data(), proxy.index(ItemCount - PageRowCount, 0).data());
+        QVERIFY(pageData.back().data().isNull());
+    }
+}
+
 QTEST_MAIN(tst_QSortFilterProxyModel)
 
 #include "tst_bench_qsortfilterproxymodel.moc"
@@ -94,6 +94,10 @@ private slots:
     void indexOfSignal();
     void indexOfSlot_data();
     void indexOfSlot();
+    void lookupAllByName_data();
+    void lookupAllByName();
+    void invokeMethodByName_data();
+    void invokeMethodByName();
 
     void unconnected_data();
     void unconnected();
@@ -186,6 +190,55 @@ void tst_QMetaObject::indexOfSlot()
     }
 }
 
+void tst_QMetaObject::lookupAllByName_data()
+{
+    QTest::addColumn<bool>("properties");
+    QTest::newRow("properties") << true;
+    QTest::newRow("methods") << false;
+}
+
+// Looks up every property or method of QTreeView, and of its base classes,
+// so that the result reflects the throughput over a whole class hierarchy
+void tst_QMetaObject::lookupAllByName()
+{
+    QFETCH(bool, properties);
+    const QMetaObject *mo = &QTreeView::staticMetaObject;
+    QList<QByteArray> names;
+    if (properties) {
+        for (int i = 0; i < mo->propertyCount(); ++i)
+            names.append(mo->property(i).name());
+    } else {
+        for (int i = 0; i < mo->methodCount(); ++i)
+            names.append(mo->method(i).methodSignature());
+    }
+    QBENCHMARK {
+        for (const QByteArray &name : std::as_const(names)) {
+            if (properties)
+                (void)mo->indexOfProperty(name.constData());
+            else
+                (void)mo->indexOfMethod(name.constData());
+        }
+    }
+}
+
+void tst_QMetaObject::invokeMethodByName_data()
+{
+    QTest::addColumn<QByteArray>("method");
+    QTest::newRow("collapseAll") << QByteArray("collapseAll");
+    QTest::newRow("clearSelection") << QByteArray("clearSelection");
+    QTest::newRow("scrollToTop") << QByteArray("scrollToTop");
+}
+
+void tst_QMetaObject::invokeMethodByName()
+{
+    QFETCH(QByteArray, method);
+    const char *p = method.constData();
+    QTreeView view;
+    QBENCHMARK {
+        QMetaObject::invokeMethod(&view, p);
+    }
+}
+
 void tst_QMetaObject::unconnected_data()
 {
     QTest::addColumn<int>("signal_index");
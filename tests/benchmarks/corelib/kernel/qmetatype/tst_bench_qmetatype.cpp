@@ -3,6 +3,11 @@
 
 #include <qtest.h>
 #include <QtCore/qmetatype.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qvariant.h>
+
+#include <memory>
+#include <vector>
 
 class tst_QMetaType : public QObject
 {
@@ -40,6 +45,11 @@ private slots:
     void constructInPlaceCopy();
     void constructInPlaceCopyStaticLess_data();
     void constructInPlaceCopyStaticLess();
+
+    void typeCustomThreaded_data();
+    void typeCustomThreaded();
+    void convertCustomThreaded_data();
+    void convertCustomThreaded();
 };
 
 tst_QMetaType::tst_QMetaType()
@@ -295,5 +305,68 @@ void tst_QMetaType::constructInPlaceCopyStaticLess()
     qFreeAligned(storage);
 }
 
+// Runs function in threadCount threads at the same time
+template <typename Function>
+static void runInThreads(int threadCount, Function function)
+{
+    std::vector<std::unique_ptr<QThread>> threads;
+    for (int i = 0; i < threadCount; ++i)
+        threads.emplace_back(QThread::create(function));
+    for (const auto &thread : threads)
+        thread->start();
+    for (const auto &thread : threads)
+        thread->wait();
+}
+
+static void threadCountData()
+{
+    QTest::addColumn<int>("threadCount");
+    for (int threadCount : {1, 2, 4, 8})
+        QTest::addRow("%d threads", threadCount) << threadCount;
+}
+
+void tst_QMetaType::typeCustomThreaded_data()
+{
+    threadCountData();
+}
+
+// The lookups of the custom types and of the types that aren't registered
+// read the registry, which must not get slower with more threads
+void tst_QMetaType::typeCustomThreaded()
+{
+    QFETCH(int, threadCount);
+    qRegisterMetaType<Foo>("Foo");
+    QBENCHMARK {
+        runInThreads(threadCount, [] {
+            for (int i = 0; i < 100000; ++i) {
+                QMetaType::fromName("Foo");
+                QMetaType::fromName("Bar");
+            }
+        });
+    }
+}
+
+struct ConvertibleFoo { int i; };
+
+void tst_QMetaType::convertCustomThreaded_data()
+{
+    threadCountData();
+}
+
+void tst_QMetaType::convertCustomThreaded()
+{
+    QFETCH(int, threadCount);
+    static const bool registered = QMetaType::registerConverter<ConvertibleFoo, int>(
+                [](const ConvertibleFoo &foo) { return foo.i; });
+    QVERIFY(registered);
+    const QVariant foo = QVariant::fromValue(ConvertibleFoo{42});
+    QBENCHMARK {
+        runInThreads(threadCount, [&foo] {
+            for (int i = 0; i < 100000; ++i)
+                foo.toInt();
+        });
+    }
+}
+
 QTEST_MAIN(tst_QMetaType)
 #include "tst_bench_qmetatype.moc"
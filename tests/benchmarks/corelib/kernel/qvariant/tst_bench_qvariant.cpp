@@ -7,8 +7,35 @@
 #endif
 #include <qtest.h>
 
+#include <cstdlib>
+#include <new>
+
 #define ITERATION_COUNT 1e5
 
+// Counts the calls to the global operator new, for the benchmarks that
+// report the number of allocations instead of the time. This only sees the
+// allocations of QtCore where the executable's operator new replaces the
+// one of the libraries, like on ELF platforms.
+Q_CONSTINIT static QBasicAtomicInteger<qint64> allocationCount = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+void *operator new(std::size_t size)
+{
+    allocationCount.fetchAndAddRelaxed(1);
+    void *p = std::malloc(size ? size : 1);
+    Q_CHECK_PTR(p);
+    return p;
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
 class tst_QVariant : public QObject
 {
     Q_OBJECT
@@ -60,6 +87,11 @@ private slots:
     void createCoreType();
     void createCoreTypeCopy_data();
     void createCoreTypeCopy();
+
+    void modelData_data();
+    void modelData();
+    void modelDataAllocations_data();
+    void modelDataAllocations();
 };
 
 struct BigClass
@@ -351,6 +383,67 @@ void tst_QVariant::createCoreTypeCopy()
     }
 }
 
+void tst_QVariant::modelData_data()
+{
+    QTest::addColumn<QVariant>("value");
+    QTest::addColumn<int>("keep");
+
+    const QVariant values[] = {
+        QVariant(QPointF(1, 2)),
+        QVariant(QRectF(1, 2, 3, 4)),
+        QVariant(QLineF(1, 2, 3, 4)),
+        QVariant::fromValue(std::pair<QPointF, QPointF>({ 1, 2 }, { 3, 4 })),
+        QVariant::fromValue(BigClass()),
+    };
+    // how many of the values are alive at the same time, like when a view
+    // asks for the data of one item, or keeps them for a row of items
+    for (int keep : { 1, 16, 256 }) {
+        for (const QVariant &value : values) {
+            QTest::addRow("%s:%d", value.typeName(), keep) << value << keep;
+        }
+    }
+}
+
+// Creates and destroys copies of a value in a QVariant like a view does with
+// the results of QAbstractItemModel::data()
+static void createModelData(const QVariant &value, int keep, int count)
+{
+    const QMetaType metaType = value.metaType();
+    QList<QVariant> alive;
+    alive.reserve(keep);
+    for (int i = 0; i < count; ++i) {
+        alive.append(QVariant(metaType, value.constData()));
+        if (alive.size() == keep)
+            alive.clear();
+    }
+}
+
+void tst_QVariant::modelData()
+{
+    QFETCH(QVariant, value);
+    QFETCH(int, keep);
+    QBENCHMARK {
+        createModelData(value, keep, ITERATION_COUNT);
+    }
+}
+
+void tst_QVariant::modelDataAllocations_data()
+{
+    modelData_data();
+}
+
+// Reports the number of allocations per value
+void tst_QVariant::modelDataAllocations()
+{
+    QFETCH(QVariant, value);
+    QFETCH(int, keep);
+    createModelData(value, keep, keep); // warm up
+    const qint64 before = allocationCount.loadRelaxed();
+    createModelData(value, keep, ITERATION_COUNT);
+    const qint64 allocations = allocationCount.loadRelaxed() - before;
+    QTest::setBenchmarkResult(qreal(allocations) / ITERATION_COUNT, QTest::Events);
+}
+
 QTEST_MAIN(tst_QVariant)
 
 #include "tst_bench_qvariant.moc"
@@ -0,0 +1,18 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QtCore/QMimeDatabase>
+
+#include <string.h>
+
+// What a short-lived tool does: a single lookup
+int main(int argc, char **argv)
+{
+    if (argc > 1 && strcmp(argv[1], "--no-lookup") == 0)
+        return 0;
+
+    QMimeDatabase db;
+    const QMimeType mimeType = db.mimeTypeForFile(QStringLiteral("archive.tar.gz"),
+                                                  QMimeDatabase::MatchExtension);
+    return mimeType.name() == QLatin1StringView("application/x-compressed-tar") ? 0 : 1;
+}
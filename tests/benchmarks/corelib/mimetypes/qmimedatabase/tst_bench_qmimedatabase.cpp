@@ -4,6 +4,12 @@
 
 #include <QTest>
 #include <QMimeDatabase>
+#include <QDir>
+#include <QFile>
+#if QT_CONFIG(process)
+#include <QProcess>
+#include <QTemporaryDir>
+#endif
 
 namespace {
 struct MatchModeInfo
@@ -45,6 +51,14 @@ private slots:
     void benchMimeTypeForName();
     void benchMimeTypeForFile_data();
     void benchMimeTypeForFile();
+    void benchMimeTypeForData_data();
+    void benchMimeTypeForData();
+    void benchMimeTypesForFiles_data();
+    void benchMimeTypesForFiles();
+#if QT_CONFIG(process)
+    void startup_data();
+    void startup();
+#endif
 };
 
 void tst_QMimeDatabase::inheritsPerformance()
@@ -134,6 +148,128 @@ void tst_QMimeDatabase::benchMimeTypeForFile()
     }
 }
 
+void tst_QMimeDatabase::benchMimeTypeForData_data()
+{
+    QTest::addColumn<QByteArray>("data");
+    QTest::addColumn<QString>("expectedMimeName");
+
+    QTest::newRow("png") << QByteArray("\x89PNG\r\n\x1a\n\0\0\0\rIHDR", 16) << "image/png";
+    QTest::newRow("pdf") << QByteArray("%PDF-1.7\n%\xe2\xe3\xcf\xd3\n") << "application/pdf";
+
+    QFile gzip(QFINDTESTDATA("files/N.tar.gz"));
+    QVERIFY(gzip.open(QIODevice::ReadOnly));
+    QTest::newRow("gzip") << gzip.readAll() << "application/gzip";
+
+    QFile c(QFINDTESTDATA("files/X"));
+    QVERIFY(c.open(QIODevice::ReadOnly));
+    QTest::newRow("C source") << c.readAll() << "text/x-csrc";
+
+    // Nothing matches, so all the rules are tried on the whole header
+    QByteArray text;
+    while (text.size() < 16384)
+        text += "The quick brown fox jumps over the lazy dog.\n";
+    QTest::newRow("plain text") << text << "text/plain";
+    QByteArray binary(16384, Qt::Uninitialized);
+    for (qsizetype i = 0; i < binary.size(); ++i)
+        binary[i] = char(i * 7919 % 251 + 1);
+    QTest::newRow("binary") << binary << "application/octet-stream";
+}
+
+void tst_QMimeDatabase::benchMimeTypeForData()
+{
+    QFETCH(const QByteArray, data);
+    QFETCH(const QString, expectedMimeName);
+
+    QMimeDatabase db;
+
+    QBENCHMARK {
+        const auto mimeType = db.mimeTypeForData(data);
+        QCOMPARE(mimeType.name(), expectedMimeName);
+    }
+}
+
+void tst_QMimeDatabase::benchMimeTypesForFiles_data()
+{
+    QTest::addColumn<QMimeDatabase::MatchMode>("mode");
+    QTest::addColumn<bool>("batch");
+
+    for (const MatchModeInfo &info : matchModes) {
+        QTest::addRow("%s - loop", info.name) << info.mode << false;
+        QTest::addRow("%s - batch", info.name) << info.mode << true;
+    }
+}
+
+void tst_QMimeDatabase::benchMimeTypesForFiles()
+{
+    QFETCH(const QMimeDatabase::MatchMode, mode);
+    QFETCH(const bool, batch);
+
+    const QString directory = QFINDTESTDATA("files");
+    QVERIFY(!directory.isEmpty());
+    const QStringList names = QDir(directory).entryList(QDir::Files);
+    QStringList fileNames;
+    for (int i = 0; i < 100; ++i) {
+        for (const QString &name : names)
+            fileNames.append(directory + u'/' + name);
+    }
+
+    QMimeDatabase db;
+
+    QBENCHMARK {
+        QList<QMimeType> mimeTypes;
+        if (batch) {
+            mimeTypes = db.mimeTypesForFiles(fileNames, mode);
+        } else {
+            for (const QString &fileName : std::as_const(fileNames))
+                mimeTypes.append(db.mimeTypeForFile(fileName, mode));
+        }
+        QCOMPARE(mimeTypes.size(), fileNames.size());
+    }
+}
+
+#if QT_CONFIG(process)
+void tst_QMimeDatabase::startup_data()
+{
+    QTest::addColumn<QStringList>("arguments");
+    QTest::addColumn<bool>("parseXml");
+
+    // the time to start a process at all, to subtract from the others
+    QTest::newRow("no lookup") << QStringList{ "--no-lookup" } << false;
+    QTest::newRow("cache") << QStringList() << false;
+    QTest::newRow("xml") << QStringList() << true;
+}
+
+void tst_QMimeDatabase::startup()
+{
+    QFETCH(const QStringList, arguments);
+    QFETCH(const bool, parseXml);
+
+    const QString program = QFINDTESTDATA("startup/mimeStartup");
+    QVERIFY(!program.isEmpty());
+
+    // Without a MIME database in the data directories, the internal one is used
+    QTemporaryDir emptyDataDir;
+    QVERIFY(emptyDataDir.isValid());
+    QProcessEnvironment environment = QProcessEnvironment::systemEnvironment();
+    environment.insert("XDG_DATA_DIRS", emptyDataDir.path());
+    environment.insert("XDG_DATA_HOME", emptyDataDir.path());
+    if (parseXml)
+        environment.insert("QT_NO_MIME_CACHE", "1");
+    else
+        environment.remove("QT_NO_MIME_CACHE");
+
+    QProcess process;
+    process.setProgram(program);
+    process.setArguments(arguments);
+    process.setProcessEnvironment(environment);
+    QBENCHMARK {
+        process.start();
+        QVERIFY(process.waitForFinished());
+        QCOMPARE(process.exitCode(), 0);
+    }
+}
+#endif
+
 QTEST_MAIN(tst_QMimeDatabase)
 
 #include "tst_bench_qmimedatabase.moc"
@@ -0,0 +1,21 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/private/qfactoryloader_p.h>
+
+#include <string.h>
+
+// What an application does when it starts: find the plugins of one type
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+        return 2;
+    if (strcmp(argv[1], "--no-lookup") == 0)
+        return 0;
+
+    QCoreApplication app(argc, argv);
+    QFactoryLoader loader("org.qt-project.Qt.benchmarks.qfactoryloader", "/nonexistent");
+    loader.setExtraSearchPath(QString::fromLocal8Bit(argv[1]));
+    return loader.keyMap().isEmpty() ? 1 : 0;
+}
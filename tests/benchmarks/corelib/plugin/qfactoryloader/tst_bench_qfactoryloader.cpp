@@ -0,0 +1,83 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QDir>
+#include <QFile>
+#include <QProcess>
+#include <QTemporaryDir>
+#include <QTest>
+
+class tst_QFactoryLoader : public QObject
+{
+    Q_OBJECT
+
+    QTemporaryDir pluginDir;
+    QTemporaryDir cacheDir;
+
+private slots:
+    void initTestCase();
+    void startup_data();
+    void startup();
+};
+
+void tst_QFactoryLoader::initTestCase()
+{
+    // An installation with many plugins, of which few are of the type that
+    // is looked for
+    const QString binFolder = QFINDTESTDATA("bin");
+    QVERIFY(!binFolder.isEmpty());
+    const QFileInfoList plugins = QDir(binFolder).entryInfoList(QDir::Files);
+    QCOMPARE(plugins.size(), 1);
+    QVERIFY(pluginDir.isValid());
+    for (int i = 0; i < 200; ++i) {
+        const QString copy = pluginDir.filePath(QString::number(i) + u'_' + plugins.first().fileName());
+        QVERIFY(QFile::copy(plugins.first().absoluteFilePath(), copy));
+    }
+    QVERIFY(cacheDir.isValid());
+}
+
+void tst_QFactoryLoader::startup_data()
+{
+    QTest::addColumn<QStringList>("arguments");
+    QTest::addColumn<QString>("cacheFile");
+
+    // the time to start a process at all, to subtract from the others
+    QTest::newRow("no lookup") << QStringList{ "--no-lookup" } << QString();
+    QTest::newRow("no cache") << QStringList{ pluginDir.path() } << QString();
+    QTest::newRow("cache") << QStringList{ pluginDir.path() }
+                           << cacheDir.filePath("plugins.cache");
+}
+
+void tst_QFactoryLoader::startup()
+{
+    QFETCH(const QStringList, arguments);
+    QFETCH(const QString, cacheFile);
+
+    const QString program = QFINDTESTDATA("startup/factoryLoaderStartup");
+    QVERIFY(!program.isEmpty());
+
+    QProcessEnvironment environment = QProcessEnvironment::systemEnvironment();
+    environment.insert("QT_PLUGIN_METADATA_CACHE", cacheFile);
+
+    QProcess process;
+    process.setProgram(program);
+    process.setArguments(arguments);
+    process.setProcessEnvironment(environment);
+
+    // fill the cache
+    process.start();
+    QVERIFY(process.waitForFinished());
+    QCOMPARE(process.exitCode(), 0);
+    if (!cacheFile.isEmpty())
+        QVERIFY(QFile::exists(cacheFile));
+
+    QBENCHMARK {
+        process.start();
+        QVERIFY(process.waitForFinished());
+        QCOMPARE(process.exitCode(), 0);
+    }
+}
+
+QTEST_MAIN(tst_QFactoryLoader)
+
+#include "tst_bench_qfactoryloader.moc"